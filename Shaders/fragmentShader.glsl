@@ -0,0 +1,267 @@
+///////////////////////////////////////////////////////////////////////////////
+// fragmentShader.glsl
+// ============
+// light and texture the scene fragments, with the materials, lights and
+// textures read from the buffers and arrays the scene manager fills, or
+// from the plain uniforms when it does not use them
+//
+///////////////////////////////////////////////////////////////////////////////
+#version 430 core
+
+// the length of the MaterialBlock array, MAX_BLOCK_MATERIALS
+#define MAX_BLOCK_MATERIALS 256
+// the length of the lightSources[] array, MAX_SHADER_LIGHTS
+#define MAX_SHADER_LIGHTS 4
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in uint fragmentDrawID;
+
+out vec4 outFragmentColor;
+
+struct Material
+{
+	vec3 ambientColor;
+	float ambientStrength;
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float shininess;
+};
+
+// the std140 layout of the MATERIAL_BLOCK_ENTRY
+struct MaterialEntry
+{
+	vec3 ambientColor;
+	float ambientStrength;
+	vec3 diffuseColor;
+	float padding;
+	vec3 specularColor;
+	float shininess;
+};
+
+// the field names match the lightSources[] names the
+// application resolves
+struct LightSource
+{
+	vec3 position;
+	vec3 ambientColor;
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float focalStrength;
+	float specularIntensity;
+	float ambientStrength;
+};
+
+// the std430 layout of the LIGHT_BUFFER_ENTRY
+struct LightEntry
+{
+	vec3 position;
+	float focalStrength;
+	vec3 ambientColor;
+	float specularIntensity;
+	vec3 diffuseColor;
+	float ambientStrength;
+	vec3 specularColor;
+	float range;
+};
+
+struct DrawData
+{
+	mat4 model;
+	mat4 normalMatrix;
+	vec4 color;
+	vec2 uvScale;
+	int materialIndex;
+	int textureLayer;
+};
+
+// first light index and light count of a cluster
+struct ClusterRange
+{
+	uint offset;
+	uint count;
+};
+
+layout(std140, binding = 0) uniform MaterialBlock { MaterialEntry materials[MAX_BLOCK_MATERIALS]; };
+layout(std430, binding = 1) readonly buffer LightBuffer { LightEntry lights[]; };
+layout(std430, binding = 2) readonly buffer ClusterBuffer { ClusterRange clusters[]; };
+layout(std430, binding = 3) readonly buffer ClusterLightIndices { uint clusterLightIndices[]; };
+layout(std430, binding = 4) readonly buffer DrawDataBuffer { DrawData drawData[]; };
+
+uniform vec3 viewPosition;
+uniform mat4 view;
+uniform bool bUseLighting;
+uniform bool bUseTexture;
+uniform vec4 objectColor;
+uniform vec2 UVscale;
+uniform sampler2D objectTexture;
+
+// materials selected by index from the MaterialBlock, or the
+// material uniforms
+uniform bool bUseMaterialBlock;
+uniform int materialIndex;
+uniform Material material;
+
+// lights read from the LightBuffer, or the lightSources[]
+// uniforms, lightCount is used by both
+uniform bool bUseLightBuffer;
+uniform int lightCount;
+uniform LightSource lightSources[MAX_SHADER_LIGHTS];
+
+// only the lights of the cluster holding the fragment are
+// read while this is set, clusterParams holds the depth
+// slice scale and bias and the cluster size in pixels
+uniform bool bUseClusteredLights;
+uniform vec3 clusterGridSize;
+uniform vec4 clusterParams;
+
+// the draw values come from the drawData[] entry of a
+// multi-draw instead of the uniforms
+uniform bool bUseDrawData;
+
+// textures are read by layer from the texture array of the
+// draw instead of from a texture unit of their own
+uniform bool bUseTextureArrays;
+uniform sampler2DArray objectTextureArray;
+uniform int textureLayer;
+
+vec3 CalcLightSource(LightSource light, float range, Material objectMaterial, vec3 lightNormal, vec3 viewDirection);
+LightSource GetBufferLight(uint lightIndex, out float range);
+
+void main()
+{
+	vec4 drawColor = objectColor;
+	vec2 uvScale = UVscale;
+	bool bDrawTextured = bUseTexture;
+	int drawMaterial = materialIndex;
+	int drawLayer = textureLayer;
+	Material objectMaterial = material;
+	vec4 textureColor = vec4(1.0);
+
+	if (bUseDrawData)
+	{
+		DrawData data = drawData[fragmentDrawID];
+
+		drawColor = data.color;
+		uvScale = data.uvScale;
+		drawMaterial = data.materialIndex;
+		drawLayer = data.textureLayer;
+		bDrawTextured = (data.textureLayer >= 0);
+	}
+	if (bUseMaterialBlock)
+	{
+		MaterialEntry entry = materials[clamp(drawMaterial, 0, MAX_BLOCK_MATERIALS - 1)];
+
+		objectMaterial.ambientColor = entry.ambientColor;
+		objectMaterial.ambientStrength = entry.ambientStrength;
+		objectMaterial.diffuseColor = entry.diffuseColor;
+		objectMaterial.specularColor = entry.specularColor;
+		objectMaterial.shininess = entry.shininess;
+	}
+	if (bDrawTextured)
+	{
+		vec2 uv = fragmentTextureCoordinate * uvScale;
+
+		if (bUseTextureArrays)
+		{
+			textureColor = texture(objectTextureArray, vec3(uv, float(drawLayer)));
+		}
+		else
+		{
+			textureColor = texture(objectTexture, uv);
+		}
+	}
+	vec4 baseColor = bDrawTextured ? vec4(textureColor.rgb, 1.0) : drawColor;
+
+	if (!bUseLighting)
+	{
+		outFragmentColor = baseColor;
+		return;
+	}
+
+	vec3 lightNormal = normalize(fragmentVertexNormal);
+	vec3 viewDirection = normalize(viewPosition - fragmentPosition);
+	vec3 phongResult = vec3(0.0);
+	float range = 0.0;
+
+	if (!bUseLightBuffer)
+	{
+		for (int i = 0; i < min(lightCount, MAX_SHADER_LIGHTS); i++)
+		{
+			phongResult += CalcLightSource(lightSources[i], 0.0, objectMaterial, lightNormal, viewDirection);
+		}
+	}
+	else if (bUseClusteredLights)
+	{
+		// the same slice calculation as FindDepthSlice(), the
+		// rows count up from the bottom like gl_FragCoord
+		float viewDepth = max(-(view * vec4(fragmentPosition, 1.0)).z, 1.0e-4);
+		ivec3 grid = ivec3(clusterGridSize);
+		ivec3 cell = ivec3(
+			int(gl_FragCoord.x / clusterParams.z),
+			int(gl_FragCoord.y / clusterParams.w),
+			int(floor((log(viewDepth) * clusterParams.x) - clusterParams.y)));
+		cell = clamp(cell, ivec3(0), grid - 1);
+
+		ClusterRange cluster = clusters[cell.x + grid.x * (cell.y + grid.y * cell.z)];
+		for (uint i = 0u; i < cluster.count; i++)
+		{
+			LightSource light = GetBufferLight(clusterLightIndices[cluster.offset + i], range);
+			phongResult += CalcLightSource(light, range, objectMaterial, lightNormal, viewDirection);
+		}
+	}
+	else
+	{
+		for (int i = 0; i < lightCount; i++)
+		{
+			LightSource light = GetBufferLight(uint(i), range);
+			phongResult += CalcLightSource(light, range, objectMaterial, lightNormal, viewDirection);
+		}
+	}
+
+	outFragmentColor = vec4(phongResult * baseColor.rgb, baseColor.a);
+}
+
+// copy a LightBuffer entry into the light source fields
+LightSource GetBufferLight(uint lightIndex, out float range)
+{
+	LightEntry entry = lights[lightIndex];
+	LightSource light;
+
+	light.position = entry.position;
+	light.ambientColor = entry.ambientColor;
+	light.diffuseColor = entry.diffuseColor;
+	light.specularColor = entry.specularColor;
+	light.focalStrength = entry.focalStrength;
+	light.specularIntensity = entry.specularIntensity;
+	light.ambientStrength = entry.ambientStrength;
+	range = entry.range;
+
+	return light;
+}
+
+// the Phong terms of one light, a light with a range has no
+// effect past it, so the full loop and the clusters agree
+vec3 CalcLightSource(LightSource light, float range, Material objectMaterial, vec3 lightNormal, vec3 viewDirection)
+{
+	vec3 toLight = light.position - fragmentPosition;
+
+	if ((range > 0.0) && (dot(toLight, toLight) > (range * range)))
+	{
+		return vec3(0.0);
+	}
+
+	vec3 lightDirection = normalize(toLight);
+	vec3 ambient = light.ambientStrength * light.ambientColor * objectMaterial.ambientStrength * objectMaterial.ambientColor;
+
+	float impact = max(dot(lightNormal, lightDirection), 0.0);
+	vec3 diffuse = impact * light.diffuseColor * objectMaterial.diffuseColor;
+
+	// the focal strength narrows the highlight of the material
+	vec3 reflectDirection = reflect(-lightDirection, lightNormal);
+	float specularComponent = pow(max(dot(viewDirection, reflectDirection), 0.0), max(objectMaterial.shininess * light.focalStrength, 1.0));
+	vec3 specular = light.specularIntensity * specularComponent * light.specularColor * objectMaterial.specularColor;
+
+	return ambient + diffuse + specular;
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// vertexShader.glsl
+// ============
+// transform the scene vertices, from the model uniform for a single draw,
+// the instance attributes of an instanced draw or from the DrawDataBuffer
+// entry of a multi-draw
+//
+///////////////////////////////////////////////////////////////////////////////
+#version 430 core
+
+layout(location = 0) in vec3 inVertexPosition;
+layout(location = 1) in vec3 inVertexNormal;
+layout(location = 2) in vec2 inTextureCoordinate;
+// index of the drawData[] entry, one value per instance, so
+// the base instance of each indirect command selects it
+layout(location = 3) in uint drawID;
+// matrices of one copy of an instanced draw, one value per
+// instance
+layout(location = 4) in mat4 instanceModel;
+layout(location = 8) in mat3 instanceNormalMatrix;
+
+// per draw values of a multi-draw, the same layout as the
+// DRAW_DATA_ENTRY of the scene manager
+struct DrawData
+{
+	mat4 model;
+	mat4 normalMatrix;
+	vec4 color;
+	vec2 uvScale;
+	int materialIndex;
+	int textureLayer;
+};
+
+layout(std430, binding = 4) readonly buffer DrawDataBuffer { DrawData drawData[]; };
+
+uniform mat4 model;
+// inverse transpose of the model matrix, built on the CPU
+uniform mat3 normalMatrix;
+uniform mat4 view;
+uniform mat4 projection;
+uniform bool bUseDrawData;
+// the matrices come from the instance attributes instead of
+// the uniforms
+uniform bool bUseInstanceData;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+// the drawData[] entry the fragment shader reads the rest of
+// the draw values from
+flat out uint fragmentDrawID;
+
+void main()
+{
+	mat4 objectModel = model;
+	mat3 objectNormalMatrix = normalMatrix;
+
+	if (bUseDrawData)
+	{
+		objectModel = drawData[drawID].model;
+		objectNormalMatrix = mat3(drawData[drawID].normalMatrix);
+	}
+	else if (bUseInstanceData)
+	{
+		objectModel = instanceModel;
+		objectNormalMatrix = instanceNormalMatrix;
+	}
+
+	fragmentPosition = vec3(objectModel * vec4(inVertexPosition, 1.0));
+	fragmentVertexNormal = objectNormalMatrix * inVertexNormal;
+	fragmentTextureCoordinate = inTextureCoordinate;
+	fragmentDrawID = drawID;
+
+	gl_Position = projection * view * vec4(fragmentPosition, 1.0);
+}
@@ -0,0 +1,341 @@
+///////////////////////////////////////////////////////////////////////////////
+// asynctextureloader.cpp
+// ============
+// decode texture image files on background threads and hand the pixels
+// to the render thread for upload
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AsyncTextureLoader.h"
+
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/***********************************************************
+ *  AsyncTextureLoader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+AsyncTextureLoader::AsyncTextureLoader(int threadCount)
+{
+	m_pendingCount = 0;
+	m_cachedImageCount = 0;
+	// the uncompressed formats are always supported
+	m_supportedFormats = (1u << TEXTURE_FORMAT_RGB8) | (1u << TEXTURE_FORMAT_RGBA8);
+	m_bShutdown = false;
+
+	// the render thread keeps drawing while the files are
+	// decoded, so one core is left for it
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+	threadCount = std::max(threadCount, 1);
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_threads.push_back(std::thread(&AsyncTextureLoader::DecodeLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~AsyncTextureLoader()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bShutdown = true;
+		m_requests.clear();
+	}
+	m_wakeCondition.notify_all();
+
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		m_threads[i].join();
+	}
+
+	for (size_t i = 0; i < m_decodedImages.size(); i++)
+	{
+		FreeDecodedImage(m_decodedImages[i]);
+	}
+}
+
+/***********************************************************
+ *  SetSupportedFormats()
+ *
+ *  This method is used for setting the texel formats the
+ *  renderer can upload. The uncompressed formats are kept
+ *  whatever the mask, since a decoded image is always in
+ *  one of them.
+ ***********************************************************/
+void AsyncTextureLoader::SetSupportedFormats(uint32_t formatMask)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_supportedFormats = formatMask | (1u << TEXTURE_FORMAT_RGB8) | (1u << TEXTURE_FORMAT_RGBA8);
+}
+
+/***********************************************************
+ *  RequestImage()
+ *
+ *  This method is used for queueing an image file to be
+ *  decoded by the next free thread. The request ID comes
+ *  back with the decoded image. stb_image reads its flip
+ *  setting from a global, so it has to be set before the
+ *  first request.
+ ***********************************************************/
+void AsyncTextureLoader::RequestImage(int requestID, const std::string& filename)
+{
+	DECODE_REQUEST request;
+
+	request.requestID = requestID;
+	request.filename = filename;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		request.formatMask = m_supportedFormats;
+		m_requests.push_back(request);
+		m_pendingCount++;
+	}
+	m_wakeCondition.notify_one();
+}
+
+/***********************************************************
+ *  TakeDecodedImages()
+ *
+ *  This method is used for collecting the images decoded
+ *  since the last call, in the order they finished. The
+ *  caller owns the pixels of the images it takes.
+ ***********************************************************/
+int AsyncTextureLoader::TakeDecodedImages(std::vector<DECODED_IMAGE>& images, int maxCount)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int takeCount = std::min((int)m_decodedImages.size(), maxCount);
+
+	if (takeCount <= 0)
+	{
+		return(0);
+	}
+
+	images.insert(images.end(), m_decodedImages.begin(), m_decodedImages.begin() + takeCount);
+	m_decodedImages.erase(m_decodedImages.begin(), m_decodedImages.begin() + takeCount);
+	m_pendingCount -= takeCount;
+
+	return(takeCount);
+}
+
+/***********************************************************
+ *  FreeDecodedImage()
+ *
+ *  This method is used for freeing the texels of a decoded
+ *  image, or closing its cache file, once they have been
+ *  sent to OpenGL.
+ ***********************************************************/
+void AsyncTextureLoader::FreeDecodedImage(DECODED_IMAGE& image)
+{
+	delete[] image.pDecodedTexels;
+	image.pDecodedTexels = NULL;
+	delete image.pCacheFile;
+	image.pCacheFile = NULL;
+	image.texels = NULL;
+}
+
+/***********************************************************
+ *  GetPendingCount()
+ *
+ *  This method is used for getting the number of images
+ *  that are queued, being decoded, or decoded and waiting
+ *  to be taken.
+ ***********************************************************/
+int AsyncTextureLoader::GetPendingCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return(m_pendingCount);
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of decoding
+ *  threads.
+ ***********************************************************/
+int AsyncTextureLoader::GetThreadCount() const
+{
+	return((int)m_threads.size());
+}
+
+/***********************************************************
+ *  GetCachedImageCount()
+ *
+ *  This method is used for getting the number of images
+ *  that were mapped from their texture cache files instead
+ *  of decoded, to tell a cold start from a warm one.
+ ***********************************************************/
+int AsyncTextureLoader::GetCachedImageCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return(m_cachedImageCount);
+}
+
+/***********************************************************
+ *  DecodeLoop()
+ *
+ *  This method is used for running a decoding thread. The
+ *  lock is only held while taking a request and handing
+ *  back the image, never while the file is decoded.
+ ***********************************************************/
+void AsyncTextureLoader::DecodeLoop()
+{
+	for (;;)
+	{
+		DECODE_REQUEST request;
+		DECODED_IMAGE image;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this]() { return((m_bShutdown == true) || (m_requests.empty() == false)); });
+			if (m_bShutdown == true)
+			{
+				return;
+			}
+			request = m_requests.front();
+			m_requests.pop_front();
+		}
+
+		LoadImage(request, image);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_bShutdown == true)
+			{
+				FreeDecodedImage(image);
+				return;
+			}
+			if (NULL != image.pCacheFile)
+			{
+				m_cachedImageCount++;
+			}
+			m_decodedImages.push_back(image);
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadImage()
+ *
+ *  This method is used for loading an image with its mip
+ *  chain. The image file is always read, as its hash tells
+ *  whether the cache file is stale. On a miss the image is
+ *  decoded from the bytes already read, the levels are
+ *  filtered and the cache file is written for the next
+ *  launch. The flip setting of stb_image is not part of the
+ *  hash, so the cache files have to be deleted if it is
+ *  changed. A cache file in a format the renderer cannot
+ *  upload is not written over, as it was made by the
+ *  texture encoder and suits other machines.
+ ***********************************************************/
+void AsyncTextureLoader::LoadImage(const DECODE_REQUEST& request, DECODED_IMAGE& image)
+{
+	std::ifstream file(request.filename.c_str(), std::ios::in | std::ios::binary);
+	std::vector<unsigned char> fileBytes;
+	const std::string cacheName = GetTextureCacheName(request.filename);
+	uint64_t sourceHash = 0;
+	uint64_t texelBytes = 0;
+	unsigned char* pPixels = NULL;
+	bool bKeepCacheFile = false;
+
+	image.requestID = request.requestID;
+	image.filename = request.filename;
+	image.width = 0;
+	image.height = 0;
+	image.channels = 0;
+	image.format = TEXTURE_FORMAT_RGB8;
+	image.levelCount = 0;
+	image.texels = NULL;
+	image.pDecodedTexels = NULL;
+	image.pCacheFile = NULL;
+
+	if (file.is_open() == false)
+	{
+		return;
+	}
+	fileBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	file.close();
+	if (fileBytes.empty() == true)
+	{
+		return;
+	}
+	sourceHash = HashTextureSource(&fileBytes[0], fileBytes.size());
+
+	image.pCacheFile = new TextureCacheFile();
+	if (image.pCacheFile->Open(cacheName, sourceHash) == true)
+	{
+		const TEXTURE_CACHE_HEADER& header = image.pCacheFile->GetHeader();
+
+		if ((request.formatMask & (1u << header.format)) != 0)
+		{
+			image.width = (int)header.width;
+			image.height = (int)header.height;
+			image.format = (TEXTURE_FORMAT)header.format;
+			image.channels = GetTextureFormatChannels(image.format);
+			image.levelCount = (int)header.levelCount;
+			for (int level = 0; level < image.levelCount; level++)
+			{
+				image.levels[level] = image.pCacheFile->GetLevel(level);
+			}
+			image.texels = image.pCacheFile->GetTexels();
+			return;
+		}
+
+		std::cout << "INFO: " << GetTextureFormatName((TEXTURE_FORMAT)header.format)
+			<< " textures are not supported by the driver, decoding " << request.filename << std::endl;
+		bKeepCacheFile = true;
+	}
+	delete image.pCacheFile;
+	image.pCacheFile = NULL;
+
+	pPixels = stbi_load_from_memory(
+		&fileBytes[0],
+		(int)fileBytes.size(),
+		&image.width,
+		&image.height,
+		&image.channels,
+		0);
+	if (NULL == pPixels)
+	{
+		return;
+	}
+	// the renderer only uploads RGB and RGBA images
+	if ((image.channels != 3) && (image.channels != 4))
+	{
+		stbi_image_free(pPixels);
+		return;
+	}
+
+	image.format = GetUncompressedTextureFormat(image.channels);
+	image.levelCount = GetTextureLevels(image.width, image.height, image.format, image.levels, texelBytes);
+	image.pDecodedTexels = new unsigned char[(size_t)texelBytes];
+	memcpy(image.pDecodedTexels, pPixels, (size_t)image.levels[0].size);
+	stbi_image_free(pPixels);
+	BuildTextureMipChain(image.pDecodedTexels, image.channels, image.levelCount, image.levels);
+	image.texels = image.pDecodedTexels;
+
+	if (bKeepCacheFile == false)
+	{
+		if (WriteTextureCache(cacheName, sourceHash, image.width, image.height, image.format,
+			image.levelCount, image.levels, image.texels) == false)
+		{
+			std::cout << "Could not write texture cache:" << cacheName << std::endl;
+		}
+	}
+}
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// asynctextureloader.h
+// ============
+// decode texture image files on background threads and hand the pixels
+// to the render thread for upload
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureCache.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// pixels of one decoded image file
+struct DECODED_IMAGE
+{
+	// value passed with the request, the texture slot
+	int requestID;
+	std::string filename;
+	int width;
+	int height;
+	int channels;
+	// format of the texels, block compressed when the cache
+	// file was written by the texture encoder
+	TEXTURE_FORMAT format;
+	// mip levels down to one texel, in the texels
+	int levelCount;
+	TEXTURE_LEVEL levels[MAX_TEXTURE_LEVELS];
+	// texels of every level, NULL when the file could not be
+	// decoded, kept until FreeDecodedImage()
+	const unsigned char* texels;
+	// texels decoded on this launch
+	unsigned char* pDecodedTexels;
+	// cache file the texels are mapped from
+	TextureCacheFile* pCacheFile;
+};
+
+/***********************************************************
+ *  AsyncTextureLoader
+ *
+ *  This class decodes image files on its own threads, so
+ *  the render thread never waits on the disk or the JPEG
+ *  decoder. RequestImage() only queues the file, and the
+ *  render thread collects the finished texels with
+ *  TakeDecodedImages() between frames and has them sent to
+ *  OpenGL.
+ *
+ *  Each image is delivered with its full mip chain. The
+ *  first launch decodes the file, filters the levels and
+ *  writes them to a texture cache file next to the image.
+ *  Later launches only hash the image file and map the
+ *  cache file, skipping the decode and the filtering. A
+ *  cache file written by the texture encoder holds block
+ *  compressed levels, which are only used when their format
+ *  is one the renderer said it supports. Otherwise the
+ *  image file is decoded instead, and the encoded cache
+ *  file is left as it is.
+ *
+ *  The threads are separate from the worker pool, whose
+ *  jobs have to finish inside a frame, while a decode can
+ *  take several frames.
+ ***********************************************************/
+class AsyncTextureLoader
+{
+public:
+	// constructor, zero threads uses one per spare core
+	AsyncTextureLoader(int threadCount = 0);
+	// destructor, images still queued are dropped
+	~AsyncTextureLoader();
+
+	// set the formats the renderer can upload, one bit for
+	// each TEXTURE_FORMAT, for the images requested after it
+	void SetSupportedFormats(uint32_t formatMask);
+	// queue an image file to be decoded
+	void RequestImage(int requestID, const std::string& filename);
+	// move up to maxCount decoded images into images, returns
+	// the number moved
+	int TakeDecodedImages(std::vector<DECODED_IMAGE>& images, int maxCount);
+	// free the texels of a taken image
+	static void FreeDecodedImage(DECODED_IMAGE& image);
+
+	// number of images requested but not taken yet
+	int GetPendingCount() const;
+	// number of decoding threads
+	int GetThreadCount() const;
+	// number of images read from the texture cache
+	int GetCachedImageCount() const;
+
+private:
+	// one queued image file
+	struct DECODE_REQUEST
+	{
+		int requestID;
+		std::string filename;
+		// formats the cache file may hold
+		uint32_t formatMask;
+	};
+
+	// decode the queued files until the loader is destroyed
+	void DecodeLoop();
+	// load an image from its cache file, or decode it and
+	// write the cache file
+	void LoadImage(const DECODE_REQUEST& request, DECODED_IMAGE& image);
+
+	std::vector<std::thread> m_threads;
+	mutable std::mutex m_mutex;
+	// signals the threads that a file was queued
+	std::condition_variable m_wakeCondition;
+	std::deque<DECODE_REQUEST> m_requests;
+	std::vector<DECODED_IMAGE> m_decodedImages;
+	int m_pendingCount;
+	int m_cachedImageCount;
+	uint32_t m_supportedFormats;
+	bool m_bShutdown;
+};
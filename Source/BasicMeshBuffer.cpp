@@ -0,0 +1,673 @@
+///////////////////////////////////////////////////////////////////////////////
+// basicmeshbuffer.cpp
+// ============
+// basic shape meshes stored together in one vertex and index buffer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BasicMeshBuffer.h"
+
+#include <cmath>
+#include <cstddef>
+
+// declaration of global variables
+namespace
+{
+	const float PI = 3.14159265358979f;
+
+	/***********************************************************
+	 *  AddVertex()
+	 *
+	 *  This function is used for adding a vertex to a mesh and
+	 *  returning its index.
+	 ***********************************************************/
+	GLuint AddVertex(
+		MESH_GEOMETRY& geometry,
+		const glm::vec3& position,
+		const glm::vec3& normal,
+		const glm::vec2& texCoord)
+	{
+		MESH_VERTEX vertex;
+
+		vertex.position = position;
+		vertex.normal = normal;
+		vertex.texCoord = texCoord;
+		geometry.vertices.push_back(vertex);
+
+		return((GLuint)geometry.vertices.size() - 1);
+	}
+
+	/***********************************************************
+	 *  AddTriangle()
+	 *
+	 *  This function is used for adding three vertex indices,
+	 *  in counter clockwise order seen from the front.
+	 ***********************************************************/
+	void AddTriangle(MESH_GEOMETRY& geometry, GLuint first, GLuint second, GLuint third)
+	{
+		geometry.indices.push_back(first);
+		geometry.indices.push_back(second);
+		geometry.indices.push_back(third);
+	}
+
+	/***********************************************************
+	 *  AddFlatQuad()
+	 *
+	 *  This function is used for adding a flat square face
+	 *  around a center point. The face points along the cross
+	 *  product of its two half size axes.
+	 ***********************************************************/
+	void AddFlatQuad(
+		MESH_GEOMETRY& geometry,
+		const glm::vec3& center,
+		const glm::vec3& uAxis,
+		const glm::vec3& vAxis)
+	{
+		glm::vec3 normal = glm::normalize(glm::cross(uAxis, vAxis));
+		GLuint first = AddVertex(geometry, center - uAxis - vAxis, normal, glm::vec2(0.0f, 0.0f));
+
+		AddVertex(geometry, center + uAxis - vAxis, normal, glm::vec2(1.0f, 0.0f));
+		AddVertex(geometry, center + uAxis + vAxis, normal, glm::vec2(1.0f, 1.0f));
+		AddVertex(geometry, center - uAxis + vAxis, normal, glm::vec2(0.0f, 1.0f));
+		AddTriangle(geometry, first, first + 1, first + 2);
+		AddTriangle(geometry, first, first + 2, first + 3);
+	}
+
+	/***********************************************************
+	 *  AddFlatTriangle()
+	 *
+	 *  This function is used for adding a flat triangle face
+	 *  with its own vertices and face normal.
+	 ***********************************************************/
+	void AddFlatTriangle(
+		MESH_GEOMETRY& geometry,
+		const glm::vec3& first,
+		const glm::vec3& second,
+		const glm::vec3& third)
+	{
+		glm::vec3 normal = glm::normalize(glm::cross(second - first, third - first));
+		GLuint index = AddVertex(geometry, first, normal, glm::vec2(0.0f, 0.0f));
+
+		AddVertex(geometry, second, normal, glm::vec2(1.0f, 0.0f));
+		AddVertex(geometry, third, normal, glm::vec2(0.5f, 1.0f));
+		AddTriangle(geometry, index, index + 1, index + 2);
+	}
+}
+
+/***********************************************************
+ *  GeneratePlaneMesh()
+ *
+ *  This function is used for building a flat plane facing
+ *  up, from -1 to 1 along the X and Z axes.
+ ***********************************************************/
+void GeneratePlaneMesh(MESH_GEOMETRY& geometry)
+{
+	AddFlatQuad(geometry, glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+}
+
+/***********************************************************
+ *  GenerateBoxMesh()
+ *
+ *  This function is used for building a unit box centered on
+ *  the origin, with its own vertices for each face.
+ ***********************************************************/
+void GenerateBoxMesh(MESH_GEOMETRY& geometry)
+{
+	const float h = 0.5f;
+
+	AddFlatQuad(geometry, glm::vec3(h, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -h), glm::vec3(0.0f, h, 0.0f));
+	AddFlatQuad(geometry, glm::vec3(-h, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, h), glm::vec3(0.0f, h, 0.0f));
+	AddFlatQuad(geometry, glm::vec3(0.0f, h, 0.0f), glm::vec3(h, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -h));
+	AddFlatQuad(geometry, glm::vec3(0.0f, -h, 0.0f), glm::vec3(h, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, h));
+	AddFlatQuad(geometry, glm::vec3(0.0f, 0.0f, h), glm::vec3(h, 0.0f, 0.0f), glm::vec3(0.0f, h, 0.0f));
+	AddFlatQuad(geometry, glm::vec3(0.0f, 0.0f, -h), glm::vec3(-h, 0.0f, 0.0f), glm::vec3(0.0f, h, 0.0f));
+}
+
+/***********************************************************
+ *  GenerateConeMesh()
+ *
+ *  This function is used for building a cone with a base of
+ *  radius 1 on the XZ plane and the tip 1 unit above it.
+ ***********************************************************/
+void GenerateConeMesh(MESH_GEOMETRY& geometry, int slices)
+{
+	GLuint firstSide = (GLuint)geometry.vertices.size();
+	GLuint center = 0;
+	GLuint firstBase = 0;
+
+	// the side, with a tip vertex for every slice so the
+	// normals stay smooth around the cone
+	for (int i = 0; i <= slices; i++)
+	{
+		float angle = (2.0f * PI * i) / slices;
+		float middleAngle = (2.0f * PI * (i + 0.5f)) / slices;
+		float u = (float)i / slices;
+
+		AddVertex(
+			geometry,
+			glm::vec3(std::cos(angle), 0.0f, std::sin(angle)),
+			glm::normalize(glm::vec3(std::cos(angle), 1.0f, std::sin(angle))),
+			glm::vec2(u, 0.0f));
+		AddVertex(
+			geometry,
+			glm::vec3(0.0f, 1.0f, 0.0f),
+			glm::normalize(glm::vec3(std::cos(middleAngle), 1.0f, std::sin(middleAngle))),
+			glm::vec2(u, 1.0f));
+	}
+	for (int i = 0; i < slices; i++)
+	{
+		GLuint base = firstSide + (i * 2);
+
+		AddTriangle(geometry, base, base + 1, base + 2);
+	}
+
+	// the flat bottom
+	center = AddVertex(geometry, glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.5f, 0.5f));
+	firstBase = (GLuint)geometry.vertices.size();
+	for (int i = 0; i <= slices; i++)
+	{
+		float angle = (2.0f * PI * i) / slices;
+
+		AddVertex(
+			geometry,
+			glm::vec3(std::cos(angle), 0.0f, std::sin(angle)),
+			glm::vec3(0.0f, -1.0f, 0.0f),
+			glm::vec2(0.5f + (0.5f * std::cos(angle)), 0.5f + (0.5f * std::sin(angle))));
+	}
+	for (int i = 0; i < slices; i++)
+	{
+		AddTriangle(geometry, center, firstBase + i, firstBase + i + 1);
+	}
+}
+
+/***********************************************************
+ *  GenerateSphereMesh()
+ *
+ *  This function is used for building a sphere of radius 1
+ *  around the origin from rings of latitude.
+ ***********************************************************/
+void GenerateSphereMesh(MESH_GEOMETRY& geometry, int slices, int stacks)
+{
+	GLuint first = (GLuint)geometry.vertices.size();
+	GLuint rowLength = (GLuint)slices + 1;
+
+	for (int stack = 0; stack <= stacks; stack++)
+	{
+		float polar = (PI * stack) / stacks;
+
+		for (int slice = 0; slice <= slices; slice++)
+		{
+			float azimuth = (2.0f * PI * slice) / slices;
+			glm::vec3 normal(
+				std::sin(polar) * std::cos(azimuth),
+				std::cos(polar),
+				std::sin(polar) * std::sin(azimuth));
+
+			AddVertex(
+				geometry,
+				normal,
+				normal,
+				glm::vec2((float)slice / slices, 1.0f - ((float)stack / stacks)));
+		}
+	}
+
+	for (int stack = 0; stack < stacks; stack++)
+	{
+		for (int slice = 0; slice < slices; slice++)
+		{
+			GLuint upper = first + (stack * rowLength) + slice;
+			GLuint lower = upper + rowLength;
+
+			AddTriangle(geometry, upper, upper + 1, lower);
+			AddTriangle(geometry, upper + 1, lower + 1, lower);
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateTorusMesh()
+ *
+ *  This function is used for building a torus lying on the
+ *  XY plane, with a ring radius of 1 and a tube radius of
+ *  0.2.
+ ***********************************************************/
+void GenerateTorusMesh(MESH_GEOMETRY& geometry, int ringSlices, int tubeSlices)
+{
+	const float ringRadius = 1.0f;
+	const float tubeRadius = 0.2f;
+	GLuint first = (GLuint)geometry.vertices.size();
+	GLuint rowLength = (GLuint)tubeSlices + 1;
+
+	for (int ring = 0; ring <= ringSlices; ring++)
+	{
+		float ringAngle = (2.0f * PI * ring) / ringSlices;
+		glm::vec3 ringCenter(ringRadius * std::cos(ringAngle), ringRadius * std::sin(ringAngle), 0.0f);
+
+		for (int tube = 0; tube <= tubeSlices; tube++)
+		{
+			float tubeAngle = (2.0f * PI * tube) / tubeSlices;
+			glm::vec3 normal(
+				std::cos(tubeAngle) * std::cos(ringAngle),
+				std::cos(tubeAngle) * std::sin(ringAngle),
+				std::sin(tubeAngle));
+
+			AddVertex(
+				geometry,
+				ringCenter + (normal * tubeRadius),
+				normal,
+				glm::vec2((float)ring / ringSlices, (float)tube / tubeSlices));
+		}
+	}
+
+	for (int ring = 0; ring < ringSlices; ring++)
+	{
+		for (int tube = 0; tube < tubeSlices; tube++)
+		{
+			GLuint current = first + (ring * rowLength) + tube;
+			GLuint next = current + rowLength;
+
+			AddTriangle(geometry, current, next, current + 1);
+			AddTriangle(geometry, next, next + 1, current + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  GeneratePyramid4Mesh()
+ *
+ *  This function is used for building a four sided pyramid
+ *  with a unit square base and the tip 1 unit above it,
+ *  centered on the origin.
+ ***********************************************************/
+void GeneratePyramid4Mesh(MESH_GEOMETRY& geometry)
+{
+	const glm::vec3 tip(0.0f, 0.5f, 0.0f);
+	const glm::vec3 corners[4] =
+	{
+		glm::vec3(-0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, -0.5f),
+		glm::vec3(-0.5f, -0.5f, -0.5f)
+	};
+
+	for (int i = 0; i < 4; i++)
+	{
+		AddFlatTriangle(geometry, corners[i], corners[(i + 1) % 4], tip);
+	}
+	AddFlatQuad(geometry, glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.5f));
+}
+
+/***********************************************************
+ *  BasicMeshBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BasicMeshBuffer::BasicMeshBuffer()
+{
+	m_vertexArray = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_drawIDBuffer = 0;
+	m_drawIDCapacity = 0;
+	m_drawIDSource = 0;
+	m_instanceBuffer = 0;
+}
+
+/***********************************************************
+ *  ~BasicMeshBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BasicMeshBuffer::~BasicMeshBuffer()
+{
+	if (m_instanceBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_instanceBuffer);
+		m_instanceBuffer = 0;
+	}
+	if (m_drawIDBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_drawIDBuffer);
+		m_drawIDBuffer = 0;
+	}
+	if (m_indexBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = 0;
+	}
+	if (m_vertexBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_vertexBuffer);
+		m_vertexBuffer = 0;
+	}
+	if (m_vertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArray);
+		m_vertexArray = 0;
+	}
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for adding a mesh to the end of the
+ *  shared buffers. The indices of the mesh stay relative to
+ *  its own first vertex, the base vertex is added when it
+ *  is drawn. The meshes are sent by CreateBuffers().
+ ***********************************************************/
+int BasicMeshBuffer::AddMesh(const MESH_GEOMETRY& geometry)
+{
+	MESH_RANGE range;
+
+	range.firstIndex = (GLuint)m_geometry.indices.size();
+	range.indexCount = (GLuint)geometry.indices.size();
+	range.baseVertex = (GLint)m_geometry.vertices.size();
+	m_meshRanges.push_back(range);
+
+	m_geometry.vertices.insert(m_geometry.vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+	m_geometry.indices.insert(m_geometry.indices.end(), geometry.indices.begin(), geometry.indices.end());
+
+	return((int)m_meshRanges.size() - 1);
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the vertex array and
+ *  sending the added meshes into the shared vertex and
+ *  index buffers. The vertex layout matches the ShapeMeshes
+ *  meshes so the same shaders draw either of them.
+ ***********************************************************/
+void BasicMeshBuffer::CreateBuffers()
+{
+	if (m_vertexArray == 0)
+	{
+		glGenVertexArrays(1, &m_vertexArray);
+		glGenBuffers(1, &m_vertexBuffer);
+		glGenBuffers(1, &m_indexBuffer);
+	}
+
+	glBindVertexArray(m_vertexArray);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		m_geometry.vertices.size() * sizeof(MESH_VERTEX),
+		m_geometry.vertices.data(),
+		GL_STATIC_DRAW);
+	glVertexAttribPointer(
+		MESH_POSITION_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, position));
+	glEnableVertexAttribArray(MESH_POSITION_ATTRIBUTE);
+	glVertexAttribPointer(
+		MESH_NORMAL_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, normal));
+	glEnableVertexAttribArray(MESH_NORMAL_ATTRIBUTE);
+	glVertexAttribPointer(
+		MESH_TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, texCoord));
+	glEnableVertexAttribArray(MESH_TEXCOORD_ATTRIBUTE);
+
+	// the index buffer binding is stored in the vertex array
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+	glBufferData(
+		GL_ELEMENT_ARRAY_BUFFER,
+		m_geometry.indices.size() * sizeof(GLuint),
+		m_geometry.indices.data(),
+		GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// the meshes are kept on the GPU only
+	m_geometry.vertices.clear();
+	m_geometry.vertices.shrink_to_fit();
+	m_geometry.indices.clear();
+	m_geometry.indices.shrink_to_fit();
+}
+
+/***********************************************************
+ *  ReserveDrawIDs()
+ *
+ *  This method is used for growing the per draw index
+ *  buffer to hold at least the passed in number of draws.
+ *  The buffer holds the numbers 0, 1, 2 ... and is read
+ *  once per instance, so the base instance of each indirect
+ *  command selects the entry of that draw.
+ ***********************************************************/
+void BasicMeshBuffer::ReserveDrawIDs(int drawCount)
+{
+	std::vector<GLuint> drawIDs;
+
+	if ((m_vertexArray == 0) || (drawCount <= m_drawIDCapacity))
+	{
+		return;
+	}
+
+	if (m_drawIDCapacity == 0)
+	{
+		m_drawIDCapacity = 256;
+		glGenBuffers(1, &m_drawIDBuffer);
+	}
+	while (m_drawIDCapacity < drawCount)
+	{
+		m_drawIDCapacity *= 2;
+	}
+
+	drawIDs.resize(m_drawIDCapacity);
+	for (int i = 0; i < m_drawIDCapacity; i++)
+	{
+		drawIDs[i] = (GLuint)i;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_drawIDBuffer);
+	glBufferData(GL_ARRAY_BUFFER, drawIDs.size() * sizeof(GLuint), drawIDs.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// point the attribute at the resized buffer
+	m_drawIDSource = 0;
+	SetDrawIDSource(m_drawIDBuffer);
+}
+
+/***********************************************************
+ *  SetDrawIDSource()
+ *
+ *  This method is used for choosing the buffer the per draw
+ *  index attribute is read from. A culling pass can write
+ *  the indexes of the visible objects into its own buffer,
+ *  and each command then draws a range of it as instances.
+ ***********************************************************/
+void BasicMeshBuffer::SetDrawIDSource(GLuint drawIDBuffer)
+{
+	if (drawIDBuffer == 0)
+	{
+		drawIDBuffer = m_drawIDBuffer;
+	}
+	if ((m_vertexArray == 0) || (drawIDBuffer == 0) || (drawIDBuffer == m_drawIDSource))
+	{
+		return;
+	}
+
+	glBindVertexArray(m_vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, drawIDBuffer);
+	glVertexAttribIPointer(MESH_DRAW_ID_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(GLuint), NULL);
+	glVertexAttribDivisor(MESH_DRAW_ID_ATTRIBUTE, 1);
+	glEnableVertexAttribArray(MESH_DRAW_ID_ATTRIBUTE);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_drawIDSource = drawIDBuffer;
+}
+
+/***********************************************************
+ *  SetInstances()
+ *
+ *  This method is used for sending the model and normal
+ *  matrices of the instanced draws. Each draw uses a range
+ *  of them, and the instance attributes advance once per
+ *  instance. The attributes are only turned on during
+ *  DrawMeshInstanced(), so other draws never read them.
+ ***********************************************************/
+void BasicMeshBuffer::SetInstances(const std::vector<MESH_INSTANCE>& instances)
+{
+	if ((m_vertexArray == 0) || (instances.empty() == true))
+	{
+		return;
+	}
+
+	if (m_instanceBuffer == 0)
+	{
+		glGenBuffers(1, &m_instanceBuffer);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+	glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(MESH_INSTANCE), instances.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glBindVertexArray(m_vertexArray);
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glVertexAttribDivisor(MESH_INSTANCE_MODEL_ATTRIBUTE + column, 1);
+	}
+	for (GLuint column = 0; column < 3; column++)
+	{
+		glVertexAttribDivisor(MESH_INSTANCE_NORMAL_ATTRIBUTE + column, 1);
+	}
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  Bind()
+ *
+ *  This method is used for binding the shared vertex array
+ *  before the meshes are drawn.
+ ***********************************************************/
+void BasicMeshBuffer::Bind() const
+{
+	glBindVertexArray(m_vertexArray);
+}
+
+/***********************************************************
+ *  Unbind()
+ *
+ *  This method is used for unbinding the shared vertex
+ *  array after the meshes are drawn.
+ ***********************************************************/
+void BasicMeshBuffer::Unbind() const
+{
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  GetMeshCount()
+ *
+ *  This method is used for getting the number of meshes.
+ ***********************************************************/
+int BasicMeshBuffer::GetMeshCount() const
+{
+	return((int)m_meshRanges.size());
+}
+
+/***********************************************************
+ *  GetMeshRange()
+ *
+ *  This method is used for getting where a mesh is stored
+ *  in the shared buffers.
+ ***********************************************************/
+const MESH_RANGE& BasicMeshBuffer::GetMeshRange(int mesh) const
+{
+	return(m_meshRanges[mesh]);
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used for drawing one mesh from the shared
+ *  buffers. The vertex array must already be bound, so
+ *  draws of different meshes do not rebind anything.
+ ***********************************************************/
+void BasicMeshBuffer::DrawMesh(int mesh) const
+{
+	const MESH_RANGE& range = m_meshRanges[mesh];
+
+	glDrawElementsBaseVertex(
+		GL_TRIANGLES,
+		(GLsizei)range.indexCount,
+		GL_UNSIGNED_INT,
+		(const void*)(range.firstIndex * sizeof(GLuint)),
+		range.baseVertex);
+}
+
+/***********************************************************
+ *  DrawMeshInstanced()
+ *
+ *  This method is used for drawing copies of one mesh from
+ *  the shared buffers in a single draw call, each with the
+ *  matrices of one instance. OpenGL 3.3 has no base
+ *  instance for these draws, so the instance attributes
+ *  are pointed at the first instance of the range instead.
+ *  The vertex array must already be bound.
+ ***********************************************************/
+void BasicMeshBuffer::DrawMeshInstanced(int mesh, int firstInstance, int instanceCount) const
+{
+	const MESH_RANGE& range = m_meshRanges[mesh];
+	const size_t firstOffset = firstInstance * sizeof(MESH_INSTANCE);
+
+	if ((m_instanceBuffer == 0) || (instanceCount <= 0))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glVertexAttribPointer(
+			MESH_INSTANCE_MODEL_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof(MESH_INSTANCE),
+			(const void*)(firstOffset + offsetof(MESH_INSTANCE, model) + column * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(MESH_INSTANCE_MODEL_ATTRIBUTE + column);
+	}
+	for (GLuint column = 0; column < 3; column++)
+	{
+		glVertexAttribPointer(
+			MESH_INSTANCE_NORMAL_ATTRIBUTE + column, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_INSTANCE),
+			(const void*)(firstOffset + offsetof(MESH_INSTANCE, normalMatrix) + column * sizeof(glm::vec3)));
+		glEnableVertexAttribArray(MESH_INSTANCE_NORMAL_ATTRIBUTE + column);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glDrawElementsInstancedBaseVertex(
+		GL_TRIANGLES,
+		(GLsizei)range.indexCount,
+		GL_UNSIGNED_INT,
+		(const void*)(range.firstIndex * sizeof(GLuint)),
+		(GLsizei)instanceCount,
+		range.baseVertex);
+
+	// the multi-draws read past the instances with their
+	// base instances, so the attributes are only on here
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glDisableVertexAttribArray(MESH_INSTANCE_MODEL_ATTRIBUTE + column);
+	}
+	for (GLuint column = 0; column < 3; column++)
+	{
+		glDisableVertexAttribArray(MESH_INSTANCE_NORMAL_ATTRIBUTE + column);
+	}
+}
+
+/***********************************************************
+ *  BuildDrawCommand()
+ *
+ *  This method is used for filling an indirect draw command
+ *  that draws one copy of a mesh. The draw index is passed
+ *  as the base instance, where the shader finds it in the
+ *  draw ID attribute or in gl_BaseInstance.
+ ***********************************************************/
+void BasicMeshBuffer::BuildDrawCommand(int mesh, GLuint drawIndex, DRAW_ELEMENTS_COMMAND& command) const
+{
+	const MESH_RANGE& range = m_meshRanges[mesh];
+
+	command.count = range.indexCount;
+	command.instanceCount = 1;
+	command.firstIndex = range.firstIndex;
+	command.baseVertex = range.baseVertex;
+	command.baseInstance = drawIndex;
+}
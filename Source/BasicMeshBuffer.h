@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// basicmeshbuffer.h
+// ============
+// basic shape meshes stored together in one vertex and index buffer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// vertex attribute locations, the same as the ShapeMeshes layout
+const GLuint MESH_POSITION_ATTRIBUTE = 0;
+const GLuint MESH_NORMAL_ATTRIBUTE = 1;
+const GLuint MESH_TEXCOORD_ATTRIBUTE = 2;
+// per draw index, advanced once per instance so a multi-draw
+// reads the draw index from the base instance of each command
+const GLuint MESH_DRAW_ID_ATTRIBUTE = 3;
+// per instance model and normal matrices of an instanced draw,
+// one location per matrix column
+const GLuint MESH_INSTANCE_MODEL_ATTRIBUTE = 4;
+const GLuint MESH_INSTANCE_NORMAL_ATTRIBUTE = 8;
+
+// one vertex of a basic shape mesh
+struct MESH_VERTEX
+{
+	glm::vec3 position;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+// vertices and triangle indices of a mesh before it is added
+struct MESH_GEOMETRY
+{
+	std::vector<MESH_VERTEX> vertices;
+	std::vector<GLuint> indices;
+};
+
+// matrices of one copy of a mesh in an instanced draw
+struct MESH_INSTANCE
+{
+	glm::mat4 model;
+	glm::mat3 normalMatrix;
+};
+
+// where a mesh is stored in the shared buffers
+struct MESH_RANGE
+{
+	GLuint firstIndex;
+	GLuint indexCount;
+	GLint baseVertex;
+};
+
+// same layout as the indirect draw commands read by
+// glMultiDrawElementsIndirect()
+struct DRAW_ELEMENTS_COMMAND
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+};
+
+// build the basic shapes, sized the same as the ShapeMeshes ones
+void GeneratePlaneMesh(MESH_GEOMETRY& geometry);
+void GenerateBoxMesh(MESH_GEOMETRY& geometry);
+void GenerateConeMesh(MESH_GEOMETRY& geometry, int slices = 36);
+void GenerateSphereMesh(MESH_GEOMETRY& geometry, int slices = 36, int stacks = 18);
+void GenerateTorusMesh(MESH_GEOMETRY& geometry, int ringSlices = 36, int tubeSlices = 12);
+void GeneratePyramid4Mesh(MESH_GEOMETRY& geometry);
+
+/***********************************************************
+ *  BasicMeshBuffer
+ *
+ *  This class keeps the vertices and indices of several
+ *  meshes in one vertex buffer and one index buffer behind
+ *  a single vertex array. Each mesh is found by its base
+ *  vertex and first index, so draws of different meshes do
+ *  not need to switch buffers, and can be sent together in
+ *  one multi-draw.
+ ***********************************************************/
+class BasicMeshBuffer
+{
+public:
+	// constructor
+	BasicMeshBuffer();
+	// destructor
+	~BasicMeshBuffer();
+
+	// add a mesh, returns the mesh index
+	int AddMesh(const MESH_GEOMETRY& geometry);
+	// send the added meshes to the GPU
+	void CreateBuffers();
+	// make room for a number of per draw indices
+	void ReserveDrawIDs(int drawCount);
+	// read the per draw indices from another buffer, or from
+	// the buffer of 0, 1, 2 ... when passed 0
+	void SetDrawIDSource(GLuint drawIDBuffer);
+	// send the matrices of every instanced draw
+	void SetInstances(const std::vector<MESH_INSTANCE>& instances);
+
+	// bind and unbind the shared vertex array
+	void Bind() const;
+	void Unbind() const;
+
+	// number of added meshes
+	int GetMeshCount() const;
+	// get where a mesh is stored
+	const MESH_RANGE& GetMeshRange(int mesh) const;
+	// draw one mesh with the shared vertex array bound
+	void DrawMesh(int mesh) const;
+	// draw copies of one mesh with a range of the instances,
+	// with the shared vertex array bound
+	void DrawMeshInstanced(int mesh, int firstInstance, int instanceCount) const;
+	// fill an indirect draw command for a mesh
+	void BuildDrawCommand(int mesh, GLuint drawIndex, DRAW_ELEMENTS_COMMAND& command) const;
+
+private:
+	// meshes waiting for CreateBuffers()
+	MESH_GEOMETRY m_geometry;
+	std::vector<MESH_RANGE> m_meshRanges;
+
+	GLuint m_vertexArray;
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// buffer holding 0, 1, 2 ... for the per draw index
+	GLuint m_drawIDBuffer;
+	int m_drawIDCapacity;
+	// buffer the draw ID attribute currently reads from
+	GLuint m_drawIDSource;
+	// per instance matrices of the instanced draws
+	GLuint m_instanceBuffer;
+};
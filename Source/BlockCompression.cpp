@@ -0,0 +1,921 @@
+///////////////////////////////////////////////////////////////////////////////
+// blockcompression.cpp
+// ============
+// encode texels to the BC1, BC3 and BC7 block compressed formats the GPU
+// samples directly, and decode them to measure the error
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// SSE2 is part of every x64 processor and the default code
+// generation of 32 bit Visual Studio builds
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BLOCK_COMPRESSION_SSE2
+#include <emmintrin.h>
+#endif
+
+// declaration of global variables
+namespace
+{
+	// texels in a 4x4 block
+	const int BLOCK_TEXELS = 16;
+	// largest palette of a block, the 4 bit BC7 indexes
+	const int MAX_PALETTE = 16;
+	// interpolation weights of the 4 bit BC7 indexes, out of 64
+	const int g_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	// steps of the power iteration for the principal axis
+	const int AXIS_ITERATIONS = 8;
+
+	// the texels of a block by channel, so four texels of a
+	// channel can be loaded at once
+	struct BLOCK_CHANNELS
+	{
+		float values[4][BLOCK_TEXELS];
+	};
+
+	// split the RGBA texels of a block into channels
+	void LoadBlockChannels(const unsigned char texels[64], BLOCK_CHANNELS& channels)
+	{
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				channels.values[c][i] = (float)texels[i * 4 + c];
+			}
+		}
+	}
+
+#ifndef BLOCK_COMPRESSION_SSE2
+	// find the palette entry nearest to each texel, with the
+	// squared difference of every channel scaled by its weight
+	float FindNearestIndicesScalar(
+		const BLOCK_CHANNELS& channels,
+		const float palette[][4],
+		int paletteCount,
+		const float weights[4],
+		int indices[BLOCK_TEXELS])
+	{
+		float totalError = 0.0f;
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			float bestError = 3.0e38f;
+
+			for (int p = 0; p < paletteCount; p++)
+			{
+				float error = 0.0f;
+
+				for (int c = 0; c < 4; c++)
+				{
+					const float difference = channels.values[c][i] - palette[p][c];
+					error += weights[c] * difference * difference;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = p;
+				}
+			}
+			totalError += bestError;
+		}
+
+		return(totalError);
+	}
+#else
+	// find the nearest palette entries four texels at a time,
+	// with the same result as the scalar search
+	float FindNearestIndicesSSE2(
+		const BLOCK_CHANNELS& channels,
+		const float palette[][4],
+		int paletteCount,
+		const float weights[4],
+		int indices[BLOCK_TEXELS])
+	{
+		__m128 totalError = _mm_setzero_ps();
+		float errors[4];
+
+		for (int i = 0; i < BLOCK_TEXELS; i += 4)
+		{
+			const __m128 texelR = _mm_loadu_ps(&channels.values[0][i]);
+			const __m128 texelG = _mm_loadu_ps(&channels.values[1][i]);
+			const __m128 texelB = _mm_loadu_ps(&channels.values[2][i]);
+			const __m128 texelA = _mm_loadu_ps(&channels.values[3][i]);
+			__m128 bestError = _mm_set1_ps(3.0e38f);
+			__m128i bestIndex = _mm_setzero_si128();
+
+			for (int p = 0; p < paletteCount; p++)
+			{
+				const __m128 differenceR = _mm_sub_ps(texelR, _mm_set1_ps(palette[p][0]));
+				const __m128 differenceG = _mm_sub_ps(texelG, _mm_set1_ps(palette[p][1]));
+				const __m128 differenceB = _mm_sub_ps(texelB, _mm_set1_ps(palette[p][2]));
+				const __m128 differenceA = _mm_sub_ps(texelA, _mm_set1_ps(palette[p][3]));
+				__m128 error = _mm_mul_ps(_mm_mul_ps(differenceR, differenceR), _mm_set1_ps(weights[0]));
+				__m128i closer;
+
+				error = _mm_add_ps(error, _mm_mul_ps(_mm_mul_ps(differenceG, differenceG), _mm_set1_ps(weights[1])));
+				error = _mm_add_ps(error, _mm_mul_ps(_mm_mul_ps(differenceB, differenceB), _mm_set1_ps(weights[2])));
+				error = _mm_add_ps(error, _mm_mul_ps(_mm_mul_ps(differenceA, differenceA), _mm_set1_ps(weights[3])));
+
+				closer = _mm_castps_si128(_mm_cmplt_ps(error, bestError));
+				bestError = _mm_min_ps(error, bestError);
+				bestIndex = _mm_or_si128(
+					_mm_and_si128(closer, _mm_set1_epi32(p)),
+					_mm_andnot_si128(closer, bestIndex));
+			}
+
+			_mm_storeu_si128((__m128i*)&indices[i], bestIndex);
+			totalError = _mm_add_ps(totalError, bestError);
+		}
+
+		_mm_storeu_ps(errors, totalError);
+		return(errors[0] + errors[1] + errors[2] + errors[3]);
+	}
+#endif
+
+	// find the palette entry nearest to each texel and return
+	// the total weighted error
+	float FindNearestIndices(
+		const BLOCK_CHANNELS& channels,
+		const float palette[][4],
+		int paletteCount,
+		const float weights[4],
+		int indices[BLOCK_TEXELS])
+	{
+#ifdef BLOCK_COMPRESSION_SSE2
+		return(FindNearestIndicesSSE2(channels, palette, paletteCount, weights, indices));
+#else
+		return(FindNearestIndicesScalar(channels, palette, paletteCount, weights, indices));
+#endif
+	}
+
+	// find the two ends of the line through the texels that
+	// follows their largest spread, using the channels up to
+	// channelCount
+	void FitEndpoints(const BLOCK_CHANNELS& channels, int channelCount, float endpoints[2][4])
+	{
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float covariance[4][4];
+		float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float minProjection = 3.0e38f;
+		float maxProjection = -3.0e38f;
+		float axisLength = 0.0f;
+
+		for (int c = 0; c < channelCount; c++)
+		{
+			float minValue = 255.0f;
+			float maxValue = 0.0f;
+
+			for (int i = 0; i < BLOCK_TEXELS; i++)
+			{
+				mean[c] += channels.values[c][i];
+				minValue = std::min(minValue, channels.values[c][i]);
+				maxValue = std::max(maxValue, channels.values[c][i]);
+			}
+			mean[c] /= BLOCK_TEXELS;
+			// the bounding box diagonal starts the iteration
+			axis[c] = maxValue - minValue;
+		}
+
+		for (int row = 0; row < channelCount; row++)
+		{
+			for (int column = 0; column < channelCount; column++)
+			{
+				covariance[row][column] = 0.0f;
+				for (int i = 0; i < BLOCK_TEXELS; i++)
+				{
+					covariance[row][column] += (channels.values[row][i] - mean[row]) * (channels.values[column][i] - mean[column]);
+				}
+			}
+		}
+
+		for (int iteration = 0; iteration < AXIS_ITERATIONS; iteration++)
+		{
+			float nextAxis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float largest = 0.0f;
+
+			for (int row = 0; row < channelCount; row++)
+			{
+				for (int column = 0; column < channelCount; column++)
+				{
+					nextAxis[row] += covariance[row][column] * axis[column];
+				}
+				largest = std::max(largest, std::fabs(nextAxis[row]));
+			}
+			if (largest <= 0.0f)
+			{
+				break;
+			}
+			for (int c = 0; c < channelCount; c++)
+			{
+				axis[c] = nextAxis[c] / largest;
+			}
+		}
+
+		for (int c = 0; c < channelCount; c++)
+		{
+			axisLength += axis[c] * axis[c];
+		}
+		if (axisLength <= 0.0f)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				endpoints[0][c] = (c < channelCount) ? mean[c] : 255.0f;
+				endpoints[1][c] = endpoints[0][c];
+			}
+			return;
+		}
+		axisLength = std::sqrt(axisLength);
+		for (int c = 0; c < channelCount; c++)
+		{
+			axis[c] /= axisLength;
+		}
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			float projection = 0.0f;
+
+			for (int c = 0; c < channelCount; c++)
+			{
+				projection += (channels.values[c][i] - mean[c]) * axis[c];
+			}
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		for (int c = 0; c < 4; c++)
+		{
+			if (c < channelCount)
+			{
+				endpoints[0][c] = std::min(std::max(mean[c] + axis[c] * minProjection, 0.0f), 255.0f);
+				endpoints[1][c] = std::min(std::max(mean[c] + axis[c] * maxProjection, 0.0f), 255.0f);
+			}
+			else
+			{
+				endpoints[0][c] = 255.0f;
+				endpoints[1][c] = 255.0f;
+			}
+		}
+	}
+
+	// solve for the two endpoints that best reproduce the
+	// texels with the chosen indexes, where the texel of each
+	// index sits the fraction weights[index] of the way from
+	// the first endpoint to the second, false when every
+	// texel has the same fraction
+	bool RefitEndpoints(
+		const BLOCK_CHANNELS& channels,
+		const int indices[BLOCK_TEXELS],
+		const float weights[],
+		float endpoints[2][4])
+	{
+		float sumA = 0.0f;
+		float sumB = 0.0f;
+		float sumC = 0.0f;
+		float sumX0[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float sumX1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float determinant = 0.0f;
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			const float t = weights[indices[i]];
+
+			sumA += (1.0f - t) * (1.0f - t);
+			sumB += (1.0f - t) * t;
+			sumC += t * t;
+			for (int c = 0; c < 4; c++)
+			{
+				sumX0[c] += (1.0f - t) * channels.values[c][i];
+				sumX1[c] += t * channels.values[c][i];
+			}
+		}
+
+		determinant = sumA * sumC - sumB * sumB;
+		if (std::fabs(determinant) < 1.0e-6f)
+		{
+			return(false);
+		}
+		for (int c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = std::min(std::max((sumC * sumX0[c] - sumB * sumX1[c]) / determinant, 0.0f), 255.0f);
+			endpoints[1][c] = std::min(std::max((sumA * sumX1[c] - sumB * sumX0[c]) / determinant, 0.0f), 255.0f);
+		}
+
+		return(true);
+	}
+
+	// pack a color into 5:6:5 bits
+	uint16_t PackColor565(const float color[4])
+	{
+		const int red = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+		const int green = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+		const int blue = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+
+		return((uint16_t)((red << 11) | (green << 5) | blue));
+	}
+
+	// expand a 5:6:5 color to 8 bits a channel
+	void UnpackColor565(uint16_t packed, int color[3])
+	{
+		const int red = (packed >> 11) & 31;
+		const int green = (packed >> 5) & 63;
+		const int blue = packed & 31;
+
+		color[0] = (red << 3) | (red >> 2);
+		color[1] = (green << 2) | (green >> 4);
+		color[2] = (blue << 3) | (blue >> 2);
+	}
+
+	// build the four color palette of two 5:6:5 endpoints, the
+	// way every decoder rounds the two colors between them
+	void BuildColorPalette(uint16_t color0, uint16_t color1, float palette[4][4])
+	{
+		int end0[3];
+		int end1[3];
+
+		UnpackColor565(color0, end0);
+		UnpackColor565(color1, end1);
+		for (int c = 0; c < 3; c++)
+		{
+			palette[0][c] = (float)end0[c];
+			palette[1][c] = (float)end1[c];
+			palette[2][c] = (float)((2 * end0[c] + end1[c]) / 3);
+			palette[3][c] = (float)((end0[c] + 2 * end1[c]) / 3);
+		}
+		for (int p = 0; p < 4; p++)
+		{
+			palette[p][3] = 0.0f;
+		}
+	}
+
+	// encode the endpoints and indexes of a color block with
+	// two endpoints, and return its error
+	float EncodeColorEndpoints(
+		const BLOCK_CHANNELS& channels,
+		const float endpoints[2][4],
+		unsigned char block[8])
+	{
+		static const float s_ColorWeights[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+		uint16_t color0 = PackColor565(endpoints[1]);
+		uint16_t color1 = PackColor565(endpoints[0]);
+		float palette[4][4];
+		int indices[BLOCK_TEXELS];
+		uint32_t indexBits = 0;
+		float error = 0.0f;
+
+		// the first color has to be the larger for the block to
+		// be read as four colors
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+		}
+		BuildColorPalette(color0, color1, palette);
+		if (color0 == color1)
+		{
+			error = FindNearestIndices(channels, palette, 1, s_ColorWeights, indices);
+		}
+		else
+		{
+			error = FindNearestIndices(channels, palette, 4, s_ColorWeights, indices);
+		}
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			indexBits |= (uint32_t)indices[i] << (i * 2);
+		}
+		block[0] = (unsigned char)(color0 & 0xFF);
+		block[1] = (unsigned char)(color0 >> 8);
+		block[2] = (unsigned char)(color1 & 0xFF);
+		block[3] = (unsigned char)(color1 >> 8);
+		memcpy(block + 4, &indexBits, 4);
+
+		return(error);
+	}
+
+	// encode the color half of a BC1 or BC3 block, fitting
+	// the endpoints to the texels and then once more to the
+	// indexes chosen for them, keeping the better of the two
+	void EncodeColorBlock(const BLOCK_CHANNELS& channels, unsigned char block[8])
+	{
+		// fraction from the second endpoint of each index, the
+		// first color is the larger endpoint
+		static const float s_IndexWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		float endpoints[2][4];
+		unsigned char refitBlock[8];
+		float error = 0.0f;
+		int indices[BLOCK_TEXELS];
+		uint16_t color0 = 0;
+		uint16_t color1 = 0;
+		float refitEndpoints[2][4];
+
+		FitEndpoints(channels, 3, endpoints);
+		error = EncodeColorEndpoints(channels, endpoints, block);
+
+		color0 = (uint16_t)(block[0] | (block[1] << 8));
+		color1 = (uint16_t)(block[2] | (block[3] << 8));
+		if (color0 == color1)
+		{
+			return;
+		}
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			indices[i] = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+		}
+		if (RefitEndpoints(channels, indices, s_IndexWeights, refitEndpoints) == true)
+		{
+			if (EncodeColorEndpoints(channels, refitEndpoints, refitBlock) < error)
+			{
+				memcpy(block, refitBlock, 8);
+			}
+		}
+	}
+
+	// encode the alpha half of a BC3 block, between the least
+	// and greatest alpha with six values between them
+	void EncodeAlphaBlock(const BLOCK_CHANNELS& channels, unsigned char block[8])
+	{
+		static const float s_AlphaWeights[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		float palette[8][4];
+		int indices[BLOCK_TEXELS];
+		int alpha0 = 0;
+		int alpha1 = 255;
+		uint64_t indexBits = 0;
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			alpha0 = std::max(alpha0, (int)channels.values[3][i]);
+			alpha1 = std::min(alpha1, (int)channels.values[3][i]);
+		}
+
+		memset(palette, 0, sizeof(palette));
+		palette[0][3] = (float)alpha0;
+		palette[1][3] = (float)alpha1;
+		for (int p = 2; p < 8; p++)
+		{
+			palette[p][3] = (float)(((8 - p) * alpha0 + (p - 1) * alpha1) / 7);
+		}
+		FindNearestIndices(channels, palette, (alpha0 == alpha1) ? 1 : 8, s_AlphaWeights, indices);
+
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			indexBits |= (uint64_t)indices[i] << (i * 3);
+		}
+		block[0] = (unsigned char)alpha0;
+		block[1] = (unsigned char)alpha1;
+		for (int i = 0; i < 6; i++)
+		{
+			block[2 + i] = (unsigned char)((indexBits >> (i * 8)) & 0xFF);
+		}
+	}
+
+	// quantize an endpoint to 7 bits a channel and the shared
+	// low bit that gives the smaller error
+	void QuantizeBC7Endpoint(const float endpoint[4], int quantized[4], int& pBit)
+	{
+		float bestError = 3.0e38f;
+
+		for (int p = 0; p < 2; p++)
+		{
+			int candidate[4];
+			float error = 0.0f;
+
+			for (int c = 0; c < 4; c++)
+			{
+				const int value = (int)std::floor((endpoint[c] - p) / 2.0f + 0.5f);
+
+				candidate[c] = std::min(std::max(value, 0), 127);
+				error += (endpoint[c] - ((candidate[c] << 1) | p)) * (endpoint[c] - ((candidate[c] << 1) | p));
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				pBit = p;
+				memcpy(quantized, candidate, sizeof(candidate));
+			}
+		}
+	}
+
+	// quantized endpoints and indexes of a BC7 block
+	struct BC7_ENCODING
+	{
+		int endpoints[2][4];
+		int pBits[2];
+		int indices[BLOCK_TEXELS];
+		float error;
+	};
+
+	// quantize two endpoints for BC7 and choose the indexes
+	void EncodeBC7Endpoints(const BLOCK_CHANNELS& channels, const float endpoints[2][4], BC7_ENCODING& encoding)
+	{
+		static const float s_ChannelWeights[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float palette[MAX_PALETTE][4];
+		int end0[4];
+		int end1[4];
+
+		QuantizeBC7Endpoint(endpoints[0], encoding.endpoints[0], encoding.pBits[0]);
+		QuantizeBC7Endpoint(endpoints[1], encoding.endpoints[1], encoding.pBits[1]);
+		for (int c = 0; c < 4; c++)
+		{
+			end0[c] = (encoding.endpoints[0][c] << 1) | encoding.pBits[0];
+			end1[c] = (encoding.endpoints[1][c] << 1) | encoding.pBits[1];
+		}
+		for (int p = 0; p < MAX_PALETTE; p++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				palette[p][c] = (float)(((64 - g_BC7Weights[p]) * end0[c] + g_BC7Weights[p] * end1[c] + 32) >> 6);
+			}
+		}
+		encoding.error = FindNearestIndices(channels, palette, MAX_PALETTE, s_ChannelWeights, encoding.indices);
+	}
+
+	// write the low bits of a value after the bits already
+	// written to a block
+	void WriteBits(unsigned char block[16], int& bitPosition, uint32_t value, int bitCount)
+	{
+		for (int i = 0; i < bitCount; i++, bitPosition++)
+		{
+			if (((value >> i) & 1) != 0)
+			{
+				block[bitPosition / 8] |= (unsigned char)(1 << (bitPosition % 8));
+			}
+		}
+	}
+
+	// read the next bits of a block
+	uint32_t ReadBits(const unsigned char block[16], int& bitPosition, int bitCount)
+	{
+		uint32_t value = 0;
+
+		for (int i = 0; i < bitCount; i++, bitPosition++)
+		{
+			value |= (uint32_t)((block[bitPosition / 8] >> (bitPosition % 8)) & 1) << i;
+		}
+
+		return(value);
+	}
+
+	// decode the color half of a BC1 or BC3 block, BC3 always
+	// reads it as four colors
+	void DecodeColorBlock(const unsigned char block[8], unsigned char texels[64], bool bFourColors)
+	{
+		const uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+		const uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+		int palette[4][4];
+		uint32_t indexBits = 0;
+
+		UnpackColor565(color0, palette[0]);
+		UnpackColor565(color1, palette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			if ((bFourColors == true) || (color0 > color1))
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[0][3] = 255;
+		palette[1][3] = 255;
+		palette[2][3] = 255;
+		palette[3][3] = ((bFourColors == true) || (color0 > color1)) ? 255 : 0;
+
+		memcpy(&indexBits, block + 4, 4);
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			const int index = (indexBits >> (i * 2)) & 3;
+
+			for (int c = 0; c < 4; c++)
+			{
+				texels[i * 4 + c] = (unsigned char)palette[index][c];
+			}
+		}
+	}
+
+	// bytes of one block of a compressed format
+	int GetBlockBytes(TEXTURE_FORMAT format)
+	{
+		return((format == TEXTURE_FORMAT_BC1) ? 8 : 16);
+	}
+}
+
+/***********************************************************
+ *  EncodeBC1Block()
+ *
+ *  This function is used for encoding a block to BC1, two
+ *  5:6:5 colors and a 2 bit index a texel, 8 bytes in all.
+ ***********************************************************/
+void EncodeBC1Block(const unsigned char texels[64], unsigned char block[8])
+{
+	BLOCK_CHANNELS channels;
+
+	LoadBlockChannels(texels, channels);
+	EncodeColorBlock(channels, block);
+}
+
+/***********************************************************
+ *  EncodeBC3Block()
+ *
+ *  This function is used for encoding a block to BC3, an
+ *  alpha block of two 8 bit values and a 3 bit index a
+ *  texel, followed by a BC1 color block, 16 bytes in all.
+ ***********************************************************/
+void EncodeBC3Block(const unsigned char texels[64], unsigned char block[16])
+{
+	BLOCK_CHANNELS channels;
+
+	LoadBlockChannels(texels, channels);
+	EncodeAlphaBlock(channels, block);
+	EncodeColorBlock(channels, block + 8);
+}
+
+/***********************************************************
+ *  EncodeBC7Block()
+ *
+ *  This function is used for encoding a block to BC7 mode
+ *  6, one pair of RGBA endpoints of 7 bits a channel and a
+ *  shared low bit each, with a 4 bit index a texel. Mode 6
+ *  is the single subset mode with the finest indexes, which
+ *  suits the smooth, noisy scene textures. The first index
+ *  has only 3 bits, so the endpoints are swapped when it
+ *  would need the fourth.
+ ***********************************************************/
+void EncodeBC7Block(const unsigned char texels[64], unsigned char block[16])
+{
+	float indexWeights[MAX_PALETTE];
+	BLOCK_CHANNELS channels;
+	float endpoints[2][4];
+	BC7_ENCODING encoding;
+	BC7_ENCODING refitEncoding;
+	int bitPosition = 0;
+
+	for (int p = 0; p < MAX_PALETTE; p++)
+	{
+		indexWeights[p] = g_BC7Weights[p] / 64.0f;
+	}
+
+	LoadBlockChannels(texels, channels);
+	FitEndpoints(channels, 4, endpoints);
+	EncodeBC7Endpoints(channels, endpoints, encoding);
+	if (RefitEndpoints(channels, encoding.indices, indexWeights, endpoints) == true)
+	{
+		EncodeBC7Endpoints(channels, endpoints, refitEncoding);
+		if (refitEncoding.error < encoding.error)
+		{
+			encoding = refitEncoding;
+		}
+	}
+
+	if (encoding.indices[0] >= 8)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			std::swap(encoding.endpoints[0][c], encoding.endpoints[1][c]);
+		}
+		std::swap(encoding.pBits[0], encoding.pBits[1]);
+		for (int i = 0; i < BLOCK_TEXELS; i++)
+		{
+			encoding.indices[i] = 15 - encoding.indices[i];
+		}
+	}
+
+	memset(block, 0, 16);
+	// mode 6 is a single one bit after six zero bits
+	WriteBits(block, bitPosition, 1 << 6, 7);
+	for (int c = 0; c < 4; c++)
+	{
+		WriteBits(block, bitPosition, encoding.endpoints[0][c], 7);
+		WriteBits(block, bitPosition, encoding.endpoints[1][c], 7);
+	}
+	WriteBits(block, bitPosition, encoding.pBits[0], 1);
+	WriteBits(block, bitPosition, encoding.pBits[1], 1);
+	for (int i = 0; i < BLOCK_TEXELS; i++)
+	{
+		WriteBits(block, bitPosition, encoding.indices[i], (i == 0) ? 3 : 4);
+	}
+}
+
+/***********************************************************
+ *  DecodeBC1Block()
+ *
+ *  This function is used for decoding a BC1 block.
+ ***********************************************************/
+void DecodeBC1Block(const unsigned char block[8], unsigned char texels[64])
+{
+	DecodeColorBlock(block, texels, false);
+}
+
+/***********************************************************
+ *  DecodeBC3Block()
+ *
+ *  This function is used for decoding a BC3 block.
+ ***********************************************************/
+void DecodeBC3Block(const unsigned char block[16], unsigned char texels[64])
+{
+	const int alpha0 = block[0];
+	const int alpha1 = block[1];
+	int palette[8];
+	uint64_t indexBits = 0;
+
+	DecodeColorBlock(block + 8, texels, true);
+
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	for (int p = 2; p < 8; p++)
+	{
+		if (alpha0 > alpha1)
+		{
+			palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+		}
+		else if (p < 6)
+		{
+			palette[p] = ((6 - p) * alpha0 + (p - 1) * alpha1) / 5;
+		}
+		else
+		{
+			palette[p] = (p == 6) ? 0 : 255;
+		}
+	}
+
+	for (int i = 0; i < 6; i++)
+	{
+		indexBits |= (uint64_t)block[2 + i] << (i * 8);
+	}
+	for (int i = 0; i < BLOCK_TEXELS; i++)
+	{
+		texels[i * 4 + 3] = (unsigned char)palette[(indexBits >> (i * 3)) & 7];
+	}
+}
+
+/***********************************************************
+ *  DecodeBC7Block()
+ *
+ *  This function is used for decoding a BC7 block written
+ *  in mode 6.
+ ***********************************************************/
+bool DecodeBC7Block(const unsigned char block[16], unsigned char texels[64])
+{
+	int endpoints[2][4];
+	int pBits[2];
+	int bitPosition = 0;
+
+	if (ReadBits(block, bitPosition, 7) != (1 << 6))
+	{
+		return(false);
+	}
+	for (int c = 0; c < 4; c++)
+	{
+		endpoints[0][c] = (int)ReadBits(block, bitPosition, 7);
+		endpoints[1][c] = (int)ReadBits(block, bitPosition, 7);
+	}
+	pBits[0] = (int)ReadBits(block, bitPosition, 1);
+	pBits[1] = (int)ReadBits(block, bitPosition, 1);
+	for (int c = 0; c < 4; c++)
+	{
+		endpoints[0][c] = (endpoints[0][c] << 1) | pBits[0];
+		endpoints[1][c] = (endpoints[1][c] << 1) | pBits[1];
+	}
+
+	for (int i = 0; i < BLOCK_TEXELS; i++)
+	{
+		const int weight = g_BC7Weights[ReadBits(block, bitPosition, (i == 0) ? 3 : 4)];
+
+		for (int c = 0; c < 4; c++)
+		{
+			texels[i * 4 + c] = (unsigned char)(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  EncodeTextureBlocks()
+ *
+ *  This function is used for encoding rows of blocks of a
+ *  texture level. The rows are independent, so a level can
+ *  be split across threads by rows.
+ ***********************************************************/
+void EncodeTextureBlocks(
+	TEXTURE_FORMAT format,
+	const unsigned char* texels,
+	int width,
+	int height,
+	int channels,
+	int firstBlockRow,
+	int blockRowCount,
+	unsigned char* blocks)
+{
+	const int blocksWide = (width + 3) / 4;
+	const int blockBytes = GetBlockBytes(format);
+	unsigned char blockTexels[64];
+
+	for (int blockRow = firstBlockRow; blockRow < firstBlockRow + blockRowCount; blockRow++)
+	{
+		for (int blockColumn = 0; blockColumn < blocksWide; blockColumn++)
+		{
+			unsigned char* pBlock = blocks + ((size_t)blockRow * blocksWide + blockColumn) * blockBytes;
+
+			for (int i = 0; i < BLOCK_TEXELS; i++)
+			{
+				const int x = std::min(blockColumn * 4 + (i % 4), width - 1);
+				const int y = std::min(blockRow * 4 + (i / 4), height - 1);
+				const unsigned char* pTexel = texels + ((size_t)y * width + x) * channels;
+
+				blockTexels[i * 4 + 0] = pTexel[0];
+				blockTexels[i * 4 + 1] = pTexel[1];
+				blockTexels[i * 4 + 2] = pTexel[2];
+				blockTexels[i * 4 + 3] = (channels == 4) ? pTexel[3] : 255;
+			}
+
+			if (format == TEXTURE_FORMAT_BC1)
+			{
+				EncodeBC1Block(blockTexels, pBlock);
+			}
+			else if (format == TEXTURE_FORMAT_BC3)
+			{
+				EncodeBC3Block(blockTexels, pBlock);
+			}
+			else
+			{
+				EncodeBC7Block(blockTexels, pBlock);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  DecodeTextureBlocks()
+ *
+ *  This function is used for decoding a whole compressed
+ *  texture level, for comparing it with the source level.
+ ***********************************************************/
+bool DecodeTextureBlocks(
+	TEXTURE_FORMAT format,
+	const unsigned char* blocks,
+	int width,
+	int height,
+	unsigned char* texels)
+{
+	const int blocksWide = (width + 3) / 4;
+	const int blocksHigh = (height + 3) / 4;
+	const int blockBytes = GetBlockBytes(format);
+	unsigned char blockTexels[64];
+
+	for (int blockRow = 0; blockRow < blocksHigh; blockRow++)
+	{
+		for (int blockColumn = 0; blockColumn < blocksWide; blockColumn++)
+		{
+			const unsigned char* pBlock = blocks + ((size_t)blockRow * blocksWide + blockColumn) * blockBytes;
+
+			if (format == TEXTURE_FORMAT_BC1)
+			{
+				DecodeBC1Block(pBlock, blockTexels);
+			}
+			else if (format == TEXTURE_FORMAT_BC3)
+			{
+				DecodeBC3Block(pBlock, blockTexels);
+			}
+			else if (DecodeBC7Block(pBlock, blockTexels) == false)
+			{
+				return(false);
+			}
+
+			for (int i = 0; i < BLOCK_TEXELS; i++)
+			{
+				const int x = blockColumn * 4 + (i % 4);
+				const int y = blockRow * 4 + (i / 4);
+
+				if ((x < width) && (y < height))
+				{
+					memcpy(texels + ((size_t)y * width + x) * 4, blockTexels + i * 4, 4);
+				}
+			}
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsBlockCompressionSimd()
+ *
+ *  This function is used for checking whether the index
+ *  search was built with SSE2.
+ ***********************************************************/
+bool IsBlockCompressionSimd()
+{
+#ifdef BLOCK_COMPRESSION_SSE2
+	return(true);
+#else
+	return(false);
+#endif
+}
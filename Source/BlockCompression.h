@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+// blockcompression.h
+// ============
+// encode texels to the BC1, BC3 and BC7 block compressed formats the GPU
+// samples directly, and decode them to measure the error
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureCache.h"
+
+// encode the 16 texels of a 4x4 block, RGBA by rows, to a block
+// of the format, BC1 keeps no alpha
+void EncodeBC1Block(const unsigned char texels[64], unsigned char block[8]);
+void EncodeBC3Block(const unsigned char texels[64], unsigned char block[16]);
+void EncodeBC7Block(const unsigned char texels[64], unsigned char block[16]);
+
+// decode a block to 16 RGBA texels, the BC7 decoder only reads
+// the single subset mode the encoder writes and returns false
+// for any other
+void DecodeBC1Block(const unsigned char block[8], unsigned char texels[64]);
+void DecodeBC3Block(const unsigned char block[16], unsigned char texels[64]);
+bool DecodeBC7Block(const unsigned char block[16], unsigned char texels[64]);
+
+// encode rows of 4x4 blocks of a texture level with 3 or 4
+// channels, the blocks past the right and bottom edges repeat
+// the last column and row
+void EncodeTextureBlocks(
+	TEXTURE_FORMAT format,
+	const unsigned char* texels,
+	int width,
+	int height,
+	int channels,
+	int firstBlockRow,
+	int blockRowCount,
+	unsigned char* blocks);
+// decode a block compressed texture level to RGBA texels,
+// false when a block could not be decoded
+bool DecodeTextureBlocks(
+	TEXTURE_FORMAT format,
+	const unsigned char* blocks,
+	int width,
+	int height,
+	unsigned char* texels);
+
+// true when the index search runs four texels at a time
+// with SSE2
+bool IsBlockCompressionSimd();
@@ -0,0 +1,693 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.cpp
+// ============
+// bounding volume tree over the scene objects for culling and queries
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// number of bins the object centers are sorted into when
+	// looking for the cheapest split
+	const int SAH_BIN_COUNT = 16;
+	// nodes with this many items or fewer may become leaves
+	const int MAX_LEAF_ITEMS = 4;
+	// relative cost of visiting a node against testing an item
+	const float NODE_TRAVERSAL_COST = 1.0f;
+	// subtrees smaller than this are not worth a worker thread
+	const int MIN_TASK_ITEMS = 256;
+	// deepest tree supported by the query stacks
+	const int MAX_TREE_DEPTH = 64;
+
+	// half the surface area of a box
+	float HalfArea(const BOUNDING_BOX& box)
+	{
+		glm::vec3 size = box.maxPoint - box.minPoint;
+
+		if ((size.x < 0.0f) || (size.y < 0.0f) || (size.z < 0.0f))
+		{
+			return(0.0f);
+		}
+		return((size.x * size.y) + (size.y * size.z) + (size.z * size.x));
+	}
+
+	// a box that encloses nothing
+	BOUNDING_BOX EmptyBox()
+	{
+		BOUNDING_BOX box;
+		box.minPoint = glm::vec3(1.0e30f);
+		box.maxPoint = glm::vec3(-1.0e30f);
+		return(box);
+	}
+
+	// distance along a ray where it enters a box, or a value
+	// past maxDistance when the ray misses the box
+	float IntersectRayBox(
+		const glm::vec3& origin,
+		const glm::vec3& inverseDirection,
+		float maxDistance,
+		const BOUNDING_BOX& box)
+	{
+		float nearDistance = 0.0f;
+		float farDistance = maxDistance;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float t0 = (box.minPoint[axis] - origin[axis]) * inverseDirection[axis];
+			float t1 = (box.maxPoint[axis] - origin[axis]) * inverseDirection[axis];
+
+			if (t0 > t1)
+			{
+				std::swap(t0, t1);
+			}
+			nearDistance = std::max(nearDistance, t0);
+			farDistance = std::min(farDistance, t1);
+			if (nearDistance > farDistance)
+			{
+				return(maxDistance + 1.0f);
+			}
+		}
+
+		return(nearDistance);
+	}
+
+	// true when a sphere reaches into a box
+	bool SphereOverlapsBox(const BOUNDING_SPHERE& sphere, const BOUNDING_BOX& box)
+	{
+		glm::vec3 center(sphere.x, sphere.y, sphere.z);
+		glm::vec3 offset = glm::clamp(center, box.minPoint, box.maxPoint) - center;
+
+		return(glm::dot(offset, offset) <= (sphere.w * sphere.w));
+	}
+}
+
+/***********************************************************
+ *  BoundingVolumeHierarchy()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(WorkerPool* pWorkerPool)
+{
+	m_pWorkerPool = pWorkerPool;
+	m_buildCost = 0.0f;
+}
+
+/***********************************************************
+ *  ~BoundingVolumeHierarchy()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+	m_pWorkerPool = NULL;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every item and node.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Clear()
+{
+	m_nodes.clear();
+	m_itemBoxes.clear();
+	m_itemCenters.clear();
+	m_itemIDs.clear();
+	m_itemOrder.clear();
+	m_buildCost = 0.0f;
+}
+
+/***********************************************************
+ *  GetItemCount()
+ *
+ *  This method is used for getting the number of items in
+ *  the tree.
+ ***********************************************************/
+int BoundingVolumeHierarchy::GetItemCount() const
+{
+	return((int)m_itemIDs.size());
+}
+
+/***********************************************************
+ *  GetNodeCount()
+ *
+ *  This method is used for getting the number of nodes in
+ *  the tree.
+ ***********************************************************/
+int BoundingVolumeHierarchy::GetNodeCount() const
+{
+	return((int)m_nodes.size());
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the tree over a set of
+ *  item boxes. The top levels are split on this thread until
+ *  there is a subtree for every worker, with some extra to
+ *  even out the load, then the subtrees are built in
+ *  parallel and joined into the node array.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Build(const std::vector<BOUNDING_BOX>& itemBoxes, const std::vector<int>& itemIDs)
+{
+	std::vector<BVH_BUILD_TASK> tasks;
+	const int itemCount = (int)itemBoxes.size();
+	int taskDepth = 0;
+
+	Clear();
+	if (itemCount == 0)
+	{
+		return;
+	}
+
+	m_itemBoxes = itemBoxes;
+	m_itemIDs = itemIDs;
+	m_itemCenters.resize(itemCount);
+	m_itemOrder.resize(itemCount);
+	for (int i = 0; i < itemCount; i++)
+	{
+		m_itemCenters[i] = (itemBoxes[i].minPoint + itemBoxes[i].maxPoint) * 0.5f;
+		m_itemOrder[i] = i;
+	}
+
+	// about four subtrees for each thread
+	while ((1 << taskDepth) < (m_pWorkerPool->GetThreadCount() * 4))
+	{
+		taskDepth++;
+	}
+
+	m_nodes.reserve(itemCount * 2);
+	m_nodes.push_back(BVH_NODE());
+	BuildTopLevel(0, 0, itemCount, 0, taskDepth, tasks);
+
+	m_pWorkerPool->ParallelFor((int)tasks.size(), 1, [this, &tasks](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				tasks[i].nodes.push_back(BVH_NODE());
+				InitializeNode(tasks[i].nodes[0], tasks[i].firstItem, tasks[i].itemCount);
+				BuildSubtree(tasks[i].nodes, 0, tasks[i].treeDepth);
+			}
+		});
+
+	// the subtree root takes the place of the node it was
+	// built for, the rest of the subtree is appended so the
+	// children still come after their parents
+	for (size_t t = 0; t < tasks.size(); t++)
+	{
+		const std::vector<BVH_NODE>& subtree = tasks[t].nodes;
+		const int baseIndex = (int)m_nodes.size() - 1;
+
+		for (size_t i = 0; i < subtree.size(); i++)
+		{
+			BVH_NODE node = subtree[i];
+
+			if (node.leftChild != -1)
+			{
+				node.leftChild += baseIndex;
+			}
+			if (i == 0)
+			{
+				m_nodes[tasks[t].nodeIndex] = node;
+			}
+			else
+			{
+				m_nodes.push_back(node);
+			}
+		}
+	}
+
+	m_buildCost = ComputeTreeCost();
+}
+
+/***********************************************************
+ *  BuildTopLevel()
+ *
+ *  This method is used for splitting the top of the tree on
+ *  the calling thread. Once the task depth is reached, or a
+ *  node is too small to be worth a thread, the node is added
+ *  to the task list instead of being split further.
+ ***********************************************************/
+void BoundingVolumeHierarchy::BuildTopLevel(
+	int nodeIndex,
+	int firstItem,
+	int itemCount,
+	int treeDepth,
+	int taskDepth,
+	std::vector<BVH_BUILD_TASK>& tasks)
+{
+	int leftCount = 0;
+	int leftChild = 0;
+
+	InitializeNode(m_nodes[nodeIndex], firstItem, itemCount);
+
+	if ((treeDepth == taskDepth) || (itemCount < MIN_TASK_ITEMS))
+	{
+		BVH_BUILD_TASK task;
+		task.nodeIndex = nodeIndex;
+		task.firstItem = firstItem;
+		task.itemCount = itemCount;
+		task.treeDepth = treeDepth;
+		tasks.push_back(task);
+		return;
+	}
+
+	if (SplitNode(m_nodes[nodeIndex], treeDepth, leftCount) == false)
+	{
+		return;
+	}
+
+	leftChild = (int)m_nodes.size();
+	m_nodes[nodeIndex].leftChild = leftChild;
+	m_nodes.push_back(BVH_NODE());
+	m_nodes.push_back(BVH_NODE());
+	BuildTopLevel(leftChild, firstItem, leftCount, treeDepth + 1, taskDepth, tasks);
+	BuildTopLevel(leftChild + 1, firstItem + leftCount, itemCount - leftCount, treeDepth + 1, taskDepth, tasks);
+}
+
+/***********************************************************
+ *  BuildSubtree()
+ *
+ *  This method is used for building a whole subtree below a
+ *  node that already has its bounds and item range set. It
+ *  only touches the passed in nodes and its own range of the
+ *  item order, so subtrees can be built at the same time.
+ ***********************************************************/
+void BoundingVolumeHierarchy::BuildSubtree(std::vector<BVH_NODE>& nodes, int nodeIndex, int treeDepth)
+{
+	int leftCount = 0;
+	int leftChild = 0;
+	BVH_NODE node = nodes[nodeIndex];
+
+	if (SplitNode(node, treeDepth, leftCount) == false)
+	{
+		return;
+	}
+
+	leftChild = (int)nodes.size();
+	nodes[nodeIndex].leftChild = leftChild;
+	nodes.push_back(BVH_NODE());
+	nodes.push_back(BVH_NODE());
+	InitializeNode(nodes[leftChild], node.firstItem, leftCount);
+	InitializeNode(nodes[leftChild + 1], node.firstItem + leftCount, node.itemCount - leftCount);
+	BuildSubtree(nodes, leftChild, treeDepth + 1);
+	BuildSubtree(nodes, leftChild + 1, treeDepth + 1);
+}
+
+/***********************************************************
+ *  InitializeNode()
+ *
+ *  This method is used for setting up a leaf node over a
+ *  range of the item order, with bounds enclosing the items.
+ ***********************************************************/
+void BoundingVolumeHierarchy::InitializeNode(BVH_NODE& node, int firstItem, int itemCount) const
+{
+	node.bounds = EmptyBox();
+	node.leftChild = -1;
+	node.firstItem = firstItem;
+	node.itemCount = itemCount;
+	for (int i = firstItem; i < firstItem + itemCount; i++)
+	{
+		MergeBoundingBox(node.bounds, m_itemBoxes[m_itemOrder[i]]);
+	}
+}
+
+/***********************************************************
+ *  SplitNode()
+ *
+ *  This method is used for finding the cheapest split of the
+ *  node items. The item centers are sorted into bins along
+ *  each axis and every split between bins is scored by the
+ *  surface area heuristic. The items of the node are then
+ *  partitioned so the left child items come first. Small
+ *  nodes that are cheaper to test as a whole stay leaves,
+ *  and so does any node at the deepest supported level.
+ ***********************************************************/
+bool BoundingVolumeHierarchy::SplitNode(const BVH_NODE& node, int treeDepth, int& leftCount)
+{
+	BOUNDING_BOX centerBounds = EmptyBox();
+	float bestCost = 1.0e30f;
+	int bestAxis = -1;
+	int bestBin = 0;
+	int* itemOrder = m_itemOrder.data();
+
+	if ((node.itemCount <= 1) || (treeDepth >= (MAX_TREE_DEPTH - 1)))
+	{
+		return(false);
+	}
+
+	for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+	{
+		centerBounds.minPoint = glm::min(centerBounds.minPoint, m_itemCenters[m_itemOrder[i]]);
+		centerBounds.maxPoint = glm::max(centerBounds.maxPoint, m_itemCenters[m_itemOrder[i]]);
+	}
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		BOUNDING_BOX binBounds[SAH_BIN_COUNT];
+		int binCounts[SAH_BIN_COUNT];
+		float rightCosts[SAH_BIN_COUNT];
+		float extent = centerBounds.maxPoint[axis] - centerBounds.minPoint[axis];
+		BOUNDING_BOX sweepBounds = EmptyBox();
+		int sweepCount = 0;
+
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+
+		for (int b = 0; b < SAH_BIN_COUNT; b++)
+		{
+			binBounds[b] = EmptyBox();
+			binCounts[b] = 0;
+		}
+		for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+		{
+			int item = m_itemOrder[i];
+			int bin = (int)(((m_itemCenters[item][axis] - centerBounds.minPoint[axis]) / extent) * SAH_BIN_COUNT);
+
+			bin = std::min(bin, SAH_BIN_COUNT - 1);
+			MergeBoundingBox(binBounds[bin], m_itemBoxes[item]);
+			binCounts[bin]++;
+		}
+
+		// sweep from the right to get the cost of every right side
+		for (int b = SAH_BIN_COUNT - 1; b > 0; b--)
+		{
+			MergeBoundingBox(sweepBounds, binBounds[b]);
+			sweepCount += binCounts[b];
+			rightCosts[b] = HalfArea(sweepBounds) * sweepCount;
+		}
+
+		// then from the left, adding the matching right side
+		sweepBounds = EmptyBox();
+		sweepCount = 0;
+		for (int b = 0; b < SAH_BIN_COUNT - 1; b++)
+		{
+			MergeBoundingBox(sweepBounds, binBounds[b]);
+			sweepCount += binCounts[b];
+
+			float cost = (HalfArea(sweepBounds) * sweepCount) + rightCosts[b + 1];
+			if ((sweepCount > 0) && (sweepCount < node.itemCount) && (cost < bestCost))
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = b;
+			}
+		}
+	}
+
+	if (bestAxis == -1)
+	{
+		// every center is in the same place, split the items
+		// in half when there are too many for one leaf
+		if (node.itemCount <= MAX_LEAF_ITEMS)
+		{
+			return(false);
+		}
+		leftCount = node.itemCount / 2;
+		return(true);
+	}
+
+	// keep the node as a leaf when testing its items directly
+	// is cheaper than visiting two children
+	bestCost = NODE_TRAVERSAL_COST + (bestCost / HalfArea(node.bounds));
+	if ((node.itemCount <= MAX_LEAF_ITEMS) && (bestCost >= (float)node.itemCount))
+	{
+		return(false);
+	}
+
+	const float binScale = SAH_BIN_COUNT / (centerBounds.maxPoint[bestAxis] - centerBounds.minPoint[bestAxis]);
+	const float axisMin = centerBounds.minPoint[bestAxis];
+	int* middle = std::partition(
+		itemOrder + node.firstItem,
+		itemOrder + node.firstItem + node.itemCount,
+		[this, bestAxis, bestBin, binScale, axisMin](int item)
+		{
+			int bin = (int)((m_itemCenters[item][bestAxis] - axisMin) * binScale);
+			return(std::min(bin, SAH_BIN_COUNT - 1) <= bestBin);
+		});
+	leftCount = (int)(middle - (itemOrder + node.firstItem));
+
+	return(true);
+}
+
+/***********************************************************
+ *  ComputeTreeCost()
+ *
+ *  This method is used for getting the surface area cost of
+ *  the tree, the sum of the node areas relative to the root.
+ *  A refit tree with a much higher cost than it was built
+ *  with tests many more nodes and should be rebuilt.
+ ***********************************************************/
+float BoundingVolumeHierarchy::ComputeTreeCost() const
+{
+	float cost = 0.0f;
+	float rootArea = 0.0f;
+
+	if (m_nodes.empty() == true)
+	{
+		return(0.0f);
+	}
+
+	rootArea = std::max(HalfArea(m_nodes[0].bounds), 1.0e-6f);
+	for (size_t i = 0; i < m_nodes.size(); i++)
+	{
+		const BVH_NODE& node = m_nodes[i];
+		float area = HalfArea(node.bounds) / rootArea;
+
+		if (node.leftChild == -1)
+		{
+			cost += area * node.itemCount;
+		}
+		else
+		{
+			cost += area * NODE_TRAVERSAL_COST;
+		}
+	}
+
+	return(cost);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for updating the node boxes after the
+ *  item boxes changed. The nodes are walked from the end of
+ *  the array, so both children of a node are already updated
+ *  when the node itself is reached.
+ ***********************************************************/
+float BoundingVolumeHierarchy::Refit(const std::vector<BOUNDING_BOX>& itemBoxes)
+{
+	if ((m_nodes.empty() == true) || (itemBoxes.size() != m_itemBoxes.size()))
+	{
+		return(1.0f);
+	}
+
+	m_itemBoxes = itemBoxes;
+	for (int i = (int)m_nodes.size() - 1; i >= 0; i--)
+	{
+		BVH_NODE& node = m_nodes[i];
+
+		if (node.leftChild == -1)
+		{
+			InitializeNode(node, node.firstItem, node.itemCount);
+		}
+		else
+		{
+			node.bounds = m_nodes[node.leftChild].bounds;
+			MergeBoundingBox(node.bounds, m_nodes[node.leftChild + 1].bounds);
+		}
+	}
+
+	return(ComputeTreeCost() / std::max(m_buildCost, 1.0e-6f));
+}
+
+/***********************************************************
+ *  QueryFrustum()
+ *
+ *  This method is used for collecting the items that are at
+ *  least partly inside the view frustum. A node that is fully
+ *  inside adds its whole item range without further tests.
+ ***********************************************************/
+int BoundingVolumeHierarchy::QueryFrustum(const ViewFrustum& frustum, std::vector<int>& itemIDs) const
+{
+	int stack[MAX_TREE_DEPTH * 2];
+	int stackSize = 0;
+	int nodesVisited = 0;
+
+	if (m_nodes.empty() == true)
+	{
+		return(0);
+	}
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		FRUSTUM_RESULT result = frustum.ClassifyBox(node.bounds);
+
+		nodesVisited++;
+		if (result == FRUSTUM_OUTSIDE)
+		{
+			continue;
+		}
+
+		if (result == FRUSTUM_INSIDE)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				itemIDs.push_back(m_itemIDs[m_itemOrder[i]]);
+			}
+		}
+		else if (node.leftChild == -1)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				if (frustum.ClassifyBox(m_itemBoxes[m_itemOrder[i]]) != FRUSTUM_OUTSIDE)
+				{
+					itemIDs.push_back(m_itemIDs[m_itemOrder[i]]);
+				}
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.leftChild;
+			stack[stackSize++] = node.leftChild + 1;
+		}
+	}
+
+	return(nodesVisited);
+}
+
+/***********************************************************
+ *  RayCast()
+ *
+ *  This method is used for finding the nearest item box hit
+ *  by a ray. The nearer child is visited first, and nodes
+ *  that start past the closest hit so far are skipped.
+ ***********************************************************/
+bool BoundingVolumeHierarchy::RayCast(
+	const glm::vec3& origin,
+	const glm::vec3& direction,
+	float maxDistance,
+	int& hitItemID,
+	float& hitDistance) const
+{
+	int stack[MAX_TREE_DEPTH * 2];
+	int stackSize = 0;
+	glm::vec3 inverseDirection;
+	bool bHit = false;
+
+	if (m_nodes.empty() == true)
+	{
+		return(false);
+	}
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		inverseDirection[axis] = (direction[axis] != 0.0f) ? (1.0f / direction[axis]) : 1.0e30f;
+	}
+
+	hitDistance = maxDistance;
+	if (IntersectRayBox(origin, inverseDirection, hitDistance, m_nodes[0].bounds) > hitDistance)
+	{
+		return(false);
+	}
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+
+		if (node.leftChild == -1)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				int item = m_itemOrder[i];
+				float distance = IntersectRayBox(origin, inverseDirection, hitDistance, m_itemBoxes[item]);
+
+				if (distance <= hitDistance)
+				{
+					hitDistance = distance;
+					hitItemID = m_itemIDs[item];
+					bHit = true;
+				}
+			}
+			continue;
+		}
+
+		int nearChild = node.leftChild;
+		int farChild = node.leftChild + 1;
+		float nearDistance = IntersectRayBox(origin, inverseDirection, hitDistance, m_nodes[nearChild].bounds);
+		float farDistance = IntersectRayBox(origin, inverseDirection, hitDistance, m_nodes[farChild].bounds);
+
+		if (farDistance < nearDistance)
+		{
+			std::swap(nearChild, farChild);
+			std::swap(nearDistance, farDistance);
+		}
+		// the far child is pushed first so the near one is
+		// visited next
+		if (farDistance <= hitDistance)
+		{
+			stack[stackSize++] = farChild;
+		}
+		if (nearDistance <= hitDistance)
+		{
+			stack[stackSize++] = nearChild;
+		}
+	}
+
+	return(bHit);
+}
+
+/***********************************************************
+ *  QuerySphere()
+ *
+ *  This method is used for collecting the items whose boxes
+ *  overlap a sphere.
+ ***********************************************************/
+void BoundingVolumeHierarchy::QuerySphere(const BOUNDING_SPHERE& sphere, std::vector<int>& itemIDs) const
+{
+	int stack[MAX_TREE_DEPTH * 2];
+	int stackSize = 0;
+
+	if (m_nodes.empty() == true)
+	{
+		return;
+	}
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+
+		if (SphereOverlapsBox(sphere, node.bounds) == false)
+		{
+			continue;
+		}
+
+		if (node.leftChild == -1)
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				if (SphereOverlapsBox(sphere, m_itemBoxes[m_itemOrder[i]]) == true)
+				{
+					itemIDs.push_back(m_itemIDs[m_itemOrder[i]]);
+				}
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.leftChild;
+			stack[stackSize++] = node.leftChild + 1;
+		}
+	}
+}
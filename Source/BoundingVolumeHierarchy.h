@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.h
+// ============
+// bounding volume tree over the scene objects for culling and queries
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "BoundingVolumes.h"
+#include "WorkerPool.h"
+
+#include <vector>
+
+/***********************************************************
+ *  BoundingVolumeHierarchy
+ *
+ *  This class builds a binary tree of bounding boxes over a
+ *  set of object boxes. The splits are chosen with the
+ *  surface area heuristic over binned object centers. The
+ *  top of the tree is split on the calling thread until
+ *  there is enough work to hand out, then the subtrees are
+ *  built in parallel on the worker pool.
+ *
+ *  When objects move, Refit() updates the node boxes without
+ *  changing the tree shape. The returned cost ratio tells
+ *  the owner when the tree has degraded enough to rebuild.
+ *
+ *  Nodes are stored in one array with the two children of a
+ *  node next to each other and always after their parent.
+ ***********************************************************/
+class BoundingVolumeHierarchy
+{
+public:
+	// constructor
+	BoundingVolumeHierarchy(WorkerPool* pWorkerPool);
+	// destructor
+	~BoundingVolumeHierarchy();
+
+	// build the tree over the item boxes, the queries return
+	// the item ID stored at the same position as the box
+	void Build(const std::vector<BOUNDING_BOX>& itemBoxes, const std::vector<int>& itemIDs);
+	// update the node boxes after the item boxes changed, the
+	// boxes must be in the same order as they were built with,
+	// returns the tree cost compared to when it was built
+	float Refit(const std::vector<BOUNDING_BOX>& itemBoxes);
+	// remove every item
+	void Clear();
+
+	// number of items and nodes in the tree
+	int GetItemCount() const;
+	int GetNodeCount() const;
+
+	// add the IDs of the items that are at least partly inside
+	// the frustum, returns the number of nodes visited
+	int QueryFrustum(const ViewFrustum& frustum, std::vector<int>& itemIDs) const;
+	// find the nearest item box hit by a ray, false when the
+	// ray hits nothing closer than maxDistance
+	bool RayCast(
+		const glm::vec3& origin,
+		const glm::vec3& direction,
+		float maxDistance,
+		int& hitItemID,
+		float& hitDistance) const;
+	// add the IDs of the items whose boxes overlap a sphere
+	void QuerySphere(const BOUNDING_SPHERE& sphere, std::vector<int>& itemIDs) const;
+
+private:
+	// one tree node, a leaf when leftChild is -1, the right
+	// child always follows the left child
+	struct BVH_NODE
+	{
+		BOUNDING_BOX bounds;
+		int leftChild;
+		// range of m_itemOrder covered by the node subtree
+		int firstItem;
+		int itemCount;
+	};
+
+	// a subtree that is built on a worker thread
+	struct BVH_BUILD_TASK
+	{
+		int nodeIndex;
+		int firstItem;
+		int itemCount;
+		int treeDepth;
+		std::vector<BVH_NODE> nodes;
+	};
+
+	// build the top of the tree and collect the subtrees
+	void BuildTopLevel(int nodeIndex, int firstItem, int itemCount, int treeDepth, int taskDepth, std::vector<BVH_BUILD_TASK>& tasks);
+	// build a complete subtree into a node array
+	void BuildSubtree(std::vector<BVH_NODE>& nodes, int nodeIndex, int treeDepth);
+	// set the node bounds and item range
+	void InitializeNode(BVH_NODE& node, int firstItem, int itemCount) const;
+	// split the items of a node with the surface area
+	// heuristic, false when the node should stay a leaf
+	bool SplitNode(const BVH_NODE& node, int treeDepth, int& leftCount);
+	// surface area cost of the current tree
+	float ComputeTreeCost() const;
+
+	// pointer to the threads used to build the subtrees
+	WorkerPool* m_pWorkerPool;
+
+	std::vector<BVH_NODE> m_nodes;
+	// item boxes, centers and IDs in build order
+	std::vector<BOUNDING_BOX> m_itemBoxes;
+	std::vector<glm::vec3> m_itemCenters;
+	std::vector<int> m_itemIDs;
+	// build order positions sorted into the tree leaves
+	std::vector<int> m_itemOrder;
+	// surface area cost when the tree was built
+	float m_buildCost;
+};
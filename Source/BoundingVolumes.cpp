@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumes.cpp
+// ============
+// bounding boxes and spheres of the scene objects and the view frustum
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumes.h"
+
+#include <cmath>
+
+/***********************************************************
+ *  TransformBoundingBox()
+ *
+ *  This function is used for getting the world box that
+ *  encloses a local box after it is scaled, rotated and
+ *  moved by a model matrix. The extents are spread over the
+ *  world axes with the absolute rotation and scale values,
+ *  so this needs no corner loop.
+ ***********************************************************/
+BOUNDING_BOX TransformBoundingBox(const BOUNDING_BOX& localBox, const glm::mat4& model)
+{
+	BOUNDING_BOX worldBox;
+	glm::vec3 center = (localBox.minPoint + localBox.maxPoint) * 0.5f;
+	glm::vec3 extent = (localBox.maxPoint - localBox.minPoint) * 0.5f;
+	glm::vec4 worldCenter = model * glm::vec4(center, 1.0f);
+	glm::vec3 worldExtent;
+
+	for (int row = 0; row < 3; row++)
+	{
+		worldExtent[row] =
+			(std::abs(model[0][row]) * extent.x) +
+			(std::abs(model[1][row]) * extent.y) +
+			(std::abs(model[2][row]) * extent.z);
+	}
+
+	worldBox.minPoint = glm::vec3(worldCenter.x, worldCenter.y, worldCenter.z) - worldExtent;
+	worldBox.maxPoint = glm::vec3(worldCenter.x, worldCenter.y, worldCenter.z) + worldExtent;
+
+	return(worldBox);
+}
+
+/***********************************************************
+ *  GetBoundingSphere()
+ *
+ *  This function is used for getting the sphere that
+ *  encloses a box, centered on the box center.
+ ***********************************************************/
+BOUNDING_SPHERE GetBoundingSphere(const BOUNDING_BOX& box)
+{
+	glm::vec3 center = (box.minPoint + box.maxPoint) * 0.5f;
+
+	return(BOUNDING_SPHERE(center, glm::length(box.maxPoint - center)));
+}
+
+/***********************************************************
+ *  MergeBoundingBox()
+ *
+ *  This function is used for growing a box so it encloses
+ *  another box as well.
+ ***********************************************************/
+void MergeBoundingBox(BOUNDING_BOX& box, const BOUNDING_BOX& other)
+{
+	box.minPoint = glm::min(box.minPoint, other.minPoint);
+	box.maxPoint = glm::max(box.maxPoint, other.maxPoint);
+}
+
+/***********************************************************
+ *  ViewFrustum()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ViewFrustum::ViewFrustum()
+{
+	// an empty frustum rejects nothing
+	for (int i = 0; i < 6; i++)
+	{
+		m_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+/***********************************************************
+ *  SetFromMatrices()
+ *
+ *  This method is used for extracting the six frustum planes
+ *  from the rows of the combined projection and view matrix.
+ *  The planes are normalized so the sphere test can compare
+ *  the plane distance with the radius directly.
+ ***********************************************************/
+void ViewFrustum::SetFromMatrices(const glm::mat4& view, const glm::mat4& projection)
+{
+	glm::mat4 viewProjection = projection * view;
+	glm::vec4 rows[4];
+
+	for (int row = 0; row < 4; row++)
+	{
+		rows[row] = glm::vec4(
+			viewProjection[0][row],
+			viewProjection[1][row],
+			viewProjection[2][row],
+			viewProjection[3][row]);
+	}
+
+	// left, right, bottom, top, near and far
+	m_planes[0] = rows[3] + rows[0];
+	m_planes[1] = rows[3] - rows[0];
+	m_planes[2] = rows[3] + rows[1];
+	m_planes[3] = rows[3] - rows[1];
+	m_planes[4] = rows[3] + rows[2];
+	m_planes[5] = rows[3] - rows[2];
+
+	for (int i = 0; i < 6; i++)
+	{
+		float length = glm::length(glm::vec3(m_planes[i].x, m_planes[i].y, m_planes[i].z));
+
+		if (length > 0.0f)
+		{
+			m_planes[i] = m_planes[i] / length;
+		}
+	}
+}
+
+/***********************************************************
+ *  IntersectsSphere()
+ *
+ *  This method is used for testing whether a bounding sphere
+ *  is at least partly inside the frustum.
+ ***********************************************************/
+bool ViewFrustum::IntersectsSphere(const BOUNDING_SPHERE& sphere) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& plane = m_planes[i];
+		float distance = (plane.x * sphere.x) + (plane.y * sphere.y) + (plane.z * sphere.z) + plane.w;
+
+		if (distance < -sphere.w)
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ClassifyBox()
+ *
+ *  This method is used for testing a bounding box against
+ *  the frustum. For each plane the box corner furthest along
+ *  the plane normal decides whether the box is outside, and
+ *  the nearest corner whether it is fully inside.
+ ***********************************************************/
+FRUSTUM_RESULT ViewFrustum::ClassifyBox(const BOUNDING_BOX& box) const
+{
+	FRUSTUM_RESULT result = FRUSTUM_INSIDE;
+
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& plane = m_planes[i];
+		glm::vec3 farCorner(
+			(plane.x >= 0.0f) ? box.maxPoint.x : box.minPoint.x,
+			(plane.y >= 0.0f) ? box.maxPoint.y : box.minPoint.y,
+			(plane.z >= 0.0f) ? box.maxPoint.z : box.minPoint.z);
+		glm::vec3 nearCorner(
+			(plane.x >= 0.0f) ? box.minPoint.x : box.maxPoint.x,
+			(plane.y >= 0.0f) ? box.minPoint.y : box.maxPoint.y,
+			(plane.z >= 0.0f) ? box.minPoint.z : box.maxPoint.z);
+
+		if (((plane.x * farCorner.x) + (plane.y * farCorner.y) + (plane.z * farCorner.z) + plane.w) < 0.0f)
+		{
+			return(FRUSTUM_OUTSIDE);
+		}
+		if (((plane.x * nearCorner.x) + (plane.y * nearCorner.y) + (plane.z * nearCorner.z) + plane.w) < 0.0f)
+		{
+			result = FRUSTUM_INTERSECTS;
+		}
+	}
+
+	return(result);
+}
+
+/***********************************************************
+ *  GetPlane()
+ *
+ *  This method is used for getting one of the frustum
+ *  planes, to pass them to a shader.
+ ***********************************************************/
+const glm::vec4& ViewFrustum::GetPlane(int planeIndex) const
+{
+	return(m_planes[planeIndex]);
+}
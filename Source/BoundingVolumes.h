@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumes.h
+// ============
+// bounding boxes and spheres of the scene objects and the view frustum
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+// axis aligned bounding box
+struct BOUNDING_BOX
+{
+	glm::vec3 minPoint;
+	glm::vec3 maxPoint;
+};
+
+// bounding sphere, the center in xyz and the radius in w
+typedef glm::vec4 BOUNDING_SPHERE;
+
+// transform a local box by a model matrix into a world box
+BOUNDING_BOX TransformBoundingBox(const BOUNDING_BOX& localBox, const glm::mat4& model);
+// get the sphere that encloses a box
+BOUNDING_SPHERE GetBoundingSphere(const BOUNDING_BOX& box);
+// grow a box so that it also encloses another box
+void MergeBoundingBox(BOUNDING_BOX& box, const BOUNDING_BOX& other);
+
+// result of testing a volume against the view frustum
+enum FRUSTUM_RESULT
+{
+	FRUSTUM_OUTSIDE,
+	FRUSTUM_INTERSECTS,
+	FRUSTUM_INSIDE
+};
+
+/***********************************************************
+ *  ViewFrustum
+ *
+ *  This class holds the six planes of the view frustum that
+ *  are taken from the combined projection and view matrix,
+ *  with the plane normals pointing into the frustum, and
+ *  tests the bounding volumes of the scene objects against
+ *  them.
+ ***********************************************************/
+class ViewFrustum
+{
+public:
+	// constructor
+	ViewFrustum();
+
+	// extract the frustum planes from the camera matrices
+	void SetFromMatrices(const glm::mat4& view, const glm::mat4& projection);
+
+	// test a bounding sphere against the frustum
+	bool IntersectsSphere(const BOUNDING_SPHERE& sphere) const;
+	// test a bounding box against the frustum
+	FRUSTUM_RESULT ClassifyBox(const BOUNDING_BOX& box) const;
+	// get one of the planes, in the order left, right,
+	// bottom, top, near and far
+	const glm::vec4& GetPlane(int planeIndex) const;
+
+private:
+	// plane normals in xyz and the plane distance in w
+	glm::vec4 m_planes[6];
+};
@@ -0,0 +1,651 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculling.cpp
+// ============
+// test the scene objects against the view on the GPU and write the
+// indirect draw commands of the ones that are seen
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuCulling.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// storage buffer binding points used by the compute
+	// shaders, above the ones used by the scene shader
+	const GLuint CULL_INSTANCE_BINDING = 5;
+	const GLuint CULL_COMMAND_BINDING = 6;
+	const GLuint CULL_VISIBLE_BINDING = 7;
+	// texture unit of the depth pyramid, after the 16 scene
+	// texture slots
+	const GLuint DEPTH_PYRAMID_UNIT = 16;
+	// threads in one compute work group
+	const int CULL_GROUP_SIZE = 64;
+	const int PYRAMID_GROUP_SIZE = 8;
+
+	// tests one object per thread and appends the visible ones
+	// to the instance range of their command
+	const char* g_CullShaderSource = R"(
+#version 430 core
+layout(local_size_x = 64) in;
+
+struct CullInstance
+{
+	vec4 minPoint;
+	vec4 maxPoint;
+	uint commandIndex;
+	uint cellBit;
+	uint padding0;
+	uint padding1;
+};
+
+struct DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+layout(std430, binding = 5) readonly buffer CullInstances { CullInstance instances[]; };
+layout(std430, binding = 6) buffer CullCommands { DrawCommand commands[]; };
+layout(std430, binding = 7) writeonly buffer CullVisible { uint visibleIDs[]; };
+
+uniform vec4 frustumPlanes[6];
+uniform uint instanceCount;
+uniform uint visibleCells;
+uniform bool bUseDepthPyramid;
+uniform mat4 pyramidViewProjection;
+uniform vec2 pyramidSize;
+uniform int pyramidLevels;
+layout(binding = 16) uniform sampler2D depthPyramid;
+
+bool IsOutsideFrustum(vec3 minPoint, vec3 maxPoint)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		// the box corner farthest along the plane normal
+		vec3 corner = mix(minPoint, maxPoint, greaterThanEqual(frustumPlanes[i].xyz, vec3(0.0)));
+		if (dot(frustumPlanes[i].xyz, corner) + frustumPlanes[i].w < 0.0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool IsOccluded(vec3 minPoint, vec3 maxPoint)
+{
+	vec2 rectMin = vec2(1.0);
+	vec2 rectMax = vec2(-1.0);
+	float nearestDepth = 1.0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		vec3 corner = vec3(
+			((i & 1) != 0) ? maxPoint.x : minPoint.x,
+			((i & 2) != 0) ? maxPoint.y : minPoint.y,
+			((i & 4) != 0) ? maxPoint.z : minPoint.z);
+		vec4 clip = pyramidViewProjection * vec4(corner, 1.0);
+
+		// boxes reaching behind the camera are never hidden
+		if (clip.w <= 0.0)
+		{
+			return false;
+		}
+		vec3 ndc = clip.xyz / clip.w;
+		rectMin = min(rectMin, ndc.xy);
+		rectMax = max(rectMax, ndc.xy);
+		nearestDepth = min(nearestDepth, (ndc.z * 0.5) + 0.5);
+	}
+
+	rectMin = clamp((rectMin * 0.5) + 0.5, 0.0, 1.0);
+	rectMax = clamp((rectMax * 0.5) + 0.5, 0.0, 1.0);
+
+	// the level where the box covers at most three texels
+	// each way. The texels are found from the base level, as
+	// the level sizes are rounded down and scaling by them
+	// can miss the edge of the box, and the last texel of a
+	// level also holds the odd ones past it
+	vec2 pixelSize = (rectMax - rectMin) * pyramidSize;
+	int level = clamp(int(ceil(log2(max(max(pixelSize.x, pixelSize.y), 1.0)))), 0, pyramidLevels - 1);
+	ivec2 levelSize = textureSize(depthPyramid, level);
+	ivec2 baseMax = ivec2(pyramidSize) - 1;
+	ivec2 texelMin = min(clamp(ivec2(rectMin * pyramidSize), ivec2(0), baseMax) >> level, levelSize - 1);
+	ivec2 texelMax = min(clamp(ivec2(rectMax * pyramidSize), ivec2(0), baseMax) >> level, levelSize - 1);
+
+	float farthestDepth = 0.0;
+	for (int y = texelMin.y; y <= texelMax.y; y++)
+	{
+		for (int x = texelMin.x; x <= texelMax.x; x++)
+		{
+			farthestDepth = max(farthestDepth, texelFetch(depthPyramid, ivec2(x, y), level).r);
+		}
+	}
+
+	return nearestDepth > farthestDepth;
+}
+
+void main()
+{
+	uint instanceIndex = gl_GlobalInvocationID.x;
+	if (instanceIndex >= instanceCount)
+	{
+		return;
+	}
+
+	CullInstance instance = instances[instanceIndex];
+	if ((instance.cellBit != 0u) && ((instance.cellBit & visibleCells) == 0u))
+	{
+		return;
+	}
+	if (IsOutsideFrustum(instance.minPoint.xyz, instance.maxPoint.xyz))
+	{
+		return;
+	}
+	if (bUseDepthPyramid && IsOccluded(instance.minPoint.xyz, instance.maxPoint.xyz))
+	{
+		return;
+	}
+
+	uint slot = atomicAdd(commands[instance.commandIndex].instanceCount, 1u);
+	visibleIDs[commands[instance.commandIndex].baseInstance + slot] = instanceIndex;
+}
+)";
+
+	// copies the depth buffer into the first pyramid level, or
+	// keeps the farthest depth of each block of the level above
+	const char* g_PyramidShaderSource = R"(
+#version 430 core
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 16) uniform sampler2D sourceDepth;
+layout(r32f, binding = 0) uniform writeonly image2D targetLevel;
+uniform int sourceLevel;
+uniform bool bCopyLevel;
+
+void main()
+{
+	ivec2 target = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 targetSize = imageSize(targetLevel);
+	if (any(greaterThanEqual(target, targetSize)))
+	{
+		return;
+	}
+
+	if (bCopyLevel)
+	{
+		imageStore(targetLevel, target, vec4(texelFetch(sourceDepth, target, 0).r));
+		return;
+	}
+
+	// the last row and column also cover the odd texel left
+	// over when the level above has an odd size
+	ivec2 sourceSize = textureSize(sourceDepth, sourceLevel);
+	ivec2 first = target * 2;
+	ivec2 last = min(first + 1, sourceSize - 1);
+	if (target.x == targetSize.x - 1)
+	{
+		last.x = sourceSize.x - 1;
+	}
+	if (target.y == targetSize.y - 1)
+	{
+		last.y = sourceSize.y - 1;
+	}
+
+	float farthestDepth = 0.0;
+	for (int y = first.y; y <= last.y; y++)
+	{
+		for (int x = first.x; x <= last.x; x++)
+		{
+			farthestDepth = max(farthestDepth, texelFetch(sourceDepth, ivec2(x, y), sourceLevel).r);
+		}
+	}
+	imageStore(targetLevel, target, vec4(farthestDepth));
+}
+)";
+}
+
+/***********************************************************
+ *  GpuCullingPass()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuCullingPass::GpuCullingPass()
+{
+	m_cullProgram = 0;
+	m_pyramidProgram = 0;
+	m_frustumPlanesLocation = -1;
+	m_instanceCountLocation = -1;
+	m_visibleCellsLocation = -1;
+	m_useDepthPyramidLocation = -1;
+	m_pyramidViewProjectionLocation = -1;
+	m_pyramidSizeLocation = -1;
+	m_pyramidLevelsLocation = -1;
+	m_sourceLevelLocation = -1;
+	m_copyLevelLocation = -1;
+	m_instanceBuffer = 0;
+	m_commandBuffer = 0;
+	m_commandTemplateBuffer = 0;
+	m_visibleIDBuffer = 0;
+	m_instanceCount = 0;
+	m_commandCount = 0;
+	m_depthTexture = 0;
+	m_depthPyramid = 0;
+	m_pyramidWidth = 0;
+	m_pyramidHeight = 0;
+	m_pyramidLevels = 0;
+	m_pyramidViewProjection = glm::mat4(1.0f);
+	m_bPyramidReady = false;
+	m_bOcclusionCulling = false;
+}
+
+/***********************************************************
+ *  ~GpuCullingPass()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuCullingPass::~GpuCullingPass()
+{
+	GLuint buffers[4] = { m_instanceBuffer, m_commandBuffer, m_commandTemplateBuffer, m_visibleIDBuffer };
+
+	DestroyDepthPyramid();
+	if (m_instanceBuffer != 0)
+	{
+		glDeleteBuffers(4, buffers);
+	}
+	if (m_cullProgram != 0)
+	{
+		glDeleteProgram(m_cullProgram);
+		m_cullProgram = 0;
+	}
+	if (m_pyramidProgram != 0)
+	{
+		glDeleteProgram(m_pyramidProgram);
+		m_pyramidProgram = 0;
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for compiling the culling and depth
+ *  pyramid compute shaders and creating the buffers. It
+ *  returns false when the context has no compute shaders.
+ ***********************************************************/
+bool GpuCullingPass::Initialize()
+{
+	if (!GLEW_VERSION_4_3)
+	{
+		return(false);
+	}
+
+	m_cullProgram = CreateProgram(g_CullShaderSource, "culling");
+	m_pyramidProgram = CreateProgram(g_PyramidShaderSource, "depth pyramid");
+	if ((m_cullProgram == 0) || (m_pyramidProgram == 0))
+	{
+		return(false);
+	}
+
+	m_frustumPlanesLocation = glGetUniformLocation(m_cullProgram, "frustumPlanes");
+	m_instanceCountLocation = glGetUniformLocation(m_cullProgram, "instanceCount");
+	m_visibleCellsLocation = glGetUniformLocation(m_cullProgram, "visibleCells");
+	m_useDepthPyramidLocation = glGetUniformLocation(m_cullProgram, "bUseDepthPyramid");
+	m_pyramidViewProjectionLocation = glGetUniformLocation(m_cullProgram, "pyramidViewProjection");
+	m_pyramidSizeLocation = glGetUniformLocation(m_cullProgram, "pyramidSize");
+	m_pyramidLevelsLocation = glGetUniformLocation(m_cullProgram, "pyramidLevels");
+	m_sourceLevelLocation = glGetUniformLocation(m_pyramidProgram, "sourceLevel");
+	m_copyLevelLocation = glGetUniformLocation(m_pyramidProgram, "bCopyLevel");
+
+	glGenBuffers(1, &m_instanceBuffer);
+	glGenBuffers(1, &m_commandBuffer);
+	glGenBuffers(1, &m_commandTemplateBuffer);
+	glGenBuffers(1, &m_visibleIDBuffer);
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateProgram()
+ *
+ *  This method is used for compiling and linking a compute
+ *  shader program. The log is printed and 0 is returned
+ *  when either step fails.
+ ***********************************************************/
+GLuint GpuCullingPass::CreateProgram(const char* source, const char* programName) const
+{
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	GLuint program = 0;
+	GLint success = 0;
+	GLchar infoLog[1024];
+
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::GPU_CULLING: " << programName << " compute shader did not compile\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(0);
+	}
+
+	program = glCreateProgram();
+	glAttachShader(program, shader);
+	glLinkProgram(program);
+	glDeleteShader(shader);
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(program, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::GPU_CULLING: " << programName << " compute program did not link\n" << infoLog << std::endl;
+		glDeleteProgram(program);
+		return(0);
+	}
+
+	return(program);
+}
+
+/***********************************************************
+ *  SetInstances()
+ *
+ *  This method is used for sending the objects to test and
+ *  the commands that draw them. The visible ID buffer gets
+ *  room for every object, each command range is as large as
+ *  the number of objects it can draw.
+ ***********************************************************/
+void GpuCullingPass::SetInstances(
+	const std::vector<GPU_CULL_INSTANCE>& instances,
+	const std::vector<DRAW_ELEMENTS_COMMAND>& commands)
+{
+	m_instanceCount = (int)instances.size();
+	m_commandCount = (int)commands.size();
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, instances.size() * sizeof(GPU_CULL_INSTANCE), instances.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visibleIDBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, instances.size() * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(DRAW_ELEMENTS_COMMAND), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandTemplateBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(DRAW_ELEMENTS_COMMAND), commands.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  UpdateInstance()
+ *
+ *  This method is used for sending the new bounds of an
+ *  object that moved.
+ ***********************************************************/
+void GpuCullingPass::UpdateInstance(int instanceIndex, const GPU_CULL_INSTANCE& instance)
+{
+	if ((instanceIndex < 0) || (instanceIndex >= m_instanceCount))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceBuffer);
+	glBufferSubData(
+		GL_SHADER_STORAGE_BUFFER,
+		instanceIndex * sizeof(GPU_CULL_INSTANCE),
+		sizeof(GPU_CULL_INSTANCE),
+		&instance);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  SetOcclusionCulling()
+ *
+ *  This method is used for switching the depth test against
+ *  the previous frame on or off. The test only starts once a
+ *  depth pyramid has been built.
+ ***********************************************************/
+void GpuCullingPass::SetOcclusionCulling(bool bEnabled)
+{
+	if ((bEnabled == true) && (m_bOcclusionCulling == false))
+	{
+		m_bPyramidReady = false;
+	}
+	m_bOcclusionCulling = bEnabled;
+}
+
+/***********************************************************
+ *  IsOcclusionCulling()
+ *
+ *  This method is used for checking whether the objects are
+ *  tested against the depth of the previous frame.
+ ***********************************************************/
+bool GpuCullingPass::IsOcclusionCulling() const
+{
+	return(m_bOcclusionCulling);
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for running the culling compute
+ *  shader. The commands are reset to no instances, then one
+ *  thread per object appends the visible objects. A barrier
+ *  makes the results ready for the indirect draws and for
+ *  the draw ID attribute. The scene shader program is in
+ *  use again when this returns.
+ ***********************************************************/
+void GpuCullingPass::Cull(const ViewFrustum& frustum, uint32_t visibleCells)
+{
+	GLint sceneProgram = 0;
+	glm::vec4 planes[6];
+
+	if ((m_cullProgram == 0) || (m_instanceCount == 0))
+	{
+		return;
+	}
+
+	for (int i = 0; i < 6; i++)
+	{
+		planes[i] = frustum.GetPlane(i);
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, m_commandTemplateBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBuffer);
+	glCopyBufferSubData(
+		GL_COPY_READ_BUFFER,
+		GL_COPY_WRITE_BUFFER,
+		0,
+		0,
+		m_commandCount * sizeof(DRAW_ELEMENTS_COMMAND));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &sceneProgram);
+	glUseProgram(m_cullProgram);
+	glUniform4fv(m_frustumPlanesLocation, 6, glm::value_ptr(planes[0]));
+	glUniform1ui(m_instanceCountLocation, (GLuint)m_instanceCount);
+	glUniform1ui(m_visibleCellsLocation, visibleCells);
+	glUniform1i(m_useDepthPyramidLocation, (m_bOcclusionCulling && m_bPyramidReady) ? 1 : 0);
+	if ((m_bOcclusionCulling == true) && (m_bPyramidReady == true))
+	{
+		glUniformMatrix4fv(m_pyramidViewProjectionLocation, 1, GL_FALSE, glm::value_ptr(m_pyramidViewProjection));
+		glUniform2f(m_pyramidSizeLocation, (float)m_pyramidWidth, (float)m_pyramidHeight);
+		glUniform1i(m_pyramidLevelsLocation, m_pyramidLevels);
+		glActiveTexture(GL_TEXTURE0 + DEPTH_PYRAMID_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_depthPyramid);
+		glActiveTexture(GL_TEXTURE0);
+	}
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_INSTANCE_BINDING, m_instanceBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_COMMAND_BINDING, m_commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_VISIBLE_BINDING, m_visibleIDBuffer);
+	glDispatchCompute((m_instanceCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+	glUseProgram((GLuint)sceneProgram);
+}
+
+/***********************************************************
+ *  BuildDepthPyramid()
+ *
+ *  This method is used for copying the depth buffer of the
+ *  frame that was just drawn, and reducing it into a mip
+ *  chain where every texel holds the farthest depth of the
+ *  area it covers. It is only done while the occlusion test
+ *  is switched on.
+ ***********************************************************/
+void GpuCullingPass::BuildDepthPyramid(const glm::mat4& viewProjection, const glm::vec2& viewportSize)
+{
+	GLint sceneProgram = 0;
+	int width = (int)viewportSize.x;
+	int height = (int)viewportSize.y;
+
+	if ((m_pyramidProgram == 0) || (m_bOcclusionCulling == false) || (width <= 0) || (height <= 0))
+	{
+		return;
+	}
+	if ((width != m_pyramidWidth) || (height != m_pyramidHeight))
+	{
+		CreateDepthPyramid(width, height);
+	}
+
+	// the depth textures are only bound on their own unit, so
+	// the scene textures on the lower units stay bound
+	glActiveTexture(GL_TEXTURE0 + DEPTH_PYRAMID_UNIT);
+	// the copy converts from the format of the window depth buffer
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &sceneProgram);
+	glUseProgram(m_pyramidProgram);
+	for (int level = 0; level < m_pyramidLevels; level++)
+	{
+		int levelWidth = std::max(width >> level, 1);
+		int levelHeight = std::max(height >> level, 1);
+
+		if (level == 0)
+		{
+			glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+			glUniform1i(m_copyLevelLocation, 1);
+			glUniform1i(m_sourceLevelLocation, 0);
+		}
+		else
+		{
+			glBindTexture(GL_TEXTURE_2D, m_depthPyramid);
+			glUniform1i(m_copyLevelLocation, 0);
+			glUniform1i(m_sourceLevelLocation, level - 1);
+		}
+		glBindImageTexture(0, m_depthPyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glDispatchCompute(
+			(levelWidth + PYRAMID_GROUP_SIZE - 1) / PYRAMID_GROUP_SIZE,
+			(levelHeight + PYRAMID_GROUP_SIZE - 1) / PYRAMID_GROUP_SIZE,
+			1);
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glUseProgram((GLuint)sceneProgram);
+
+	m_pyramidViewProjection = viewProjection;
+	m_bPyramidReady = true;
+}
+
+/***********************************************************
+ *  CreateDepthPyramid()
+ *
+ *  This method is used for creating the depth copy texture
+ *  and the pyramid texture with its full mip chain.
+ ***********************************************************/
+void GpuCullingPass::CreateDepthPyramid(int width, int height)
+{
+	int largestSide = std::max(width, height);
+
+	DestroyDepthPyramid();
+	m_pyramidWidth = width;
+	m_pyramidHeight = height;
+	m_pyramidLevels = 1;
+	while ((largestSide >> m_pyramidLevels) > 0)
+	{
+		m_pyramidLevels++;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + DEPTH_PYRAMID_UNIT);
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+	glGenTextures(1, &m_depthPyramid);
+	glBindTexture(GL_TEXTURE_2D, m_depthPyramid);
+	glTexStorage2D(GL_TEXTURE_2D, m_pyramidLevels, GL_R32F, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	m_bPyramidReady = false;
+}
+
+/***********************************************************
+ *  DestroyDepthPyramid()
+ *
+ *  This method is used for deleting the depth textures.
+ ***********************************************************/
+void GpuCullingPass::DestroyDepthPyramid()
+{
+	if (m_depthTexture != 0)
+	{
+		glDeleteTextures(1, &m_depthTexture);
+		m_depthTexture = 0;
+	}
+	if (m_depthPyramid != 0)
+	{
+		glDeleteTextures(1, &m_depthPyramid);
+		m_depthPyramid = 0;
+	}
+	m_pyramidWidth = 0;
+	m_pyramidHeight = 0;
+	m_pyramidLevels = 0;
+	m_bPyramidReady = false;
+}
+
+/***********************************************************
+ *  GetCommandBuffer()
+ *
+ *  This method is used for getting the buffer of indirect
+ *  draw commands written by the last pass.
+ ***********************************************************/
+GLuint GpuCullingPass::GetCommandBuffer() const
+{
+	return(m_commandBuffer);
+}
+
+/***********************************************************
+ *  GetVisibleIDBuffer()
+ *
+ *  This method is used for getting the buffer of visible
+ *  object indexes written by the last pass.
+ ***********************************************************/
+GLuint GpuCullingPass::GetVisibleIDBuffer() const
+{
+	return(m_visibleIDBuffer);
+}
+
+/***********************************************************
+ *  GetCommandCount()
+ *
+ *  This method is used for getting the number of indirect
+ *  draw commands.
+ ***********************************************************/
+int GpuCullingPass::GetCommandCount() const
+{
+	return(m_commandCount);
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculling.h
+// ============
+// test the scene objects against the view on the GPU and write the
+// indirect draw commands of the ones that are seen
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "BoundingVolumes.h"
+#include "BasicMeshBuffer.h"
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+
+// one object tested by the culling pass, laid out for a std430
+// storage block
+struct GPU_CULL_INSTANCE
+{
+	glm::vec4 minPoint;
+	glm::vec4 maxPoint;
+	// indirect command the object is drawn by when it is seen
+	GLuint commandIndex;
+	// bit of the portal cell holding the object, 0 for none
+	GLuint cellBit;
+	GLuint padding[2];
+};
+
+/***********************************************************
+ *  GpuCullingPass
+ *
+ *  This class runs a compute shader over every scene object.
+ *  Each object is tested against the view frustum planes, the
+ *  visible portal cells and, when switched on, the depth of
+ *  the previous frame. The objects that pass are appended to
+ *  the instance range of their indirect command, so the
+ *  visible ID buffer and the command instance counts are
+ *  written without the CPU reading any of them back.
+ *
+ *  Each indirect command draws one mesh as instances, its
+ *  base instance is the first entry of its range in the
+ *  visible ID buffer. Only core OpenGL 4.3 is used, so the
+ *  pass also runs on software renderers.
+ ***********************************************************/
+class GpuCullingPass
+{
+public:
+	// constructor
+	GpuCullingPass();
+	// destructor
+	~GpuCullingPass();
+
+	// compile the compute shaders, false when compute shaders
+	// are not supported or do not compile
+	bool Initialize();
+
+	// set the objects and the commands that draw them, the
+	// commands hold the base instance of their ranges and an
+	// instance count of 0
+	void SetInstances(
+		const std::vector<GPU_CULL_INSTANCE>& instances,
+		const std::vector<DRAW_ELEMENTS_COMMAND>& commands);
+	// change one object after it moved
+	void UpdateInstance(int instanceIndex, const GPU_CULL_INSTANCE& instance);
+
+	// test the objects against the depth of the previous frame
+	void SetOcclusionCulling(bool bEnabled);
+	bool IsOcclusionCulling() const;
+
+	// write the commands and visible IDs for the frame
+	void Cull(const ViewFrustum& frustum, uint32_t visibleCells);
+	// keep the depth of the frame that was just drawn, to test
+	// the objects of the next frame against
+	void BuildDepthPyramid(const glm::mat4& viewProjection, const glm::vec2& viewportSize);
+
+	// buffers written by Cull()
+	GLuint GetCommandBuffer() const;
+	GLuint GetVisibleIDBuffer() const;
+	int GetCommandCount() const;
+
+private:
+	// compile and link a compute shader program
+	GLuint CreateProgram(const char* source, const char* programName) const;
+	// create the depth copy and pyramid textures
+	void CreateDepthPyramid(int width, int height);
+	// delete the depth copy and pyramid textures
+	void DestroyDepthPyramid();
+
+	GLuint m_cullProgram;
+	GLuint m_pyramidProgram;
+	// uniform locations of the culling program
+	GLint m_frustumPlanesLocation;
+	GLint m_instanceCountLocation;
+	GLint m_visibleCellsLocation;
+	GLint m_useDepthPyramidLocation;
+	GLint m_pyramidViewProjectionLocation;
+	GLint m_pyramidSizeLocation;
+	GLint m_pyramidLevelsLocation;
+	// uniform locations of the pyramid program
+	GLint m_sourceLevelLocation;
+	GLint m_copyLevelLocation;
+
+	GLuint m_instanceBuffer;
+	GLuint m_commandBuffer;
+	// commands with no instances, copied over the command
+	// buffer before every pass
+	GLuint m_commandTemplateBuffer;
+	GLuint m_visibleIDBuffer;
+	int m_instanceCount;
+	int m_commandCount;
+
+	// depth buffer copy and its mip chain of farthest depths
+	GLuint m_depthTexture;
+	GLuint m_depthPyramid;
+	int m_pyramidWidth;
+	int m_pyramidHeight;
+	int m_pyramidLevels;
+	// camera of the frame the pyramid was built from
+	glm::mat4 m_pyramidViewProjection;
+	bool m_bPyramidReady;
+	bool m_bOcclusionCulling;
+};
@@ -0,0 +1,510 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.cpp
+// ============
+// assign the scene lights to a 3D grid of view frustum clusters
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// shader storage binding points of the cluster blocks
+	const GLuint CLUSTER_BUFFER_BINDING = 2;
+	const GLuint CLUSTER_INDEX_BINDING = 3;
+}
+
+/***********************************************************
+ *  LightClusterGrid()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightClusterGrid::LightClusterGrid(ShaderUniforms* pShaderUniforms, WorkerPool* pWorkerPool)
+{
+	m_pShaderUniforms = pShaderUniforms;
+	m_pWorkerPool = pWorkerPool;
+	m_boundsProjection = glm::mat4(1.0f);
+	m_bBoundsValid = false;
+	m_nearPlane = 0.1f;
+	m_farPlane = 100.0f;
+	m_depthScale = 0.0f;
+	m_depthBias = 0.0f;
+	m_clusterBuffer = 0;
+	m_indexBuffer = 0;
+	m_indexBufferCapacity = 0;
+	m_bSupported = false;
+	m_bEnabled = false;
+	memset(&m_frameStats, 0, sizeof(m_frameStats));
+
+	m_clusterBounds.resize(CLUSTER_COUNT);
+	m_columnBounds.resize(CLUSTER_GRID_Z * CLUSTER_GRID_X);
+	m_rowBounds.resize(CLUSTER_GRID_Z * CLUSTER_GRID_Y);
+	m_clusterRanges.resize(CLUSTER_COUNT);
+}
+
+/***********************************************************
+ *  ~LightClusterGrid()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightClusterGrid::~LightClusterGrid()
+{
+	m_pShaderUniforms = NULL;
+	m_pWorkerPool = NULL;
+	if (m_clusterBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_clusterBuffer);
+		m_clusterBuffer = 0;
+	}
+	if (m_indexBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the cluster buffers.
+ *  The clustered path needs the lights in the light buffer,
+ *  the two cluster storage blocks and the cluster uniforms
+ *  in the shader, otherwise the full light loop is kept.
+ ***********************************************************/
+bool LightClusterGrid::Initialize(bool bUsingLightBuffer)
+{
+	m_bSupported = false;
+	if ((NULL == m_pShaderUniforms) ||
+		(bUsingLightBuffer == false) ||
+		(m_pShaderUniforms->HasUniform(UNIFORM_USE_CLUSTERED_LIGHTS) == false) ||
+		(m_pShaderUniforms->BindStorageBlock("ClusterBuffer", CLUSTER_BUFFER_BINDING) == false) ||
+		(m_pShaderUniforms->BindStorageBlock("ClusterLightIndices", CLUSTER_INDEX_BINDING) == false))
+	{
+		std::cout << "INFO: Clustered lighting is not available, the shader has no cluster blocks" << std::endl;
+		return(false);
+	}
+
+	if (m_clusterBuffer == 0)
+	{
+		m_indexBufferCapacity = 4096;
+
+		glGenBuffers(1, &m_clusterBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_clusterBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, CLUSTER_COUNT * sizeof(CLUSTER_RANGE), NULL, GL_STREAM_DRAW);
+		glGenBuffers(1, &m_indexBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_indexBufferCapacity * sizeof(uint32_t), NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_BUFFER_BINDING, m_clusterBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_INDEX_BINDING, m_indexBuffer);
+	}
+	m_bSupported = true;
+
+	m_pShaderUniforms->setVec3Value(
+		UNIFORM_CLUSTER_GRID_SIZE,
+		(float)CLUSTER_GRID_X, (float)CLUSTER_GRID_Y, (float)CLUSTER_GRID_Z);
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_CLUSTERED_LIGHTS, m_bEnabled);
+
+	std::cout << "INFO: Clustered lighting available, " << CLUSTER_GRID_X << "x" << CLUSTER_GRID_Y
+		<< "x" << CLUSTER_GRID_Z << " clusters built on " << m_pWorkerPool->GetThreadCount()
+		<< " threads" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the shader can
+ *  read the cluster light lists.
+ ***********************************************************/
+bool LightClusterGrid::IsSupported() const
+{
+	return(m_bSupported);
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for switching the fragment shading
+ *  between the cluster light lists and the loop over every
+ *  light. It has no effect when clustering is not supported.
+ ***********************************************************/
+void LightClusterGrid::SetEnabled(bool bEnabled)
+{
+	if ((m_bSupported == false) || (m_bEnabled == bEnabled))
+	{
+		return;
+	}
+
+	m_bEnabled = bEnabled;
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_CLUSTERED_LIGHTS, m_bEnabled);
+	if (m_bEnabled == false)
+	{
+		memset(&m_frameStats, 0, sizeof(m_frameStats));
+	}
+}
+
+/***********************************************************
+ *  IsEnabled()
+ *
+ *  This method is used for checking whether the fragment
+ *  shading uses the cluster light lists.
+ ***********************************************************/
+bool LightClusterGrid::IsEnabled() const
+{
+	return(m_bEnabled);
+}
+
+/***********************************************************
+ *  GetFrameStats()
+ *
+ *  This method is used for getting the counts from the last
+ *  cluster build.
+ ***********************************************************/
+const LIGHT_CLUSTER_STATS& LightClusterGrid::GetFrameStats() const
+{
+	return(m_frameStats);
+}
+
+/***********************************************************
+ *  ComputeClusterBounds()
+ *
+ *  This method is used for computing the view space box of
+ *  every cluster. The screen is split evenly into tiles and
+ *  the depth between the near and far planes is split into
+ *  exponentially spaced slices, so the clusters keep a
+ *  similar shape at every distance. The bounds only change
+ *  with the projection, so they are kept between frames.
+ ***********************************************************/
+void LightClusterGrid::ComputeClusterBounds(const glm::mat4& projection)
+{
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	// the planes of a perspective projection
+	m_nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+	m_farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+	m_depthScale = (float)CLUSTER_GRID_Z / std::log(m_farPlane / m_nearPlane);
+	m_depthBias = m_depthScale * std::log(m_nearPlane);
+
+	for (int z = 0; z < CLUSTER_GRID_Z; z++)
+	{
+		float sliceNear = m_nearPlane * std::pow(m_farPlane / m_nearPlane, (float)z / CLUSTER_GRID_Z);
+		float sliceFar = m_nearPlane * std::pow(m_farPlane / m_nearPlane, (float)(z + 1) / CLUSTER_GRID_Z);
+
+		for (int y = 0; y < CLUSTER_GRID_Y; y++)
+		{
+			for (int x = 0; x < CLUSTER_GRID_X; x++)
+			{
+				CLUSTER_BOUNDS& bounds = m_clusterBounds[x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z)];
+
+				bounds.minPoint = glm::vec3(1.0e30f);
+				bounds.maxPoint = glm::vec3(-1.0e30f);
+				for (int corner = 0; corner < 4; corner++)
+				{
+					float ndcX = -1.0f + (2.0f * (x + (corner & 1))) / CLUSTER_GRID_X;
+					float ndcY = -1.0f + (2.0f * (y + (corner >> 1))) / CLUSTER_GRID_Y;
+					glm::vec4 nearPoint = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+					glm::vec3 ray = glm::vec3(nearPoint.x, nearPoint.y, nearPoint.z) / nearPoint.w;
+
+					// move along the corner ray to both slice depths
+					glm::vec3 cornerNear = ray * (sliceNear / -ray.z);
+					glm::vec3 cornerFar = ray * (sliceFar / -ray.z);
+					bounds.minPoint = glm::min(bounds.minPoint, glm::min(cornerNear, cornerFar));
+					bounds.maxPoint = glm::max(bounds.maxPoint, glm::max(cornerNear, cornerFar));
+				}
+			}
+		}
+
+		// the union of the columns and rows is used to narrow
+		// down the clusters a light can reach in this slice
+		for (int x = 0; x < CLUSTER_GRID_X; x++)
+		{
+			CLUSTER_BOUNDS& column = m_columnBounds[z * CLUSTER_GRID_X + x];
+			column = m_clusterBounds[x + CLUSTER_GRID_X * CLUSTER_GRID_Y * z];
+			for (int y = 1; y < CLUSTER_GRID_Y; y++)
+			{
+				const CLUSTER_BOUNDS& bounds = m_clusterBounds[x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z)];
+				column.minPoint = glm::min(column.minPoint, bounds.minPoint);
+				column.maxPoint = glm::max(column.maxPoint, bounds.maxPoint);
+			}
+		}
+		for (int y = 0; y < CLUSTER_GRID_Y; y++)
+		{
+			CLUSTER_BOUNDS& row = m_rowBounds[z * CLUSTER_GRID_Y + y];
+			row = m_clusterBounds[CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z)];
+			for (int x = 1; x < CLUSTER_GRID_X; x++)
+			{
+				const CLUSTER_BOUNDS& bounds = m_clusterBounds[x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z)];
+				row.minPoint = glm::min(row.minPoint, bounds.minPoint);
+				row.maxPoint = glm::max(row.maxPoint, bounds.maxPoint);
+			}
+		}
+	}
+
+	m_boundsProjection = projection;
+	m_bBoundsValid = true;
+}
+
+/***********************************************************
+ *  FindDepthSlice()
+ *
+ *  This method is used for getting the depth slice that
+ *  holds a positive view space depth. This is the same
+ *  calculation the fragment shader does with clusterParams.
+ ***********************************************************/
+int LightClusterGrid::FindDepthSlice(float viewDepth) const
+{
+	int slice = 0;
+
+	if (viewDepth <= m_nearPlane)
+	{
+		return(0);
+	}
+	slice = (int)std::floor((std::log(viewDepth) * m_depthScale) - m_depthBias);
+
+	return(std::min(std::max(slice, 0), CLUSTER_GRID_Z - 1));
+}
+
+/***********************************************************
+ *  SphereIntersectsBounds()
+ *
+ *  This method is used for testing whether a view space
+ *  light sphere reaches into a cluster box.
+ ***********************************************************/
+bool LightClusterGrid::SphereIntersectsBounds(const glm::vec4& sphere, const CLUSTER_BOUNDS& bounds)
+{
+	glm::vec3 center = glm::vec3(sphere.x, sphere.y, sphere.z);
+	glm::vec3 closest = glm::clamp(center, bounds.minPoint, bounds.maxPoint);
+	glm::vec3 offset = closest - center;
+
+	return(glm::dot(offset, offset) <= (sphere.w * sphere.w));
+}
+
+/***********************************************************
+ *  BuildClusters()
+ *
+ *  This method is used for building the light list of every
+ *  cluster for the frame. The lights are moved into view
+ *  space and sorted into the depth slices they reach, then
+ *  the slices build their lists in parallel. The slice lists
+ *  are merged into one index list and uploaded.
+ ***********************************************************/
+void LightClusterGrid::BuildClusters(
+	const std::vector<glm::vec4>& lightSpheres,
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec2& viewportSize)
+{
+	std::chrono::high_resolution_clock::time_point startTime;
+	int lightCount = (int)lightSpheres.size();
+	uint32_t indexCount = 0;
+
+	if ((m_bSupported == false) || (m_bEnabled == false))
+	{
+		return;
+	}
+	startTime = std::chrono::high_resolution_clock::now();
+
+	if ((m_bBoundsValid == false) ||
+		(memcmp(&m_boundsProjection, &projection, sizeof(glm::mat4)) != 0))
+	{
+		ComputeClusterBounds(projection);
+	}
+
+	// move the lights into view space and find the depth
+	// slices each light reaches, lights outside the depth
+	// range get an empty slice range
+	m_viewSpheres.resize(lightCount);
+	m_firstSlice.resize(lightCount);
+	m_lastSlice.resize(lightCount);
+	m_frameStats.visibleLights = 0;
+	for (int i = 0; i < lightCount; i++)
+	{
+		const glm::vec4& sphere = lightSpheres[i];
+		glm::vec4 center = view * glm::vec4(sphere.x, sphere.y, sphere.z, 1.0f);
+		float depth = -center.z;
+
+		m_viewSpheres[i] = glm::vec4(center.x, center.y, center.z, sphere.w);
+		if (((depth + sphere.w) < m_nearPlane) || ((depth - sphere.w) > m_farPlane))
+		{
+			m_firstSlice[i] = 1;
+			m_lastSlice[i] = 0;
+			continue;
+		}
+		m_firstSlice[i] = FindDepthSlice(depth - sphere.w);
+		m_lastSlice[i] = FindDepthSlice(depth + sphere.w);
+	}
+
+	m_pWorkerPool->ParallelFor(CLUSTER_GRID_Z, 1, [this](int begin, int end)
+		{
+			for (int slice = begin; slice < end; slice++)
+			{
+				BuildDepthSlice(slice);
+			}
+		});
+
+	// merge the slice lists, the cluster offsets were built
+	// relative to the start of their slice list
+	m_lightIndices.clear();
+	m_frameStats.occupiedClusters = 0;
+	for (int z = 0; z < CLUSTER_GRID_Z; z++)
+	{
+		const int firstCluster = z * CLUSTER_GRID_X * CLUSTER_GRID_Y;
+
+		for (int i = 0; i < CLUSTER_GRID_X * CLUSTER_GRID_Y; i++)
+		{
+			m_clusterRanges[firstCluster + i].offset += indexCount;
+			if (m_clusterRanges[firstCluster + i].count > 0)
+			{
+				m_frameStats.occupiedClusters++;
+			}
+		}
+		m_lightIndices.insert(m_lightIndices.end(), m_sliceIndices[z].begin(), m_sliceIndices[z].end());
+		indexCount = (uint32_t)m_lightIndices.size();
+	}
+
+	for (int i = 0; i < lightCount; i++)
+	{
+		if (m_firstSlice[i] <= m_lastSlice[i])
+		{
+			m_frameStats.visibleLights++;
+		}
+	}
+	m_frameStats.lightReferences = (int)m_lightIndices.size();
+
+	UploadClusters();
+
+	m_pShaderUniforms->setVec4Value(
+		UNIFORM_CLUSTER_PARAMS,
+		glm::vec4(
+			m_depthScale,
+			m_depthBias,
+			viewportSize.x / CLUSTER_GRID_X,
+			viewportSize.y / CLUSTER_GRID_Y));
+
+	m_frameStats.buildMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+/***********************************************************
+ *  BuildDepthSlice()
+ *
+ *  This method is used for building the light lists of the
+ *  clusters in one depth slice. Each light reaching the
+ *  slice is first tested against the slice columns and rows
+ *  so only the clusters where they cross are tested. This
+ *  runs on the worker threads and only writes to the data
+ *  of its own slice.
+ ***********************************************************/
+void LightClusterGrid::BuildDepthSlice(int slice)
+{
+	std::vector<CLUSTER_CANDIDATE>& candidates = m_sliceCandidates[slice];
+	std::vector<uint32_t>& indices = m_sliceIndices[slice];
+	const int firstCluster = slice * CLUSTER_GRID_X * CLUSTER_GRID_Y;
+
+	candidates.clear();
+	indices.clear();
+
+	for (int i = 0; i < (int)m_viewSpheres.size(); i++)
+	{
+		CLUSTER_CANDIDATE candidate;
+
+		if ((slice < m_firstSlice[i]) || (slice > m_lastSlice[i]))
+		{
+			continue;
+		}
+
+		// the columns and rows are convex bands, so the ones a
+		// sphere reaches form one unbroken range
+		candidate.lightIndex = i;
+		candidate.firstColumn = CLUSTER_GRID_X;
+		candidate.lastColumn = -1;
+		for (int x = 0; x < CLUSTER_GRID_X; x++)
+		{
+			if (SphereIntersectsBounds(m_viewSpheres[i], m_columnBounds[slice * CLUSTER_GRID_X + x]) == true)
+			{
+				candidate.firstColumn = std::min(candidate.firstColumn, x);
+				candidate.lastColumn = x;
+			}
+		}
+		if (candidate.lastColumn == -1)
+		{
+			continue;
+		}
+		candidate.firstRow = CLUSTER_GRID_Y;
+		candidate.lastRow = -1;
+		for (int y = 0; y < CLUSTER_GRID_Y; y++)
+		{
+			if (SphereIntersectsBounds(m_viewSpheres[i], m_rowBounds[slice * CLUSTER_GRID_Y + y]) == true)
+			{
+				candidate.firstRow = std::min(candidate.firstRow, y);
+				candidate.lastRow = y;
+			}
+		}
+		if (candidate.lastRow == -1)
+		{
+			continue;
+		}
+		candidates.push_back(candidate);
+	}
+
+	for (int y = 0; y < CLUSTER_GRID_Y; y++)
+	{
+		for (int x = 0; x < CLUSTER_GRID_X; x++)
+		{
+			const int cluster = firstCluster + (y * CLUSTER_GRID_X) + x;
+			CLUSTER_RANGE& range = m_clusterRanges[cluster];
+
+			range.offset = (uint32_t)indices.size();
+			for (size_t c = 0; c < candidates.size(); c++)
+			{
+				const CLUSTER_CANDIDATE& candidate = candidates[c];
+
+				if ((x >= candidate.firstColumn) && (x <= candidate.lastColumn) &&
+					(y >= candidate.firstRow) && (y <= candidate.lastRow) &&
+					(SphereIntersectsBounds(m_viewSpheres[candidate.lightIndex], m_clusterBounds[cluster]) == true))
+				{
+					indices.push_back((uint32_t)candidate.lightIndex);
+				}
+			}
+			range.count = (uint32_t)indices.size() - range.offset;
+		}
+	}
+}
+
+/***********************************************************
+ *  UploadClusters()
+ *
+ *  This method is used for sending the cluster ranges and
+ *  the light index list to the cluster storage buffers. The
+ *  buffers are orphaned first so the driver does not wait
+ *  for the previous frame to finish reading them.
+ ***********************************************************/
+void LightClusterGrid::UploadClusters()
+{
+	int indexCount = std::max((int)m_lightIndices.size(), 1);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_clusterBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, CLUSTER_COUNT * sizeof(CLUSTER_RANGE), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, CLUSTER_COUNT * sizeof(CLUSTER_RANGE), m_clusterRanges.data());
+
+	while (m_indexBufferCapacity < indexCount)
+	{
+		m_indexBufferCapacity *= 2;
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_indexBufferCapacity * sizeof(uint32_t), NULL, GL_STREAM_DRAW);
+	if (m_lightIndices.empty() == false)
+	{
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, m_lightIndices.size() * sizeof(uint32_t), m_lightIndices.data());
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
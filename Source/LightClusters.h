@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.h
+// ============
+// assign the scene lights to a 3D grid of view frustum clusters
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderUniforms.h"
+#include "WorkerPool.h"
+
+#include <cstdint>
+#include <vector>
+
+// number of clusters across, down and into the view frustum
+const int CLUSTER_GRID_X = 16;
+const int CLUSTER_GRID_Y = 8;
+const int CLUSTER_GRID_Z = 24;
+const int CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+
+// counts from the last cluster build
+struct LIGHT_CLUSTER_STATS
+{
+	// lights that touched at least one cluster
+	int visibleLights;
+	// entries written to the cluster light index list
+	int lightReferences;
+	// clusters with at least one light
+	int occupiedClusters;
+	// time spent building the lists on the CPU
+	double buildMilliseconds;
+};
+
+/***********************************************************
+ *  LightClusterGrid
+ *
+ *  This class splits the view frustum into a grid of
+ *  clusters, with the depth slices spaced exponentially, and
+ *  builds the list of lights touching each cluster every
+ *  frame. The depth slices are built in parallel on the
+ *  worker pool.
+ *
+ *  The lists are uploaded to two shader storage blocks,
+ *  ClusterBuffer holding an offset and count per cluster,
+ *  and ClusterLightIndices holding the LightBuffer indexes.
+ *  The fragment shader finds its cluster from gl_FragCoord
+ *  and the view depth using the clusterParams uniform, and
+ *  only loops over the lights of that cluster while
+ *  bUseClusteredLights is set.
+ ***********************************************************/
+class LightClusterGrid
+{
+public:
+	// constructor
+	LightClusterGrid(ShaderUniforms* pShaderUniforms, WorkerPool* pWorkerPool);
+	// destructor
+	~LightClusterGrid();
+
+	// create the cluster buffers when the shader declares the
+	// clustered light path, which reads from the light buffer
+	bool Initialize(bool bUsingLightBuffer);
+	// true when the shader can use the cluster light lists
+	bool IsSupported() const;
+
+	// switch between the clustered lights and the full loop
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const;
+
+	// build and upload the cluster light lists for a frame,
+	// each light sphere holds the world position and range
+	void BuildClusters(
+		const std::vector<glm::vec4>& lightSpheres,
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec2& viewportSize);
+
+	// get the counts from the last cluster build
+	const LIGHT_CLUSTER_STATS& GetFrameStats() const;
+
+private:
+	// view space bounding box of a cluster
+	struct CLUSTER_BOUNDS
+	{
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+	};
+
+	// first light index and light count of a cluster, laid
+	// out for the std430 ClusterBuffer block
+	struct CLUSTER_RANGE
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	// a light that overlaps a depth slice, and the columns
+	// and rows of that slice its sphere reaches
+	struct CLUSTER_CANDIDATE
+	{
+		int lightIndex;
+		int firstColumn;
+		int lastColumn;
+		int firstRow;
+		int lastRow;
+	};
+
+	// compute the cluster bounds for a projection matrix
+	void ComputeClusterBounds(const glm::mat4& projection);
+	// get the depth slice holding a view space depth
+	int FindDepthSlice(float viewDepth) const;
+	// build the light lists of the clusters in a depth slice
+	void BuildDepthSlice(int slice);
+	// send the cluster ranges and light indexes to the shader
+	void UploadClusters();
+	// test a view space sphere against a cluster box
+	static bool SphereIntersectsBounds(const glm::vec4& sphere, const CLUSTER_BOUNDS& bounds);
+
+	// pointer to resolved shader uniform handles
+	ShaderUniforms* m_pShaderUniforms;
+	// pointer to the threads used to build the depth slices
+	WorkerPool* m_pWorkerPool;
+
+	// bounds of every cluster, and the union of each column
+	// and each row of clusters within a depth slice
+	std::vector<CLUSTER_BOUNDS> m_clusterBounds;
+	std::vector<CLUSTER_BOUNDS> m_columnBounds;
+	std::vector<CLUSTER_BOUNDS> m_rowBounds;
+	// projection the bounds were computed for
+	glm::mat4 m_boundsProjection;
+	bool m_bBoundsValid;
+	// exponential depth slice parameters
+	float m_nearPlane;
+	float m_farPlane;
+	float m_depthScale;
+	float m_depthBias;
+
+	// light spheres in view space and their depth slices
+	std::vector<glm::vec4> m_viewSpheres;
+	std::vector<int> m_firstSlice;
+	std::vector<int> m_lastSlice;
+	// light lists built by each depth slice
+	std::vector<CLUSTER_CANDIDATE> m_sliceCandidates[CLUSTER_GRID_Z];
+	std::vector<uint32_t> m_sliceIndices[CLUSTER_GRID_Z];
+	// the merged lists that are uploaded
+	std::vector<CLUSTER_RANGE> m_clusterRanges;
+	std::vector<uint32_t> m_lightIndices;
+
+	// shader storage buffers for the cluster lists
+	GLuint m_clusterBuffer;
+	GLuint m_indexBuffer;
+	int m_indexBufferCapacity;
+	bool m_bSupported;
+	bool m_bEnabled;
+
+	LIGHT_CLUSTER_STATS m_frameStats;
+};
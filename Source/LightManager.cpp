@@ -0,0 +1,454 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.cpp
+// ============
+// manage the scene light sources and upload them to the shader
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightManager.h"
+
+#include <algorithm>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// shader storage binding point of the LightBuffer block
+	const GLuint LIGHT_BUFFER_BINDING = 1;
+	// the handle keeps the slot index in the low bits and the
+	// slot generation in the high bits
+	const int LIGHT_HANDLE_SLOT_BITS = 16;
+	const uint32_t LIGHT_HANDLE_SLOT_MASK = 0xFFFF;
+	// a slot that reaches this generation is not used again, so
+	// the generation never wraps back to the value of a stale
+	// handle and no handle equals INVALID_LIGHT_HANDLE
+	const uint16_t LIGHT_HANDLE_RETIRED_GENERATION = 0xFFFF;
+}
+
+/***********************************************************
+ *  LightManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightManager::LightManager(ShaderUniforms* pShaderUniforms)
+{
+	m_pShaderUniforms = pShaderUniforms;
+	m_dirtyFirst = -1;
+	m_dirtyLast = -1;
+	m_lightBuffer = 0;
+	m_lightBufferCapacity = 0;
+	m_bUseLightBuffer = false;
+}
+
+/***********************************************************
+ *  ~LightManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightManager::~LightManager()
+{
+	m_pShaderUniforms = NULL;
+	if (m_lightBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_lightBuffer);
+		m_lightBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the light buffer when
+ *  the shader program declares the LightBuffer block. It
+ *  must be called after the shader uniforms are resolved.
+ *  Every light that was already added is uploaded again.
+ ***********************************************************/
+void LightManager::Initialize()
+{
+	m_bUseLightBuffer = false;
+	if ((NULL != m_pShaderUniforms) &&
+		(m_pShaderUniforms->BindStorageBlock("LightBuffer", LIGHT_BUFFER_BINDING) == true))
+	{
+		m_bUseLightBuffer = true;
+	}
+
+	if ((m_bUseLightBuffer == true) && (m_lightBuffer == 0))
+	{
+		m_lightBufferCapacity = 64;
+		while (m_lightBufferCapacity < (int)m_lights.size())
+		{
+			m_lightBufferCapacity *= 2;
+		}
+
+		glGenBuffers(1, &m_lightBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+		glBufferData(
+			GL_SHADER_STORAGE_BUFFER,
+			m_lightBufferCapacity * sizeof(LIGHT_BUFFER_ENTRY),
+			NULL,
+			GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_BUFFER_BINDING, m_lightBuffer);
+	}
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_LIGHT_BUFFER, m_bUseLightBuffer);
+	}
+
+	// send every light on the next upload
+	MarkDirty(0, (int)m_lights.size() - 1);
+
+	std::cout << "INFO: Light sources "
+		<< (m_bUseLightBuffer ? "stored in the LightBuffer storage block" : "limited to the lightSources[] uniforms, shader has no LightBuffer")
+		<< std::endl;
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a light source to the
+ *  scene. The returned handle is used to change or remove
+ *  the light later on.
+ ***********************************************************/
+LightHandle LightManager::AddLight(const LIGHT_SOURCE& light)
+{
+	int slotIndex = -1;
+	int lightIndex = (int)m_lights.size();
+	LightHandle handle = INVALID_LIGHT_HANDLE;
+
+	if (m_freeSlots.empty() == false)
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		if (m_slots.size() > LIGHT_HANDLE_SLOT_MASK)
+		{
+			std::cout << "ERROR::LIGHT_MANAGER: too many light sources" << std::endl;
+			return(INVALID_LIGHT_HANDLE);
+		}
+		LIGHT_SLOT slot;
+		slot.lightIndex = -1;
+		slot.generation = 0;
+		slotIndex = (int)m_slots.size();
+		m_slots.push_back(slot);
+	}
+
+	m_slots[slotIndex].lightIndex = lightIndex;
+	m_lights.push_back(LIGHT_BUFFER_ENTRY());
+	m_lightSlots.push_back(slotIndex);
+	handle = ((LightHandle)m_slots[slotIndex].generation << LIGHT_HANDLE_SLOT_BITS) | (LightHandle)slotIndex;
+	UpdateLight(handle, light);
+
+	return(handle);
+}
+
+/***********************************************************
+ *  UpdateLight()
+ *
+ *  This method is used for changing the values of a light
+ *  source. Only the changed light is uploaded again.
+ ***********************************************************/
+bool LightManager::UpdateLight(LightHandle handle, const LIGHT_SOURCE& light)
+{
+	int lightIndex = FindLightIndex(handle);
+
+	if (lightIndex == -1)
+	{
+		return(false);
+	}
+
+	LIGHT_BUFFER_ENTRY& entry = m_lights[lightIndex];
+	entry.position = light.position;
+	entry.focalStrength = light.focalStrength;
+	entry.ambientColor = light.ambientColor;
+	entry.specularIntensity = light.specularIntensity;
+	entry.diffuseColor = light.diffuseColor;
+	entry.ambientStrength = light.ambientStrength;
+	entry.specularColor = light.specularColor;
+	entry.range = light.range;
+	MarkDirty(lightIndex, lightIndex);
+
+	return(true);
+}
+
+/***********************************************************
+ *  RemoveLight()
+ *
+ *  This method is used for removing a light source from the
+ *  scene. The last light is moved into the freed position
+ *  so the packed array stays without gaps.
+ ***********************************************************/
+bool LightManager::RemoveLight(LightHandle handle)
+{
+	int lightIndex = FindLightIndex(handle);
+	int lastIndex = (int)m_lights.size() - 1;
+	int slotIndex = (int)(handle & LIGHT_HANDLE_SLOT_MASK);
+
+	if (lightIndex == -1)
+	{
+		return(false);
+	}
+
+	if (lightIndex != lastIndex)
+	{
+		m_lights[lightIndex] = m_lights[lastIndex];
+		m_lightSlots[lightIndex] = m_lightSlots[lastIndex];
+		m_slots[m_lightSlots[lightIndex]].lightIndex = lightIndex;
+	}
+	m_lights.pop_back();
+	m_lightSlots.pop_back();
+
+	// the old handle stops matching the slot
+	m_slots[slotIndex].lightIndex = -1;
+	m_slots[slotIndex].generation++;
+	if (m_slots[slotIndex].generation != LIGHT_HANDLE_RETIRED_GENERATION)
+	{
+		m_freeSlots.push_back(slotIndex);
+	}
+
+	// the moved light and the emptied last position change
+	MarkDirty(lightIndex, lastIndex);
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLight()
+ *
+ *  This method is used for getting the values of a light
+ *  source by handle.
+ ***********************************************************/
+bool LightManager::GetLight(LightHandle handle, LIGHT_SOURCE& light) const
+{
+	int lightIndex = FindLightIndex(handle);
+
+	if (lightIndex == -1)
+	{
+		return(false);
+	}
+
+	const LIGHT_BUFFER_ENTRY& entry = m_lights[lightIndex];
+	light.position = entry.position;
+	light.ambientColor = entry.ambientColor;
+	light.diffuseColor = entry.diffuseColor;
+	light.specularColor = entry.specularColor;
+	light.focalStrength = entry.focalStrength;
+	light.specularIntensity = entry.specularIntensity;
+	light.ambientStrength = entry.ambientStrength;
+	light.range = entry.range;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of light
+ *  sources in the scene.
+ ***********************************************************/
+int LightManager::GetLightCount() const
+{
+	return((int)m_lights.size());
+}
+
+/***********************************************************
+ *  IsUsingLightBuffer()
+ *
+ *  This method is used for checking whether the shader reads
+ *  the lights from the light buffer instead of the
+ *  lightSources[] uniforms.
+ ***********************************************************/
+bool LightManager::IsUsingLightBuffer() const
+{
+	return(m_bUseLightBuffer);
+}
+
+/***********************************************************
+ *  GetLightSpheres()
+ *
+ *  This method is used for getting the position and range
+ *  of every light, in the same order as the light buffer.
+ ***********************************************************/
+void LightManager::GetLightSpheres(std::vector<glm::vec4>& lightSpheres) const
+{
+	lightSpheres.resize(m_lights.size());
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		lightSpheres[i] = glm::vec4(m_lights[i].position, m_lights[i].range);
+	}
+}
+
+/***********************************************************
+ *  FindLightIndex()
+ *
+ *  This method is used for getting the packed array index
+ *  of the light with the passed in handle. A handle of a
+ *  removed light returns -1.
+ ***********************************************************/
+int LightManager::FindLightIndex(LightHandle handle) const
+{
+	uint32_t slotIndex = handle & LIGHT_HANDLE_SLOT_MASK;
+	uint16_t generation = (uint16_t)(handle >> LIGHT_HANDLE_SLOT_BITS);
+
+	if ((handle == INVALID_LIGHT_HANDLE) ||
+		(slotIndex >= m_slots.size()) ||
+		(m_slots[slotIndex].generation != generation))
+	{
+		return(-1);
+	}
+
+	return(m_slots[slotIndex].lightIndex);
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for widening the range of packed
+ *  lights that are sent on the next upload.
+ ***********************************************************/
+void LightManager::MarkDirty(int firstIndex, int lastIndex)
+{
+	if (lastIndex < firstIndex)
+	{
+		return;
+	}
+
+	if (m_dirtyFirst == -1)
+	{
+		m_dirtyFirst = firstIndex;
+		m_dirtyLast = lastIndex;
+	}
+	else
+	{
+		m_dirtyFirst = std::min(m_dirtyFirst, firstIndex);
+		m_dirtyLast = std::max(m_dirtyLast, lastIndex);
+	}
+}
+
+/***********************************************************
+ *  UploadLights()
+ *
+ *  This method is used for sending the lights that changed
+ *  since the last upload to the shader. It is called once
+ *  per frame before the scene is drawn, and does nothing
+ *  when no light has changed.
+ ***********************************************************/
+void LightManager::UploadLights()
+{
+	if ((m_dirtyFirst == -1) || (NULL == m_pShaderUniforms))
+	{
+		return;
+	}
+
+	if (m_bUseLightBuffer == true)
+	{
+		UploadLightBuffer(m_dirtyFirst, m_dirtyLast);
+	}
+	else
+	{
+		UploadLightUniforms(m_dirtyFirst, m_dirtyLast);
+	}
+	m_pShaderUniforms->setIntValue(UNIFORM_LIGHT_COUNT, (int)m_lights.size());
+
+	m_dirtyFirst = -1;
+	m_dirtyLast = -1;
+}
+
+/***********************************************************
+ *  UploadLightBuffer()
+ *
+ *  This method is used for copying a range of the packed
+ *  lights into the light buffer. When the lights no longer
+ *  fit, the buffer doubles in size and every light is sent.
+ ***********************************************************/
+void LightManager::UploadLightBuffer(int firstIndex, int lastIndex)
+{
+	int lightCount = (int)m_lights.size();
+
+	if (m_lightBuffer == 0)
+	{
+		return;
+	}
+
+	if (lightCount > m_lightBufferCapacity)
+	{
+		while (m_lightBufferCapacity < lightCount)
+		{
+			m_lightBufferCapacity *= 2;
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+		glBufferData(
+			GL_SHADER_STORAGE_BUFFER,
+			m_lightBufferCapacity * sizeof(LIGHT_BUFFER_ENTRY),
+			NULL,
+			GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_BUFFER_BINDING, m_lightBuffer);
+		firstIndex = 0;
+		lastIndex = lightCount - 1;
+	}
+
+	// positions past the light count are not read by the shader
+	lastIndex = std::min(lastIndex, lightCount - 1);
+	if (lastIndex < firstIndex)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+	glBufferSubData(
+		GL_SHADER_STORAGE_BUFFER,
+		firstIndex * sizeof(LIGHT_BUFFER_ENTRY),
+		(lastIndex - firstIndex + 1) * sizeof(LIGHT_BUFFER_ENTRY),
+		&m_lights[firstIndex]);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  UploadLightUniforms()
+ *
+ *  This method is used for staging a range of the packed
+ *  lights into the lightSources[] uniforms. Only the first
+ *  MAX_SHADER_LIGHTS lights fit, and the entries left over
+ *  after lights are removed are cleared to black.
+ ***********************************************************/
+void LightManager::UploadLightUniforms(int firstIndex, int lastIndex)
+{
+	LIGHT_BUFFER_ENTRY emptyLight;
+
+	if ((int)m_lights.size() > MAX_SHADER_LIGHTS)
+	{
+		static bool bReported = false;
+		if (bReported == false)
+		{
+			std::cout << "WARNING::LIGHT_MANAGER: only the first " << MAX_SHADER_LIGHTS
+				<< " of " << m_lights.size() << " light sources are used by the shader" << std::endl;
+			bReported = true;
+		}
+	}
+
+	emptyLight.position = glm::vec3(0.0f);
+	emptyLight.focalStrength = 0.0f;
+	emptyLight.ambientColor = glm::vec3(0.0f);
+	emptyLight.specularIntensity = 0.0f;
+	emptyLight.diffuseColor = glm::vec3(0.0f);
+	emptyLight.ambientStrength = 0.0f;
+	emptyLight.specularColor = glm::vec3(0.0f);
+	emptyLight.range = 0.0f;
+	lastIndex = std::min(lastIndex, MAX_SHADER_LIGHTS - 1);
+	for (int i = firstIndex; i <= lastIndex; i++)
+	{
+		const LIGHT_BUFFER_ENTRY& light = (i < (int)m_lights.size()) ? m_lights[i] : emptyLight;
+
+		m_pShaderUniforms->setVec3Value(ShaderUniforms::LightUniform(i, LIGHT_POSITION), light.position);
+		m_pShaderUniforms->setVec3Value(ShaderUniforms::LightUniform(i, LIGHT_AMBIENT_COLOR), light.ambientColor);
+		m_pShaderUniforms->setVec3Value(ShaderUniforms::LightUniform(i, LIGHT_DIFFUSE_COLOR), light.diffuseColor);
+		m_pShaderUniforms->setVec3Value(ShaderUniforms::LightUniform(i, LIGHT_SPECULAR_COLOR), light.specularColor);
+		m_pShaderUniforms->setFloatValue(ShaderUniforms::LightUniform(i, LIGHT_FOCAL_STRENGTH), light.focalStrength);
+		m_pShaderUniforms->setFloatValue(ShaderUniforms::LightUniform(i, LIGHT_SPECULAR_INTENSITY), light.specularIntensity);
+		m_pShaderUniforms->setFloatValue(ShaderUniforms::LightUniform(i, LIGHT_AMBIENT_STRENGTH), light.ambientStrength);
+	}
+}
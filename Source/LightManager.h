@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.h
+// ============
+// manage the scene light sources and upload them to the shader
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderUniforms.h"
+
+#include <cstdint>
+#include <vector>
+
+// handle of a light source, stays valid until the light is removed
+typedef uint32_t LightHandle;
+const LightHandle INVALID_LIGHT_HANDLE = 0xFFFFFFFF;
+
+/***********************************************************
+ *  LightManager
+ *
+ *  This class stores the scene light sources in one packed
+ *  array that matches the std430 layout of the LightBuffer
+ *  shader storage block. Lights are added, updated and
+ *  removed by handle, and only the range of lights changed
+ *  since the last upload is sent to the GPU.
+ *
+ *  When the shader has no LightBuffer block, the first
+ *  MAX_SHADER_LIGHTS lights are sent to the lightSources[]
+ *  uniform array instead.
+ ***********************************************************/
+class LightManager
+{
+public:
+	// constructor
+	LightManager(ShaderUniforms* pShaderUniforms);
+	// destructor
+	~LightManager();
+
+	struct LIGHT_SOURCE
+	{
+		glm::vec3 position;
+		glm::vec3 ambientColor;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float focalStrength;
+		float specularIntensity;
+		float ambientStrength;
+		// distance past which the light has no effect, used to
+		// assign the light to the view clusters it reaches
+		float range;
+	};
+
+	// create the light buffer, called once the shaders are loaded
+	void Initialize();
+
+	// add, change and remove light sources
+	LightHandle AddLight(const LIGHT_SOURCE& light);
+	bool UpdateLight(LightHandle handle, const LIGHT_SOURCE& light);
+	bool RemoveLight(LightHandle handle);
+	bool GetLight(LightHandle handle, LIGHT_SOURCE& light) const;
+
+	// number of lights in the scene
+	int GetLightCount() const;
+	// true when the shader reads the lights from the light buffer
+	bool IsUsingLightBuffer() const;
+	// get the position and range of every light in buffer order
+	void GetLightSpheres(std::vector<glm::vec4>& lightSpheres) const;
+
+	// send the lights changed since the last upload to the shader
+	void UploadLights();
+
+private:
+	// one light laid out for the std430 LightBuffer block
+	struct LIGHT_BUFFER_ENTRY
+	{
+		glm::vec3 position;
+		float focalStrength;
+		glm::vec3 ambientColor;
+		float specularIntensity;
+		glm::vec3 diffuseColor;
+		float ambientStrength;
+		glm::vec3 specularColor;
+		float range;
+	};
+
+	// position of a handle in the packed light array
+	struct LIGHT_SLOT
+	{
+		int lightIndex;
+		uint16_t generation;
+	};
+
+	// get the packed array index of a handle, -1 when not valid
+	int FindLightIndex(LightHandle handle) const;
+	// widen the range of lights that must be uploaded
+	void MarkDirty(int firstIndex, int lastIndex);
+	// send a range of lights to the light buffer
+	void UploadLightBuffer(int firstIndex, int lastIndex);
+	// send a range of lights to the lightSources[] uniforms
+	void UploadLightUniforms(int firstIndex, int lastIndex);
+
+	// pointer to resolved shader uniform handles
+	ShaderUniforms* m_pShaderUniforms;
+
+	// packed light data and the slot of each packed light
+	std::vector<LIGHT_BUFFER_ENTRY> m_lights;
+	std::vector<int> m_lightSlots;
+	// handle slots and the free slots available for reuse
+	std::vector<LIGHT_SLOT> m_slots;
+	std::vector<int> m_freeSlots;
+
+	// range of packed lights changed since the last upload
+	int m_dirtyFirst;
+	int m_dirtyLast;
+
+	// shader storage buffer holding the lights
+	GLuint m_lightBuffer;
+	int m_lightBufferCapacity;
+	// true when the shader reads the lights from the buffer
+	bool m_bUseLightBuffer;
+};
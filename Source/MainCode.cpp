@@ -1,177 +1,316 @@
-#include <iostream>         // error handling and output
-#include <cstdlib>          // EXIT_FAILURE
-
-#include <GL/glew.h>        // GLEW library
-#include "GLFW/glfw3.h"     // GLFW library
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "SceneManager.h"
-#include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
-
-// Namespace for declaring global variables
-namespace
-{
-	// Macro for window title
-	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
-
-	// Main GLFW window
-	GLFWwindow* g_Window = nullptr;
-
-	// scene manager object for managing the 3D scene prepare and render
-	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
-	// view manager object for managing the 3D view setup and projection to 2D
-	ViewManager* g_ViewManager = nullptr;
-}
-
-// Function declarations - all functions that are called manually
-// need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
-
-
-/***********************************************************
- *  main(int, char*)
- *
- *  This function gets called after the application has been
- *  launched.
- ***********************************************************/
-int main(int argc, char* argv[])
-{
-	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
-	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
-
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"../../Utilities/shaders/vertexShader.glsl",
-		"../../Utilities/shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
-	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
-	g_SceneManager->PrepareScene();
-
-	// loop will keep running until the application is closed 
-	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
-	{
-		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
-
-		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
-
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
-
-
-		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
-	}
-
-	// clear the allocated manager objects from memory
-	if (NULL != g_SceneManager)
-	{
-		delete g_SceneManager;
-		g_SceneManager = NULL;
-	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
-
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
-}
-
-/***********************************************************
- *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
- ***********************************************************/
-bool InitializeGLFW()
-{
-	// GLFW: initialize and configure library
-	// --------------------------------------
-	glfwInit();
-
-#ifdef __APPLE__
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#else
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-	// GLFW: end -------------------------------
-
-	return(true);
-}
-
-/***********************************************************
- *	InitializeGLEW()
- *
- *  This function is used to initialize the GLEW library.
- ***********************************************************/
-bool InitializeGLEW()
-{
-	// GLEW: initialize
-	// -----------------------------------------
-	GLenum GLEWInitResult = GLEW_OK;
-
-	// try to initialize the GLEW library
-	GLEWInitResult = glewInit();
-	if (GLEW_OK != GLEWInitResult)
-	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
-		return false;
-	}
-	// GLEW: end -------------------------------
-
-	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
-
-	return(true);
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "TransformBenchmark.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// resolved shader uniform handles used on the render path
+	ShaderUniforms* g_ShaderUniforms = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+
+	// transforms and passes timed by --bench-transforms
+	const int BENCHMARK_TRANSFORM_COUNT = 100000;
+	const int BENCHMARK_PASS_COUNT = 20;
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+void ReportFrameStats(int frameCount, double elapsedSeconds);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the application has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// the transform benchmark runs without opening a window
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--bench-transforms") == 0)
+		{
+			RunTransformBenchmark(BENCHMARK_TRANSFORM_COUNT, BENCHMARK_PASS_COUNT);
+			return(EXIT_SUCCESS);
+		}
+	}
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new shader uniforms object
+	g_ShaderUniforms = new ShaderUniforms();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager,
+		g_ShaderUniforms);
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+#ifdef __APPLE__
+	// the project shaders need OpenGL 4.3, so the 3.3 context
+	// loads the shader code from the external GLSL files
+	g_ShaderManager->LoadShaders(
+		"../../Utilities/shaders/vertexShader.glsl",
+		"../../Utilities/shaders/fragmentShader.glsl");
+#else
+	// load the project shaders, which read the material, light,
+	// cluster and draw data buffers and the texture arrays
+	g_ShaderManager->LoadShaders(
+		"Shaders/vertexShader.glsl",
+		"Shaders/fragmentShader.glsl");
+#endif
+	g_ShaderManager->use();
+	// resolve the uniform locations once, any unknown names are reported
+	g_ShaderUniforms->LoadUniforms();
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager, g_ShaderUniforms);
+	g_SceneManager->PrepareScene();
+	// the L key only reports clustered lighting when the
+	// light clusters could not be created
+	g_ViewManager->SetToggleAvailable(
+		TOGGLE_CLUSTERED_LIGHTING,
+		g_SceneManager->GetLightClusters()->IsSupported());
+	// the start camera stands between the quadrants and looks
+	// over all of them, so none may be culled by the portals
+	g_ViewManager->PrepareSceneView();
+	g_SceneManager->SetViewTransform(
+		g_ViewManager->GetViewMatrix(),
+		g_ViewManager->GetProjectionMatrix(),
+		g_ViewManager->GetViewportSize());
+	g_SceneManager->CheckAllCellsVisible();
+
+	// frame statistics are reported to the console once per second
+	double lastReportTime = glfwGetTime();
+	int reportFrameCount = 0;
+
+	// loop will keep running until the application is closed 
+	// or until an error has occurred
+	while (!glfwWindowShouldClose(g_Window))
+	{
+		// start counting the shader uniform updates for this frame
+		g_ShaderUniforms->BeginFrame();
+
+		// Enable z-depth
+		glEnable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+		g_SceneManager->SetViewTransform(
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix(),
+			g_ViewManager->GetViewportSize());
+		g_SceneManager->SetClusteredLighting(
+			g_ViewManager->GetToggle(TOGGLE_CLUSTERED_LIGHTING));
+		g_SceneManager->SetIndirectDraws(
+			g_ViewManager->GetToggle(TOGGLE_INDIRECT_DRAWS));
+		g_SceneManager->SetGpuCulling(
+			g_ViewManager->GetToggle(TOGGLE_GPU_CULLING),
+			g_ViewManager->GetToggle(TOGGLE_OCCLUSION_CULLING));
+
+		// refresh the 3D scene
+		g_SceneManager->RenderScene();
+
+
+		// Flips the the back buffer with the front buffer every frame.
+		glfwSwapBuffers(g_Window);
+
+		// query the latest GLFW events
+		glfwPollEvents();
+
+		reportFrameCount++;
+		if ((glfwGetTime() - lastReportTime) >= 1.0)
+		{
+			ReportFrameStats(reportFrameCount, glfwGetTime() - lastReportTime);
+			lastReportTime = glfwGetTime();
+			reportFrameCount = 0;
+		}
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderUniforms)
+	{
+		delete g_ShaderUniforms;
+		g_ShaderUniforms = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS); 
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ * 
+ *  This function is used to initialize the GLFW library.   
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	// Displays a successful OpenGL initialization message
+	std::cout << "INFO: OpenGL Successfully Initialized\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *	ReportFrameStats()
+ *
+ *  This function is used to print the frame rate and the
+ *  per-frame rendering counters to the console.
+ ***********************************************************/
+void ReportFrameStats(int frameCount, double elapsedSeconds)
+{
+	const UNIFORM_STATS& uniformStats = g_ShaderUniforms->GetFrameStats();
+	const LightClusterGrid* pLightClusters = g_SceneManager->GetLightClusters();
+	const SceneManager::CULLING_STATS& cullingStats = g_SceneManager->GetCullingStats();
+	const SceneManager::DRAW_STATS& drawStats = g_SceneManager->GetDrawStats();
+	const TextureUploader* pTextureUploader = g_SceneManager->GetTextureUploader();
+
+	std::cout << "INFO: " << (frameCount / elapsedSeconds) << " fps"
+		<< ", uniform updates issued:" << uniformStats.issued
+		<< ", skipped:" << uniformStats.skipped
+		<< ", collapsed:" << uniformStats.collapsed
+		<< ", unknown:" << uniformStats.unknown;
+	if (cullingStats.bGpuCulling == true)
+	{
+		std::cout << ", objects culled on the GPU";
+	}
+	else
+	{
+		std::cout << ", objects visible:" << (cullingStats.testedObjects - cullingStats.culledObjects)
+			<< ", culled:" << cullingStats.culledObjects
+			<< " (" << cullingStats.nodesVisited << " tree nodes)";
+	}
+	std::cout << ", cells visible:" << cullingStats.visibleCells << "/" << cullingStats.cellCount
+		<< ", draw calls:" << drawStats.drawCalls << " for " << drawStats.objectDraws << " objects";
+	if (cullingStats.bGpuCulling == false)
+	{
+		std::cout << ", triangles by level:";
+		for (int i = 0; i < SceneManager::MESH_LOD_COUNT; i++)
+		{
+			std::cout << ((i == 0) ? "" : "/") << drawStats.levelTriangles[i];
+		}
+	}
+	if (pLightClusters->IsEnabled() == true)
+	{
+		const LIGHT_CLUSTER_STATS& clusterStats = pLightClusters->GetFrameStats();
+
+		std::cout << ", clustered lights:" << clusterStats.visibleLights
+			<< " in " << clusterStats.occupiedClusters << " clusters"
+			<< " (" << clusterStats.buildMilliseconds << " ms)";
+	}
+	if (pTextureUploader->IsRunning() == true)
+	{
+		const TEXTURE_UPLOAD_STATS uploadStats = pTextureUploader->GetStats();
+
+		if (uploadStats.queuedImages > 0)
+		{
+			std::cout << ", texture uploads queued:" << uploadStats.queuedImages
+				<< ", done:" << uploadStats.uploadedImages
+				<< " (" << uploadStats.megabytesPerSecond << " MB/s)";
+		}
+	}
+	std::cout << std::endl;
 }
\ No newline at end of file
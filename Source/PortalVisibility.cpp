@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+// portalvisibility.cpp
+// ============
+// find the walled cells of the scene that can be seen from the camera
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PortalVisibility.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// longest chain of portals that is followed
+	const int MAX_PORTAL_DEPTH = 8;
+	// smallest clip space w kept when a portal crosses the
+	// camera plane
+	const float MIN_CLIP_W = 1.0e-4f;
+}
+
+/***********************************************************
+ *  PortalVisibility()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PortalVisibility::PortalVisibility()
+{
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every cell and portal.
+ ***********************************************************/
+void PortalVisibility::Clear()
+{
+	m_cells.clear();
+	m_portals.clear();
+	m_cellPortals.clear();
+}
+
+/***********************************************************
+ *  AddCell()
+ *
+ *  This method is used for adding a cell that encloses the
+ *  passed in box. The index of the new cell is returned, or
+ *  -1 when there are already too many cells.
+ ***********************************************************/
+int PortalVisibility::AddCell(const BOUNDING_BOX& bounds)
+{
+	if ((int)m_cells.size() >= MAX_PORTAL_CELLS)
+	{
+		return(-1);
+	}
+
+	m_cells.push_back(bounds);
+	m_cellPortals.push_back(std::vector<int>());
+
+	return((int)m_cells.size() - 1);
+}
+
+/***********************************************************
+ *  AddPortal()
+ *
+ *  This method is used for adding an opening that joins two
+ *  cells. The portal can be seen through from either side.
+ ***********************************************************/
+void PortalVisibility::AddPortal(int firstCell, int secondCell, const glm::vec3 corners[4])
+{
+	PORTAL portal;
+
+	if ((firstCell < 0) || (firstCell >= (int)m_cells.size()) ||
+		(secondCell < 0) || (secondCell >= (int)m_cells.size()))
+	{
+		return;
+	}
+
+	portal.cells[0] = firstCell;
+	portal.cells[1] = secondCell;
+	for (int i = 0; i < 4; i++)
+	{
+		portal.corners[i] = corners[i];
+	}
+	m_portals.push_back(portal);
+	m_cellPortals[firstCell].push_back((int)m_portals.size() - 1);
+	m_cellPortals[secondCell].push_back((int)m_portals.size() - 1);
+}
+
+/***********************************************************
+ *  GetCellCount()
+ *
+ *  This method is used for getting the number of cells.
+ ***********************************************************/
+int PortalVisibility::GetCellCount() const
+{
+	return((int)m_cells.size());
+}
+
+/***********************************************************
+ *  FindCell()
+ *
+ *  This method is used for getting the cell that holds a
+ *  point, or -1 when the point is in none of the cells.
+ ***********************************************************/
+int PortalVisibility::FindCell(const glm::vec3& point) const
+{
+	for (int i = 0; i < (int)m_cells.size(); i++)
+	{
+		const BOUNDING_BOX& cell = m_cells[i];
+
+		if ((point.x >= cell.minPoint.x) && (point.x <= cell.maxPoint.x) &&
+			(point.y >= cell.minPoint.y) && (point.y <= cell.maxPoint.y) &&
+			(point.z >= cell.minPoint.z) && (point.z <= cell.maxPoint.z))
+		{
+			return(i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  FindVisibleCells()
+ *
+ *  This method is used for finding the cells that can be
+ *  seen from the camera. The walk starts in the camera cell
+ *  with the whole screen, and every portal that is seen
+ *  narrows the screen area for the cells behind it. When the
+ *  camera is outside every cell, for example above the
+ *  walls, nothing can be ruled out and all cells are set.
+ *  The near plane distance is read back from the projection,
+ *  for either a perspective or an orthographic one.
+ ***********************************************************/
+uint32_t PortalVisibility::FindVisibleCells(const glm::mat4& view, const glm::mat4& projection) const
+{
+	glm::vec4 cameraPosition = glm::inverse(view)[3];
+	PORTAL_VIEW portalView;
+	int cameraCell = -1;
+	uint32_t visibleCells = 0;
+	SCREEN_RECT fullScreen = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+	portalView.viewProjection = projection * view;
+	portalView.position = glm::vec3(cameraPosition.x, cameraPosition.y, cameraPosition.z);
+	if (projection[2][3] != 0.0f)
+	{
+		portalView.nearDistance = projection[3][2] / (projection[2][2] - 1.0f);
+	}
+	else
+	{
+		portalView.nearDistance = (projection[3][2] + 1.0f) / projection[2][2];
+	}
+	portalView.nearDistance = std::max(portalView.nearDistance, 0.0f);
+
+	cameraCell = FindCell(portalView.position);
+	if (cameraCell == -1)
+	{
+		return(ALL_CELLS_VISIBLE);
+	}
+
+	VisitCell(cameraCell, fullScreen, portalView, 1u << cameraCell, 0, visibleCells);
+
+	return(visibleCells);
+}
+
+/***********************************************************
+ *  VisitCell()
+ *
+ *  This method is used for marking a cell as visible and
+ *  following each of its portals that overlaps the screen
+ *  area the cell is seen through. Cells already on the
+ *  current portal chain are not entered again.
+ *
+ *  The portals of the camera cell are the first hop. One the
+ *  camera stands in, or is closer to than the near plane,
+ *  can be clipped away or seen edge on, so it opens the
+ *  whole screen. The rectangle of a first hop portal is
+ *  only rejected when it is empty, not when it has no width,
+ *  as a camera in the plane of a portal sees it as a line.
+ ***********************************************************/
+void PortalVisibility::VisitCell(
+	int cell,
+	const SCREEN_RECT& screenRect,
+	const PORTAL_VIEW& portalView,
+	uint32_t pathCells,
+	int depth,
+	uint32_t& visibleCells) const
+{
+	visibleCells |= (1u << cell);
+	if (depth >= MAX_PORTAL_DEPTH)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_cellPortals[cell].size(); i++)
+	{
+		const PORTAL& portal = m_portals[m_cellPortals[cell][i]];
+		int nextCell = (portal.cells[0] == cell) ? portal.cells[1] : portal.cells[0];
+		SCREEN_RECT portalRect;
+
+		if ((pathCells & (1u << nextCell)) != 0)
+		{
+			continue;
+		}
+		if ((depth == 0) && (IsPortalAtCamera(portal, portalView) == true))
+		{
+			VisitCell(nextCell, screenRect, portalView, pathCells | (1u << nextCell), depth + 1, visibleCells);
+			continue;
+		}
+		if (ProjectPortal(portal, portalView.viewProjection, portalRect) == false)
+		{
+			continue;
+		}
+
+		// the cell behind is only seen through both openings
+		portalRect.minX = std::max(portalRect.minX, screenRect.minX);
+		portalRect.minY = std::max(portalRect.minY, screenRect.minY);
+		portalRect.maxX = std::min(portalRect.maxX, screenRect.maxX);
+		portalRect.maxY = std::min(portalRect.maxY, screenRect.maxY);
+		if (depth == 0)
+		{
+			if ((portalRect.minX > portalRect.maxX) || (portalRect.minY > portalRect.maxY))
+			{
+				continue;
+			}
+		}
+		else if ((portalRect.minX >= portalRect.maxX) || (portalRect.minY >= portalRect.maxY))
+		{
+			continue;
+		}
+
+		VisitCell(nextCell, portalRect, portalView, pathCells | (1u << nextCell), depth + 1, visibleCells);
+	}
+}
+
+/***********************************************************
+ *  IsPortalAtCamera()
+ *
+ *  This method is used for checking whether the camera is
+ *  within near plane distance of a portal. The distance is
+ *  taken to the box around the portal corners, which is
+ *  never farther than the opening itself.
+ ***********************************************************/
+bool PortalVisibility::IsPortalAtCamera(const PORTAL& portal, const PORTAL_VIEW& portalView) const
+{
+	glm::vec3 minPoint = portal.corners[0];
+	glm::vec3 maxPoint = portal.corners[0];
+	glm::vec3 closestPoint;
+
+	for (int i = 1; i < 4; i++)
+	{
+		minPoint = glm::min(minPoint, portal.corners[i]);
+		maxPoint = glm::max(maxPoint, portal.corners[i]);
+	}
+	closestPoint = glm::clamp(portalView.position, minPoint, maxPoint);
+
+	return(glm::length(closestPoint - portalView.position) <= portalView.nearDistance);
+}
+
+/***********************************************************
+ *  ProjectPortal()
+ *
+ *  This method is used for getting the screen rectangle of
+ *  a portal. The portal is clipped against the near plane
+ *  first, so a portal the camera stands in still gives the
+ *  part that is in front of the camera.
+ ***********************************************************/
+bool PortalVisibility::ProjectPortal(
+	const PORTAL& portal,
+	const glm::mat4& viewProjection,
+	SCREEN_RECT& screenRect) const
+{
+	glm::vec4 clipCorners[4];
+	glm::vec4 clipped[8];
+	int clippedCount = 0;
+
+	for (int i = 0; i < 4; i++)
+	{
+		clipCorners[i] = viewProjection * glm::vec4(portal.corners[i], 1.0f);
+	}
+
+	// keep the part of the outline in front of the near plane,
+	// where the clip space z + w is not negative
+	for (int i = 0; i < 4; i++)
+	{
+		const glm::vec4& current = clipCorners[i];
+		const glm::vec4& next = clipCorners[(i + 1) % 4];
+		float currentDistance = current.z + current.w;
+		float nextDistance = next.z + next.w;
+
+		if (currentDistance >= 0.0f)
+		{
+			clipped[clippedCount++] = current;
+		}
+		if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+		{
+			float t = currentDistance / (currentDistance - nextDistance);
+			clipped[clippedCount++] = current + ((next - current) * t);
+		}
+	}
+	if (clippedCount == 0)
+	{
+		return(false);
+	}
+
+	screenRect.minX = 1.0e30f;
+	screenRect.minY = 1.0e30f;
+	screenRect.maxX = -1.0e30f;
+	screenRect.maxY = -1.0e30f;
+	for (int i = 0; i < clippedCount; i++)
+	{
+		float w = std::max(clipped[i].w, MIN_CLIP_W);
+		float x = std::min(std::max(clipped[i].x / w, -1.0f), 1.0f);
+		float y = std::min(std::max(clipped[i].y / w, -1.0f), 1.0f);
+
+		screenRect.minX = std::min(screenRect.minX, x);
+		screenRect.minY = std::min(screenRect.minY, y);
+		screenRect.maxX = std::max(screenRect.maxX, x);
+		screenRect.maxY = std::max(screenRect.maxY, y);
+	}
+
+	return(true);
+}
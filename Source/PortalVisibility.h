@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// portalvisibility.h
+// ============
+// find the walled cells of the scene that can be seen from the camera
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "BoundingVolumes.h"
+
+#include <cstdint>
+#include <vector>
+
+// most cells supported, one bit each in the visible cell mask
+const int MAX_PORTAL_CELLS = 32;
+// mask with every cell visible
+const uint32_t ALL_CELLS_VISIBLE = 0xFFFFFFFF;
+
+/***********************************************************
+ *  PortalVisibility
+ *
+ *  This class splits the scene into cells, areas enclosed by
+ *  walls, joined by portals, the openings between the walls.
+ *  Each frame the camera cell is found and the portals are
+ *  followed outwards. A portal leads to the next cell only
+ *  when its screen rectangle overlaps the screen area seen
+ *  through the portals before it, so cells hidden behind
+ *  walls are never reached.
+ ***********************************************************/
+class PortalVisibility
+{
+public:
+	// constructor
+	PortalVisibility();
+
+	// remove every cell and portal
+	void Clear();
+	// add a cell enclosing the passed in box, returns its index
+	int AddCell(const BOUNDING_BOX& bounds);
+	// add a portal between two cells, the corners must go
+	// around the opening in order
+	void AddPortal(int firstCell, int secondCell, const glm::vec3 corners[4]);
+
+	// number of cells
+	int GetCellCount() const;
+	// get the cell holding a point, -1 when outside every cell
+	int FindCell(const glm::vec3& point) const;
+
+	// get a bit mask of the cells that can be seen by the
+	// camera, every bit is set when the camera is in no cell
+	uint32_t FindVisibleCells(const glm::mat4& view, const glm::mat4& projection) const;
+
+private:
+	// opening between two cells
+	struct PORTAL
+	{
+		int cells[2];
+		glm::vec3 corners[4];
+	};
+
+	// screen rectangle in normalized device coordinates
+	struct SCREEN_RECT
+	{
+		float minX;
+		float minY;
+		float maxX;
+		float maxY;
+	};
+
+	// camera the visible cells are found for
+	struct PORTAL_VIEW
+	{
+		glm::mat4 viewProjection;
+		glm::vec3 position;
+		float nearDistance;
+	};
+
+	// mark a cell visible and follow its portals
+	void VisitCell(
+		int cell,
+		const SCREEN_RECT& screenRect,
+		const PORTAL_VIEW& portalView,
+		uint32_t pathCells,
+		int depth,
+		uint32_t& visibleCells) const;
+	// true when the camera is as close to a portal as the
+	// near plane, where it may stand in the opening
+	bool IsPortalAtCamera(const PORTAL& portal, const PORTAL_VIEW& portalView) const;
+	// get the screen rectangle covered by a portal, false
+	// when the portal is fully behind the camera
+	bool ProjectPortal(const PORTAL& portal, const glm::mat4& viewProjection, SCREEN_RECT& screenRect) const;
+
+	std::vector<BOUNDING_BOX> m_cells;
+	std::vector<PORTAL> m_portals;
+	// portals leading out of each cell
+	std::vector<std::vector<int> > m_cellPortals;
+};
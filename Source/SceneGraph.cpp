@@ -0,0 +1,353 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.cpp
+// ============
+// place scene nodes relative to a parent node, and build the world
+// matrices of only the subtrees that changed
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneGraph.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  SceneGraph()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneGraph::SceneGraph(WorkerPool* pWorkerPool)
+{
+	m_localTransforms = new TransformTable(pWorkerPool);
+	m_bOrderChanged = false;
+}
+
+/***********************************************************
+ *  ~SceneGraph()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneGraph::~SceneGraph()
+{
+	delete m_localTransforms;
+	m_localTransforms = NULL;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every node.
+ ***********************************************************/
+void SceneGraph::Clear()
+{
+	m_localTransforms->Clear();
+	m_parents.clear();
+	m_firstChildren.clear();
+	m_lastChildren.clear();
+	m_nextSiblings.clear();
+	m_slotNodes.clear();
+	m_slotParents.clear();
+	m_subtreeEnds.clear();
+	m_worlds.clear();
+	m_worldNormalMatrices.clear();
+	m_dirtySlots.clear();
+	m_nodeSlots.clear();
+	m_updatedNodes.clear();
+	m_bOrderChanged = false;
+}
+
+/***********************************************************
+ *  AddNode()
+ *
+ *  This method is used for adding a node under a parent
+ *  that was already added. Its world matrix is built by the
+ *  next UpdateWorldMatrices().
+ ***********************************************************/
+int SceneGraph::AddNode(int parent, const TRANSFORM_VALUES& local)
+{
+	const int node = m_localTransforms->AddTransform(local);
+
+	if ((parent < -1) || (parent >= node))
+	{
+		parent = -1;
+	}
+
+	m_parents.push_back(parent);
+	m_firstChildren.push_back(-1);
+	m_lastChildren.push_back(-1);
+	m_nextSiblings.push_back(-1);
+	if (parent != -1)
+	{
+		if (m_lastChildren[parent] == -1)
+		{
+			m_firstChildren[parent] = node;
+		}
+		else
+		{
+			m_nextSiblings[m_lastChildren[parent]] = node;
+		}
+		m_lastChildren[parent] = node;
+	}
+	m_bOrderChanged = true;
+
+	return(node);
+}
+
+/***********************************************************
+ *  GetNodeCount()
+ *
+ *  This method is used for getting the number of nodes.
+ ***********************************************************/
+int SceneGraph::GetNodeCount() const
+{
+	return((int)m_parents.size());
+}
+
+/***********************************************************
+ *  GetParent()
+ *
+ *  This method is used for getting the parent of a node.
+ ***********************************************************/
+int SceneGraph::GetParent(int node) const
+{
+	return(m_parents[node]);
+}
+
+/***********************************************************
+ *  SetPosition()
+ *
+ *  This method is used for moving a node and everything
+ *  below it.
+ ***********************************************************/
+void SceneGraph::SetPosition(int node, const glm::vec3& position)
+{
+	m_localTransforms->SetPosition(node, position);
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for turning a node and everything
+ *  below it.
+ ***********************************************************/
+void SceneGraph::SetRotation(int node, const glm::quat& rotation)
+{
+	m_localTransforms->SetRotation(node, rotation);
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for turning a node and everything
+ *  below it, with the rotation about each axis in degrees.
+ ***********************************************************/
+void SceneGraph::SetRotation(int node, const glm::vec3& rotationDegrees)
+{
+	m_localTransforms->SetRotation(node, rotationDegrees);
+}
+
+/***********************************************************
+ *  SetScale()
+ *
+ *  This method is used for scaling a node and everything
+ *  below it.
+ ***********************************************************/
+void SceneGraph::SetScale(int node, const glm::vec3& scale)
+{
+	m_localTransforms->SetScale(node, scale);
+}
+
+/***********************************************************
+ *  GetLocalValues()
+ *
+ *  This method is used for getting the position, rotation
+ *  and scale of a node relative to its parent.
+ ***********************************************************/
+TRANSFORM_VALUES SceneGraph::GetLocalValues(int node) const
+{
+	return(m_localTransforms->GetValues(node));
+}
+
+/***********************************************************
+ *  UpdateWorldMatrices()
+ *
+ *  This method is used for building the world matrices of
+ *  the nodes that moved, directly or through a parent.
+ *  A marked slot always has its whole subtree marked, so a
+ *  changed node that is already marked is skipped. The
+ *  walk only covers the slots between the first and last
+ *  marked ones.
+ ***********************************************************/
+int SceneGraph::UpdateWorldMatrices()
+{
+	const int nodeCount = GetNodeCount();
+	int firstDirty = nodeCount;
+	int lastDirty = 0;
+
+	m_updatedNodes.clear();
+	m_localTransforms->UpdateMatrices();
+
+	if (m_bOrderChanged == true)
+	{
+		BuildTraversalOrder();
+		std::fill(m_dirtySlots.begin(), m_dirtySlots.end(), (uint8_t)1);
+		firstDirty = 0;
+		lastDirty = nodeCount;
+	}
+	else
+	{
+		const std::vector<int>& changedNodes = m_localTransforms->GetUpdatedTransforms();
+
+		for (size_t i = 0; i < changedNodes.size(); i++)
+		{
+			const int slot = m_nodeSlots[changedNodes[i]];
+
+			if (m_dirtySlots[slot] != 0)
+			{
+				continue;
+			}
+			std::fill(m_dirtySlots.begin() + slot, m_dirtySlots.begin() + m_subtreeEnds[slot], (uint8_t)1);
+			firstDirty = std::min(firstDirty, slot);
+			lastDirty = std::max(lastDirty, m_subtreeEnds[slot]);
+		}
+	}
+
+	for (int slot = firstDirty; slot < lastDirty; slot++)
+	{
+		const int node = m_slotNodes[slot];
+		const int parentSlot = m_slotParents[slot];
+
+		if (m_dirtySlots[slot] == 0)
+		{
+			continue;
+		}
+
+		// the inverse transpose of a product is the product of
+		// the inverse transposes, in the same order
+		if (parentSlot == -1)
+		{
+			m_worlds[slot] = m_localTransforms->GetModel(node);
+			m_worldNormalMatrices[slot] = m_localTransforms->GetNormalMatrix(node);
+		}
+		else
+		{
+			m_worlds[slot] = m_worlds[parentSlot] * m_localTransforms->GetModel(node);
+			m_worldNormalMatrices[slot] = m_worldNormalMatrices[parentSlot] * m_localTransforms->GetNormalMatrix(node);
+		}
+		m_dirtySlots[slot] = 0;
+		m_updatedNodes.push_back(node);
+	}
+
+	return((int)m_updatedNodes.size());
+}
+
+/***********************************************************
+ *  GetUpdatedNodes()
+ *
+ *  This method is used for getting the nodes whose world
+ *  matrices were built by the last UpdateWorldMatrices().
+ ***********************************************************/
+const std::vector<int>& SceneGraph::GetUpdatedNodes() const
+{
+	return(m_updatedNodes);
+}
+
+/***********************************************************
+ *  GetWorld()
+ *
+ *  This method is used for getting the world matrix of a
+ *  node, as of the last UpdateWorldMatrices().
+ ***********************************************************/
+const glm::mat4& SceneGraph::GetWorld(int node) const
+{
+	return(m_worlds[m_nodeSlots[node]]);
+}
+
+/***********************************************************
+ *  GetWorldNormalMatrix()
+ *
+ *  This method is used for getting the matrix that moves
+ *  the normals of a node into world space, as of the last
+ *  UpdateWorldMatrices().
+ ***********************************************************/
+const glm::mat3& SceneGraph::GetWorldNormalMatrix(int node) const
+{
+	return(m_worldNormalMatrices[m_nodeSlots[node]]);
+}
+
+/***********************************************************
+ *  GetKernel()
+ *
+ *  This method is used for getting the kernel that builds
+ *  the local matrices on this processor.
+ ***********************************************************/
+TRANSFORM_KERNEL SceneGraph::GetKernel() const
+{
+	return(m_localTransforms->GetKernel());
+}
+
+/***********************************************************
+ *  BuildTraversalOrder()
+ *
+ *  This method is used for laying the nodes out in depth
+ *  first order, with the root nodes and the children of
+ *  each node in the order they were added. The subtree
+ *  ends are gathered back to front, since every child
+ *  slot comes after its parent slot.
+ ***********************************************************/
+void SceneGraph::BuildTraversalOrder()
+{
+	const int nodeCount = GetNodeCount();
+	std::vector<int> nodeStack;
+
+	m_slotNodes.clear();
+	m_slotParents.clear();
+	m_nodeSlots.assign(nodeCount, -1);
+	m_subtreeEnds.resize(nodeCount);
+	m_worlds.resize(nodeCount);
+	m_worldNormalMatrices.resize(nodeCount);
+	m_dirtySlots.resize(nodeCount);
+
+	for (int root = 0; root < nodeCount; root++)
+	{
+		if (m_parents[root] != -1)
+		{
+			continue;
+		}
+
+		nodeStack.push_back(root);
+		while (nodeStack.empty() == false)
+		{
+			const int node = nodeStack.back();
+			const int slot = (int)m_slotNodes.size();
+			int childCount = 0;
+
+			nodeStack.pop_back();
+			m_nodeSlots[node] = slot;
+			m_slotNodes.push_back(node);
+			m_slotParents.push_back((m_parents[node] == -1) ? -1 : m_nodeSlots[m_parents[node]]);
+
+			// pushed in order and then reversed, so the first
+			// child is taken next
+			for (int child = m_firstChildren[node]; child != -1; child = m_nextSiblings[child])
+			{
+				nodeStack.push_back(child);
+				childCount++;
+			}
+			std::reverse(nodeStack.end() - childCount, nodeStack.end());
+		}
+	}
+
+	for (int slot = 0; slot < nodeCount; slot++)
+	{
+		m_subtreeEnds[slot] = slot + 1;
+	}
+	for (int slot = nodeCount - 1; slot >= 0; slot--)
+	{
+		if (m_slotParents[slot] != -1)
+		{
+			m_subtreeEnds[m_slotParents[slot]] = std::max(m_subtreeEnds[m_slotParents[slot]], m_subtreeEnds[slot]);
+		}
+	}
+
+	m_bOrderChanged = false;
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegraph.h
+// ============
+// place scene nodes relative to a parent node, and build the world
+// matrices of only the subtrees that changed
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TransformTable.h"
+#include "WorkerPool.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  SceneGraph
+ *
+ *  This class keeps a tree of nodes, each with a transform
+ *  relative to its parent. The local matrices are built by
+ *  a transform table, so only the nodes whose values
+ *  changed are built again. The world matrices are kept in
+ *  depth first order, where every subtree is one range of
+ *  slots after its root and a parent always comes before
+ *  its children. Changing a node marks the range of its
+ *  subtree, and UpdateWorldMatrices() walks the marked
+ *  slots front to back, reading each parent world matrix
+ *  that was just written a few slots earlier.
+ ***********************************************************/
+class SceneGraph
+{
+public:
+	// constructor
+	SceneGraph(WorkerPool* pWorkerPool);
+	// destructor
+	~SceneGraph();
+
+	// remove every node
+	void Clear();
+	// add a node under a parent, -1 for a root node, returns
+	// the node index
+	int AddNode(int parent, const TRANSFORM_VALUES& local);
+	// number of nodes
+	int GetNodeCount() const;
+	// parent of a node, -1 for a root node
+	int GetParent(int node) const;
+
+	// change the values of a node, relative to its parent
+	void SetPosition(int node, const glm::vec3& position);
+	void SetRotation(int node, const glm::quat& rotation);
+	void SetRotation(int node, const glm::vec3& rotationDegrees);
+	void SetScale(int node, const glm::vec3& scale);
+	// get the values of a node, relative to its parent
+	TRANSFORM_VALUES GetLocalValues(int node) const;
+
+	// build the local matrices of the changed nodes and the
+	// world matrices of their subtrees, returns the number of
+	// world matrices built
+	int UpdateWorldMatrices();
+	// nodes whose world matrices were built by the last
+	// UpdateWorldMatrices(), in depth first order
+	const std::vector<int>& GetUpdatedNodes() const;
+	// get the world matrix of a node
+	const glm::mat4& GetWorld(int node) const;
+	// get the inverse transpose of the world matrix of a
+	// node, for transforming normals
+	const glm::mat3& GetWorldNormalMatrix(int node) const;
+	// kernel that builds the local matrices
+	TRANSFORM_KERNEL GetKernel() const;
+
+private:
+	// lay the nodes out in depth first order
+	void BuildTraversalOrder();
+
+	// local values and matrices, by node
+	TransformTable* m_localTransforms;
+	// tree links, by node, children keep the order they
+	// were added in
+	std::vector<int> m_parents;
+	std::vector<int> m_firstChildren;
+	std::vector<int> m_lastChildren;
+	std::vector<int> m_nextSiblings;
+	// depth first order, by slot
+	std::vector<int> m_slotNodes;
+	std::vector<int> m_slotParents;
+	// slot after the last one of the subtree
+	std::vector<int> m_subtreeEnds;
+	std::vector<glm::mat4> m_worlds;
+	std::vector<glm::mat3> m_worldNormalMatrices;
+	std::vector<uint8_t> m_dirtySlots;
+	// slot of each node
+	std::vector<int> m_nodeSlots;
+	std::vector<int> m_updatedNodes;
+	// true when nodes were added since the order was built
+	bool m_bOrderChanged;
+};
@@ -1,2252 +1,4339 @@
-///////////////////////////////////////////////////////////////////////////////
-// shadermanager.cpp
-// ============
-// manage the loading and rendering of 3D scenes
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#include <glm/gtx/transform.hpp>
-
-// declaration of global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-		std::cout << "failed here";
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.ambientColor = m_objectMaterials[index].ambientColor;
-			material.ambientStrength = m_objectMaterials[index].ambientStrength;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
-}
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
-/// <summary>
-/// Loads the images and converts them to textures.
-/// </summary>
-void SceneManager::LoadSceneTextures() 
-{
-	bool bReturn = false;
-	stbi_set_flip_vertically_on_load(true);
-	// load the texture images and convert to OpenGL texture data		
-	bReturn = CreateGLTexture("../../Utilities/Textures/BushDenseBerries.jpg", "DenseBerries");
-	bReturn = CreateGLTexture("../../Utilities/Textures/bushDense.jpg", "Hedge");
-	bReturn = CreateGLTexture("../../Utilities/Textures/BarkTexture.jpg", "bark");
-	bReturn = CreateGLTexture("../../Utilities/Textures/pavers.jpg", "brick");
-	bReturn = CreateGLTexture("../../Utilities/Textures/tilesf2.jpg", "tile");
-	bReturn = CreateGLTexture("../../Utilities/Textures/rocks.jpg", "rocks");
-	
-	BindGLTextures();
-}
-
-/// <summary>
-/// Creates the object shader material
-/// </summary>
-void SceneManager::DefineObjectMaterials()
-{
-
-	//Cement Type of material or dark material
-	OBJECT_MATERIAL cementMaterial;
-	cementMaterial.ambientColor = glm::vec3(0.6f, 0.6f, 0.6f);
-	cementMaterial.ambientStrength = 0.0f;
-	cementMaterial.diffuseColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	cementMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	cementMaterial.shininess = 0.1;
-	cementMaterial.tag = "cement";
-
-	m_objectMaterials.push_back(cementMaterial);
-
-	//Tile material with a tint of blue
-	OBJECT_MATERIAL blueTile;
-	blueTile.ambientColor = glm::vec3(0.1f, 0.1f, 0.6f);
-	blueTile.ambientStrength = 0.1f;
-	blueTile.diffuseColor = glm::vec3(0.1f, 0.1f, 0.3f);
-	blueTile.specularColor = glm::vec3(0.1f, 0.1f, 0.3f);
-	blueTile.shininess = 0.6f;
-	blueTile.tag = "blueTile";
-
-	m_objectMaterials.push_back(blueTile);
-
-	//bush material with a tint of green
-	OBJECT_MATERIAL bush;
-	bush.ambientColor = glm::vec3(0.1f, 0.8f, 0.1f);
-	bush.ambientStrength = 0.1f;
-	bush.diffuseColor = glm::vec3(0.1f, 0.8, 0.1f);
-	bush.specularColor = glm::vec3(0.1f, 0.8, 0.1f);
-	bush.shininess = 0.1f;
-	bush.tag = "bush";
-
-	m_objectMaterials.push_back(bush);
-
-	//bark material with a mixed tint
-	OBJECT_MATERIAL bark;
-	bark.ambientColor = glm::vec3(0.5f, 0.5f, 0.1f);
-	bark.ambientStrength = 0.1f;
-	bark.diffuseColor = glm::vec3(0.5f, 0.5, 0.1f);
-	bark.specularColor = glm::vec3(0.5f, 0.5, 0.1f);
-	bark.shininess = 0.1f;
-	bark.tag = "bark";
-
-	m_objectMaterials.push_back(bark);
-
-}
-
-/// <summary>
-/// Defines and sets scene lights
-/// </summary>
-void SceneManager::SetupSceneLights()
-{
-	// this line of code is NEEDED for telling the shaders to render 
-	// the 3D scene with custom lighting, if no light sources have
-	// been added then the display window will be black - to use the 
-	// default OpenGL lighting then comment out the following line
-	//m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	//Light one                             
-	m_pShaderManager->setVec3Value("lightSources[0].positon", 0.0f, 11.0f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].ambientColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].diffuseColor", 0.0f, 0.0f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].specularColor", 0.0f, 0.0f, 0.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].focalStrength", 0.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].specularIntensity", 0.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].ambientStrength", 0.6f);
-
-	//Light two                             
-	m_pShaderManager->setVec3Value("lightSources[1].positon", -50.0f, 11.0f, -50.0f);
-	m_pShaderManager->setVec3Value("lightSources[1].ambientColor", 0.8f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[1].diffuseColor", 0.8f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[1].specularColor", 0.8f, 0.1f, 0.1f);
-	m_pShaderManager->setFloatValue("lightSources[1].focalStrength", 0.5f);
-	m_pShaderManager->setFloatValue("lightSources[1].specularIntensity", 0.5f);
-	m_pShaderManager->setFloatValue("lightSources[1].ambientStrength", 0.6f);
-
-	//Light three
-	m_pShaderManager->setVec3Value("lightSources[2].positon", 50.0f, 11.0f,50.0f);
-	m_pShaderManager->setVec3Value("lightSources[2].ambientColor", 0.1f, 0.1f, 0.8f);
-	m_pShaderManager->setVec3Value("lightSources[2].diffuseColor", 0.1f, 0.1f, 0.8f);
-	m_pShaderManager->setVec3Value("lightSources[2].specularColor", 0.1f, 0.1f, 0.8f);
-	m_pShaderManager->setFloatValue("lightSources[2].focalStrength", 0.6f);
-	m_pShaderManager->setFloatValue("lightSources[2].specularIntensity", 0.6f);
-	m_pShaderManager->setFloatValue("lightSources[2].ambientStrength", 0.6f);
-
-	//Light four
-	m_pShaderManager->setVec3Value("lightSources[3].positon", 50.0f, 11.0f, -50.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].ambientColor", 0.1f, 0.7f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].diffuseColor", 0.1f, 0.7f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].specularColor", 0.0f, 0.7f, 0.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].focalStrength", 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].specularIntensity", 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].ambientStrength", 1.0f);
-
-
-	//Light one                            
-
-
-
-	
-
-	m_pShaderManager->setBoolValue("bUseLightng", true);
-
-}
-
-/// <summary>
-/// Loads the object meshes and prepares scene lights and textures
-/// </summary>
-void SceneManager::PrepareScene()
-{
-	// define the materials for objects in the scene
-	DefineObjectMaterials();
-	// add and define the light sources for the scene
-	SetupSceneLights();
-
-	LoadSceneTextures();
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadConeMesh();
-	m_basicMeshes->LoadTorusMesh();
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadPyramid4Mesh();
-}
-
-/// <summary>
-/// The full render function
-/// Calls all the individual render functions
-/// </summary>
-void SceneManager::RenderScene()
-{
-	RenderFloor();
-	RenderWalls();
-	RenderQuadrantWalls();
-	RenderQuadrantOne();
-	RenderQuadrantTwo();
-	RenderQuadrantThree();
-	RenderQuadrantFour();
-
-
-}
-
-/// <summary>
-/// Renders and defines the floor
-/// </summary>
-void SceneManager::RenderFloor() 
-{
-	//FLOOR
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(100.0f, 1.0f, 100.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, -20.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("brick");
-	SetShaderMaterial("cement");
-	SetTextureUVScale(20, 20);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-	/****************************************************************/
-
-	
-}
-
-/// <summary>
-/// Renders all the objects in quadrant one
-/// </summary>
-void SceneManager::RenderQuadrantOne()
-{
-	//QUADRANT 1
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-
-	//CENTER BLOCK	
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 0.5f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("tile");
-	SetShaderMaterial("blueTile");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/ 
-
-	//CENTER MULCH
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 0.6f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("rocks");
-	SetShaderMaterial("cement");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//LEFT BOTTOM CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(50.0f, 0.9f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//LEFT TOP CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(50.0f, 2.9f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//RIGHT BOTTOM CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(60.0f, 0.9f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//RIGHT TOP CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(60.0f, 2.9f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//RIGHT TORUS
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(60.0f, 8.8f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(3, 2);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTorusMesh();
-	/******************************************************************/
-
-	//LEFT TORUS
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(50.0f, 8.8f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(3, 2);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTorusMesh();
-	/******************************************************************/
-
-	//CENTER TORUS
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 18.5f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(3, 2);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTorusMesh();
-	/******************************************************************/
-
-
-
-}
-
-/// <summary>
-/// Renders all the small bushes in quadrant two
-/// uses helper function add root, which defines the root height also
-/// </summary>
-void SceneManager::RenderQuadrantTwo() 
-{
-	//QUADRANT 2
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-	//Usefull for moveving all spheres
-	float sHeight = 3.3;
-	float sSize = 1.3;
-
-	//CENTER BLOCK	
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, 0.5f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("tile");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//CENTER MULCH
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, 0.6f, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("rocks");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//Sphere 1
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-48.0f, sHeight, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-48.0f, 35.0f);
-	/******************************************************************/
-
-	//Sphere 2
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-62.0f, sHeight, 35.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-62.0f, 35.0f);
-	/******************************************************************/
-
-	//Sphere three
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, sHeight, 42.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-	AddRoot(-55.0f, 42.0f);
-	/******************************************************************/
-
-	//Sphere 4
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, sHeight, 28.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-55.0f, 28.0f);
-	/******************************************************************/
-
-	//Sphere 5
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, sHeight, 40.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-50.0f, 40.0f);
-	/******************************************************************/
-
-	//Sphere 6
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, sHeight, 30.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-60.0f, 30.0f);
-	/******************************************************************/
-
-	//Sphere 7
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, sHeight, 40.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-60.0f, 40.0f);
-	/******************************************************************/
-
-	//Sphere 8
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, sHeight, 30.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-50.0f, 30.0f);
-	/******************************************************************/
-
-	//Sphere 9
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-52.3f, sHeight, 28.3f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-52.3f, 28.3f);
-	/******************************************************************/
-
-	//Sphere 10
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-57.7f, sHeight, 41.7f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-57.7f, 41.7f);
-	/******************************************************************/
-
-	//Sphere 11
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-57.7f, sHeight, 28.3f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-57.7f, 28.3f);
-	/******************************************************************/
-
-	//Sphere 12
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-52.3f, sHeight, 41.7f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-52.3f, 41.7f);
-	/******************************************************************/
-
-	//Sphere 13
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-61.7f, sHeight, 37.7f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-61.7f, 37.7f);
-	/******************************************************************/
-
-	//Sphere 14
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-48.3f, sHeight, 32.3f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-48.3f, 32.3f);
-	/******************************************************************/
-
-	//Sphere 15
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-61.7f, sHeight, 32.3f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-61.7f, 32.3f);
-	/******************************************************************/
-
-	//Sphere 16
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(sSize, sSize, sSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-48.3f, sHeight, 37.7f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	AddRoot(-48.3f, 37.7f);
-	/******************************************************************/
-
-
-}
-
-/// <summary>
-/// Renders all the objects in quadrant three
-/// </summary>
-void SceneManager::RenderQuadrantThree()
-{
-	//QUADRANT 3
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-
-	//CENTER BLOCK	
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 0.5f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("tile");
-	SetShaderMaterial("blueTile");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//CENTER MULCH
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 0.6f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("rocks");
-	SetShaderMaterial("cement");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//BOTTOM CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 0.9f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//TOP CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 2.9f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//bottom square
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(4.0f, 4.0f, 4.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 4.9f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//sphere
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(2.5f, 2.5f, 2.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 9.3f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-	/******************************************************************/
-
-	//bottom square
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(4.0f, 4.0f, 4.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(55.0f, 13.5f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-
-}
-
-/// <summary>
-/// Renders all the objects in quadrant four
-/// </summary>
-void SceneManager::RenderQuadrantFour()
-{
-	//QUADRANT 4
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-	//Useful variables for this quadrant
-	float pSize = 8.5f;
-	float pHeight = 6.7f;
-
-	//CENTER BLOCK	
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, 0.5f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("tile");
-	SetShaderMaterial("blueTile");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//CENTER MULCH
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, 0.6f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("rocks");
-	SetShaderMaterial("cement");
-	SetTextureUVScale(10, 10);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/******************************************************************/
-
-	//cone one bottom
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, 0.6f, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//cone one top
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.5f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, 2.6f, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//Pyramid one
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(pSize, pSize, pSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, pHeight, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-	//cone two bottom
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, 0.6f, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//cone two top
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.5f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, 2.6f, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//Pyramid two
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(pSize, pSize, pSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, pHeight, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-	//cone three bottom
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, 0.6f, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//cone three top
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.5f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, 2.6f, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//Pyramid three
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(pSize, pSize, pSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-60.0f, pHeight, -70.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-	//cone four bottom
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, 0.6f, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//cone four top
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.5f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, 2.6f, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//Pyramid four
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(pSize, pSize, pSize);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-50.0f, pHeight, -80.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-	//Pyramid top
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(11.0f, 11.0f, 11.0f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-55.0f, 16.0f, -75.0f);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("Hedge");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	/******************************************************************/
-
-
-
-
-}
-
-/// <summary>
-/// Renders the divind walls between the quadrants
-/// </summary>
-void SceneManager::RenderQuadrantWalls() 
-{
-	//QUADRANT WALLS
-	
-	// declare the variables for the transformations
-	/******************************************************************/
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-	//FRONT DIVIDER
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, 50.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("DenseBerries");
-	SetTextureUVScale(10, 5);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	//BACK DIVIDER
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, -90.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("DenseBerries");
-	SetTextureUVScale(10, 5);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	//LEFT DIVIDER
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-70.0f, 10.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("DenseBerries");
-	SetTextureUVScale(10, 5);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	//RIGHT DIVIDER
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(70.0f, 10.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("DenseBerries");
-	SetTextureUVScale(10, 5);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-}
-
-/// <summary>
-/// Renders the outer border walls
-/// </summary>
-void SceneManager::RenderWalls() 
-{
-	//WALLS
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-
-	// BACK WALL
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, -117.5f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("DenseBerries");
-	SetShaderMaterial("bush");
-	SetTextureUVScale(10, 5);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	// LEFT WALL
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-97.5f, 10.0f, -20.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	// RIGHT WALL
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(97.5f, 10.0f, -20.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-	// FRONT WALL
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, 77.5f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	/****************************************************************/
-
-}
-
-/// <summary>
-/// Add Root renders a small root for the desired location in the x, z plane.
-/// </summary>
-/// <param name="x">is the x coordinate in the plane</param>
-/// <param name="z">is the z coordinate in the plane</param>
-void SceneManager::AddRoot(float x, float z) 
-{
-	/******************************************************************/
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-	/******************************************************************/
-
-	//LEFT BOTTOM CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(x, 0.9f, z);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
-
-	//TOP CONE
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 180.0f;
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(x, 2.9f, z);
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("bark");
-	SetShaderMaterial("bark");
-	SetTextureUVScale(1, 1);
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-	/******************************************************************/
+///////////////////////////////////////////////////////////////////////////////
+// shadermanager.cpp
+// ============
+// manage the loading and rendering of 3D scenes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// uniform buffer binding point of the MaterialBlock
+	const GLuint MATERIAL_BLOCK_BINDING = 0;
+	// storage buffer binding point of the DrawDataBuffer
+	const GLuint DRAW_DATA_BINDING = 4;
+	// number of texture slots when each texture has its own
+	// texture unit, there is no limit with texture arrays
+	const int MAX_TEXTURE_SLOTS = 16;
+	// texture unit of the object sampler the shader does not
+	// read, a sampler2D and a sampler2DArray cannot share one
+	const int UNUSED_SAMPLER_UNIT = 16;
+	// decoded images sent to OpenGL per frame, so a frame
+	// never waits on more than a couple of uploads
+	const int TEXTURE_UPLOADS_PER_FRAME = 2;
+	// mid gray shown until the image of a texture is decoded
+	const unsigned char PLACEHOLDER_PIXEL[4] = { 128, 128, 128, 255 };
+
+	// local bounds of each basic shape mesh, in the same order
+	// as MESH_TYPE, these are kept loose where the mesh shape
+	// is not exactly known so nothing visible is culled
+	const BOUNDING_BOX g_MeshBounds[SceneManager::MESH_TYPE_COUNT] =
+	{
+		// plane
+		{ glm::vec3(-1.0f, -0.01f, -1.0f), glm::vec3(1.0f, 0.01f, 1.0f) },
+		// box
+		{ glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.5f, 0.5f, 0.5f) },
+		// cone
+		{ glm::vec3(-1.0f, 0.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f) },
+		// sphere
+		{ glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f) },
+		// torus
+		{ glm::vec3(-1.2f, -1.2f, -1.2f), glm::vec3(1.2f, 1.2f, 1.2f) },
+		// pyramid
+		{ glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.5f, 1.0f, 0.5f) }
+	};
+
+	// tessellation of the curved meshes at each level
+	const int g_ConeLodSlices[SceneManager::MESH_LOD_COUNT] = { 36, 16, 8 };
+	const int g_SphereLodSlices[SceneManager::MESH_LOD_COUNT] = { 36, 18, 10 };
+	const int g_SphereLodStacks[SceneManager::MESH_LOD_COUNT] = { 18, 9, 5 };
+	const int g_TorusLodRingSlices[SceneManager::MESH_LOD_COUNT] = { 36, 18, 10 };
+	const int g_TorusLodTubeSlices[SceneManager::MESH_LOD_COUNT] = { 12, 8, 5 };
+	// screen size in pixels below which an object is drawn
+	// at the next level
+	const float g_LodScreenSizes[SceneManager::MESH_LOD_COUNT - 1] = { 120.0f, 40.0f };
+	// part of a screen size an object has to pass it by before
+	// its level changes, so objects near it do not flicker
+	// between two levels
+	const float LOD_HYSTERESIS = 0.15f;
+
+	// check whether a basic mesh has tessellation levels
+	bool IsCurvedMesh(SceneManager::MESH_TYPE mesh)
+	{
+		return((mesh == SceneManager::MESH_CONE) ||
+			(mesh == SceneManager::MESH_SPHERE) ||
+			(mesh == SceneManager::MESH_TORUS));
+	}
+
+	// build the geometry of one of the basic shape meshes at
+	// a tessellation level
+	void GenerateBasicMesh(SceneManager::MESH_TYPE mesh, int lod, MESH_GEOMETRY& geometry)
+	{
+		geometry = MESH_GEOMETRY();
+
+		switch (mesh)
+		{
+		case SceneManager::MESH_PLANE:
+			GeneratePlaneMesh(geometry);
+			break;
+		case SceneManager::MESH_BOX:
+			GenerateBoxMesh(geometry);
+			break;
+		case SceneManager::MESH_CONE:
+			GenerateConeMesh(geometry, g_ConeLodSlices[lod]);
+			break;
+		case SceneManager::MESH_SPHERE:
+			GenerateSphereMesh(geometry, g_SphereLodSlices[lod], g_SphereLodStacks[lod]);
+			break;
+		case SceneManager::MESH_TORUS:
+			GenerateTorusMesh(geometry, g_TorusLodRingSlices[lod], g_TorusLodTubeSlices[lod]);
+			break;
+		case SceneManager::MESH_PYRAMID4:
+			GeneratePyramid4Mesh(geometry);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// check that a decoded image can be sent to OpenGL, and
+	// report how it was loaded
+	bool CheckDecodedImage(const DECODED_IMAGE& image)
+	{
+		// the loader keeps the channels of an image it decoded
+		// but could not use
+		if ((image.channels != 0) && (image.channels != 3) && (image.channels != 4))
+		{
+			std::cout << "Not implemented to handle image with " << image.channels << " channels" << std::endl;
+			return(false);
+		}
+		if (NULL == image.texels)
+		{
+			std::cout << "Could not load image:" << image.filename << std::endl;
+			return(false);
+		}
+
+		std::cout << "Successfully loaded image:" << image.filename << ", width:" << image.width << ", height:" << image.height << ", channels:" << image.channels
+			<< ", format:" << GetTextureFormatName(image.format)
+			<< ((NULL != image.pCacheFile) ? ", from the texture cache" : "") << std::endl;
+		return(true);
+	}
+
+	// clear the draw counts of a frame
+	void ResetDrawStats(SceneManager::DRAW_STATS& stats)
+	{
+		stats.objectDraws = 0;
+		stats.drawCalls = 0;
+		for (int i = 0; i < SceneManager::MESH_LOD_COUNT; i++)
+		{
+			stats.levelTriangles[i] = 0;
+		}
+	}
+
+	// add the draw counts of one part of a frame to the others
+	void AddDrawStats(SceneManager::DRAW_STATS& stats, const SceneManager::DRAW_STATS& partStats)
+	{
+		stats.objectDraws += partStats.objectDraws;
+		stats.drawCalls += partStats.drawCalls;
+		for (int i = 0; i < SceneManager::MESH_LOD_COUNT; i++)
+		{
+			stats.levelTriangles[i] += partStats.levelTriangles[i];
+		}
+	}
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager, ShaderUniforms* pShaderUniforms)
+{
+	m_pShaderManager = pShaderManager;
+	m_pShaderUniforms = pShaderUniforms;
+	m_lightManager = new LightManager(pShaderUniforms);
+	m_workerPool = new WorkerPool();
+	m_lightClusters = new LightClusterGrid(pShaderUniforms, m_workerPool);
+	m_loadedTextures = 0;
+	m_textureArrays = NULL;
+	m_bUseTextureArrays = false;
+	m_textureLayout = 0;
+	m_textureLoader = new AsyncTextureLoader();
+	m_textureUploader = new TextureUploader();
+	m_textureMemoryBytes = 0;
+	m_uncompressedTextureBytes = 0;
+
+	// default state for the recorded draws
+	m_drawState.model = glm::mat4(1.0f);
+	m_drawState.normalMatrix = glm::mat3(1.0f);
+	m_drawState.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	m_drawState.uvScale = glm::vec2(1.0f, 1.0f);
+	m_drawState.textureSlot = -1;
+	m_drawState.materialIndex = -1;
+	m_drawState.mesh = MESH_BOX;
+	m_drawState.lod = 0;
+	m_drawState.bUseTexture = false;
+	m_drawTransform.scale = glm::vec3(1.0f, 1.0f, 1.0f);
+	m_drawTransform.rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	m_drawTransform.position = glm::vec3(0.0f, 0.0f, 0.0f);
+	m_sceneGraph = new SceneGraph(m_workerPool);
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewportSize = glm::vec2(1.0f, 1.0f);
+	m_cullingStats.testedObjects = 0;
+	m_cullingStats.culledObjects = 0;
+	m_cullingStats.nodesVisited = 0;
+	m_cullingStats.visibleCells = 0;
+	m_cullingStats.cellCount = 0;
+	m_cullingStats.bGpuCulling = false;
+	m_visibleCells = ALL_CELLS_VISIBLE;
+	ResetDrawStats(m_drawStats);
+	m_meshBuffer = NULL;
+	m_cameraPosition = glm::vec3(0.0f);
+	m_lodScale = 1.0f;
+	m_drawDataBuffer = 0;
+	m_drawCommandBuffer = 0;
+	m_drawBufferCapacity = 0;
+	m_bIndirectSupported = false;
+	m_bUseIndirectDraws = false;
+	m_gpuCulling = NULL;
+	m_instanceDataBuffer = 0;
+	m_gpuTextureLayout = 0;
+	m_bUseGpuCulling = false;
+	m_staticBatches = NULL;
+	m_bRecordStaticBatches = false;
+	m_staticTree = new BoundingVolumeHierarchy(m_workerPool);
+	m_dynamicTree = new BoundingVolumeHierarchy(m_workerPool);
+	m_bRebuildTrees = false;
+	m_bRefitDynamicTree = false;
+
+	m_materialBuffer = 0;
+	m_bUseMaterialBlock = false;
+	m_appliedMaterialIndex = -1;
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	m_pShaderManager = NULL;
+	m_pShaderUniforms = NULL;
+	if (m_materialBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_materialBuffer);
+		m_materialBuffer = 0;
+	}
+	if (m_drawDataBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_drawDataBuffer);
+		m_drawDataBuffer = 0;
+	}
+	if (m_drawCommandBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_drawCommandBuffer);
+		m_drawCommandBuffer = 0;
+	}
+	if (m_instanceDataBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_instanceDataBuffer);
+		m_instanceDataBuffer = 0;
+	}
+	delete m_textureLoader;
+	m_textureLoader = NULL;
+	delete m_textureUploader;
+	m_textureUploader = NULL;
+	DestroyGLTextures();
+	delete m_gpuCulling;
+	m_gpuCulling = NULL;
+	delete m_staticBatches;
+	m_staticBatches = NULL;
+	delete m_meshBuffer;
+	m_meshBuffer = NULL;
+	delete m_sceneGraph;
+	m_sceneGraph = NULL;
+	delete m_staticTree;
+	m_staticTree = NULL;
+	delete m_dynamicTree;
+	m_dynamicTree = NULL;
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		delete m_cellTrees[i];
+	}
+	m_cellTrees.clear();
+	delete m_lightClusters;
+	m_lightClusters = NULL;
+	delete m_workerPool;
+	m_workerPool = NULL;
+	delete m_lightManager;
+	m_lightManager = NULL;
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for creating the OpenGL texture of
+ *  the next available texture slot and queueing its image
+ *  file to be decoded on the loader threads. Until the
+ *  image is uploaded, the texture holds a single gray pixel
+ *  so the draws that use it can already be made. With
+ *  texture arrays the slot reads the placeholder layer of
+ *  the first array instead.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+{
+	TEXTURE_INFO textureInfo;
+	GLuint textureID = 0;
+
+	if (m_loadedTextures == 0)
+	{
+		m_textureLoadStart = std::chrono::high_resolution_clock::now();
+		CreateTextureArrays();
+		// the render context is current, so the upload context
+		// is created sharing its textures
+		m_textureUploader->Start(glfwGetCurrentContext());
+		m_textureLoader->SetSupportedFormats(GetSupportedTextureFormats());
+	}
+
+	if ((m_bUseTextureArrays == false) && (m_loadedTextures >= MAX_TEXTURE_SLOTS))
+	{
+		std::cout << "Could not load image:" << filename
+			<< ", all " << MAX_TEXTURE_SLOTS << " texture slots are used" << std::endl;
+		return false;
+	}
+
+	if (m_bUseTextureArrays == false)
+	{
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+	}
+
+	// register the texture and associate it with the special
+	// tag string, the slot does not change once it is loaded
+	textureInfo.tag = tag;
+	textureInfo.ID = textureID;
+	textureInfo.width = 1;
+	textureInfo.height = 1;
+	textureInfo.internalFormat = GL_RGBA8;
+	textureInfo.levelCount = 1;
+	textureInfo.arrayIndex = 0;
+	textureInfo.layer = 0;
+	m_textureIDs.push_back(textureInfo);
+	m_textureLoader->RequestImage(m_loadedTextures, filename);
+	m_loadedTextures++;
+
+	return true;
+}
+
+/***********************************************************
+ *  CreateTextureArrays()
+ *
+ *  This method is used for choosing how the draws select
+ *  their texture. With OpenGL 4.3 and a shader that
+ *  declares:
+ *
+ *    uniform bool bUseTextureArrays;
+ *    uniform sampler2DArray objectTextureArray;
+ *    uniform int textureLayer;
+ *
+ *  the loaded textures are copied into texture arrays by
+ *  size and format, and a draw reads
+ *  texture(objectTextureArray, vec3(uv, textureLayer)), or
+ *  the textureLayer of its DrawData in a multi-draw. There
+ *  is then no limit on the number of textures, and the
+ *  draws of every texture in one array can be made by one
+ *  multi-draw. Otherwise each texture keeps its own unit.
+ ***********************************************************/
+void SceneManager::CreateTextureArrays()
+{
+	m_bUseTextureArrays = false;
+	if ((NULL == m_pShaderUniforms) ||
+		(m_pShaderUniforms->HasUniform(UNIFORM_USE_TEXTURE_ARRAYS) == false) ||
+		(m_pShaderUniforms->HasUniform(UNIFORM_OBJECT_TEXTURE_ARRAY) == false) ||
+		(m_pShaderUniforms->HasUniform(UNIFORM_TEXTURE_LAYER) == false))
+	{
+		std::cout << "INFO: Texture arrays not available, shader has no objectTextureArray, "
+			<< MAX_TEXTURE_SLOTS << " texture slots" << std::endl;
+		return;
+	}
+
+	m_textureArrays = new TextureArraySet();
+	if (m_textureArrays->Initialize() == false)
+	{
+		std::cout << "INFO: Texture arrays not available, copies between textures are not supported, "
+			<< MAX_TEXTURE_SLOTS << " texture slots" << std::endl;
+		delete m_textureArrays;
+		m_textureArrays = NULL;
+		return;
+	}
+	m_bUseTextureArrays = true;
+
+	std::cout << "INFO: Texture arrays available, up to " << MAX_TEXTURE_ARRAYS
+		<< " texture sizes and formats" << std::endl;
+}
+
+/***********************************************************
+ *  UploadGLTexture()
+ *
+ *  This method is used for sending the mip levels of a
+ *  decoded image to a new texture on the render thread,
+ *  when there is no upload thread. The texture then takes
+ *  the place of the placeholder the same way as a texture
+ *  built by the upload thread.
+ ***********************************************************/
+GLuint SceneManager::UploadGLTexture(DECODED_IMAGE& image)
+{
+	const GLenum format = GetTexturePixelFormat(image.format);
+	const GLenum internalFormat = GetTextureInternalFormat(image.format);
+	GLuint textureID = 0;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levelCount - 1);
+
+	// the rows of the small RGB levels are not padded to four
+	// bytes, the OpenGL default
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (int level = 0; level < image.levelCount; level++)
+	{
+		if (IsCompressedTextureFormat(image.format) == true)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, image.levels[level].width, image.levels[level].height, 0,
+				(GLsizei)image.levels[level].size, image.texels + image.levels[level].offset);
+		}
+		else
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, image.levels[level].width, image.levels[level].height, 0,
+				format, GL_UNSIGNED_BYTE, image.texels + image.levels[level].offset);
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  InstallTexture()
+ *
+ *  This method is used for putting an uploaded texture in
+ *  place of the placeholder of its slot. With texture
+ *  arrays the texture is copied into a layer of the array
+ *  for its size and format and deleted, otherwise it is
+ *  bound on the unit of its slot.
+ ***********************************************************/
+void SceneManager::InstallTexture(int slot, GLuint textureID)
+{
+	TEXTURE_INFO& textureInfo = m_textureIDs[slot];
+
+	if (m_bUseTextureArrays == true)
+	{
+		TEXTURE_ARRAY_FORMAT format;
+		int layer = 0;
+		int arrayIndex = -1;
+
+		format.width = textureInfo.width;
+		format.height = textureInfo.height;
+		format.internalFormat = textureInfo.internalFormat;
+		format.levelCount = textureInfo.levelCount;
+		arrayIndex = m_textureArrays->AddTexture(textureID, format, layer);
+		glDeleteTextures(1, &textureID);
+		// the placeholder layer is kept when no array has room
+		if (arrayIndex >= 0)
+		{
+			textureInfo.arrayIndex = arrayIndex;
+			textureInfo.layer = layer;
+			m_textureLayout++;
+		}
+		return;
+	}
+
+	glDeleteTextures(1, &textureInfo.ID);
+	textureInfo.ID = textureID;
+	glActiveTexture(GL_TEXTURE0 + slot);
+	glBindTexture(GL_TEXTURE_2D, textureInfo.ID);
+}
+
+/***********************************************************
+ *  UploadDecodedTextures()
+ *
+ *  This method is used for passing the images decoded since
+ *  the last frame to the upload thread, or uploading a few
+ *  per frame here when there is none. A texture built by
+ *  the upload thread replaces the placeholder of its slot
+ *  once its fence has been passed. The time from the first
+ *  request to the last texture is reported once every
+ *  requested image is in, along with how many came from the
+ *  texture cache.
+ ***********************************************************/
+void SceneManager::UploadDecodedTextures()
+{
+	std::vector<DECODED_IMAGE> images;
+	std::vector<UPLOADED_TEXTURE> textures;
+	const bool bUploadThread = m_textureUploader->IsRunning();
+	TEXTURE_UPLOAD_STATS uploadStats;
+
+	m_textureLoader->TakeDecodedImages(images, (bUploadThread == true) ? MAX_TEXTURE_SLOTS : TEXTURE_UPLOADS_PER_FRAME);
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		if (CheckDecodedImage(images[i]) == false)
+		{
+			// the placeholder is kept when the image is unusable
+			AsyncTextureLoader::FreeDecodedImage(images[i]);
+		}
+		else if (bUploadThread == true)
+		{
+			RecordTextureImage(images[i]);
+			// the upload thread frees the texels
+			m_textureUploader->QueueImage(images[i]);
+		}
+		else
+		{
+			UPLOADED_TEXTURE texture;
+
+			RecordTextureImage(images[i]);
+			texture.requestID = images[i].requestID;
+			texture.textureID = UploadGLTexture(images[i]);
+			textures.push_back(texture);
+			AsyncTextureLoader::FreeDecodedImage(images[i]);
+		}
+	}
+
+	if (bUploadThread == true)
+	{
+		m_textureUploader->TakeFinishedTextures(textures);
+	}
+	for (size_t i = 0; i < textures.size(); i++)
+	{
+		InstallTexture(textures[i].requestID, textures[i].textureID);
+	}
+	if (textures.empty() == false)
+	{
+		// an array that grew is a new texture object, and the
+		// first unit held the new textures while they were
+		// uploaded
+		BindGLTextures();
+	}
+
+	if ((images.empty() == true) && (textures.empty() == true))
+	{
+		return;
+	}
+	uploadStats = m_textureUploader->GetStats();
+	if ((m_textureLoader->GetPendingCount() == 0) && (uploadStats.queuedImages == 0))
+	{
+		const int cachedCount = m_textureLoader->GetCachedImageCount();
+
+		std::cout << "INFO: " << m_loadedTextures << " textures loaded on "
+			<< m_textureLoader->GetThreadCount() << " threads in "
+			<< std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - m_textureLoadStart).count()
+			<< " ms, " << ((cachedCount == 0) ? "cold" : "warm") << " start with "
+			<< cachedCount << " from the texture cache, "
+			<< m_textureMemoryBytes / (1024.0 * 1024.0) << " MB of texture memory ("
+			<< m_uncompressedTextureBytes / (1024.0 * 1024.0) << " MB uncompressed)";
+		if (m_bUseTextureArrays == true)
+		{
+			// the placeholder array is not counted
+			std::cout << ", in " << m_textureArrays->GetArrayCount() - 1 << " texture arrays";
+		}
+		if (bUploadThread == true)
+		{
+			std::cout << ", uploaded at " << uploadStats.megabytesPerSecond << " MB/s on the upload thread";
+		}
+		std::cout << std::endl;
+	}
+}
+
+/***********************************************************
+ *  GetSupportedTextureFormats()
+ *
+ *  This method is used for getting the texel formats the
+ *  driver can sample, one bit for each TEXTURE_FORMAT. The
+ *  block compressed formats come with extensions, BC1 and
+ *  BC3 with S3TC, which nearly every desktop driver has,
+ *  and BC7 with BPTC, which is core in OpenGL 4.2.
+ ***********************************************************/
+uint32_t SceneManager::GetSupportedTextureFormats() const
+{
+	uint32_t formatMask = (1u << TEXTURE_FORMAT_RGB8) | (1u << TEXTURE_FORMAT_RGBA8);
+
+	if (GLEW_EXT_texture_compression_s3tc)
+	{
+		formatMask |= (1u << TEXTURE_FORMAT_BC1) | (1u << TEXTURE_FORMAT_BC3);
+	}
+	if (GLEW_ARB_texture_compression_bptc)
+	{
+		formatMask |= (1u << TEXTURE_FORMAT_BC7);
+	}
+
+	return(formatMask);
+}
+
+/***********************************************************
+ *  RecordTextureImage()
+ *
+ *  This method is used for keeping the size and format of
+ *  an image in the info of its slot, which pick the texture
+ *  array it goes into, and for counting the memory its
+ *  levels take as a texture, next to the memory they would
+ *  take uncompressed, to show what block compression saves.
+ ***********************************************************/
+void SceneManager::RecordTextureImage(const DECODED_IMAGE& image)
+{
+	TEXTURE_INFO& textureInfo = m_textureIDs[image.requestID];
+	TEXTURE_LEVEL uncompressedLevels[MAX_TEXTURE_LEVELS];
+	uint64_t uncompressedBytes = 0;
+
+	textureInfo.width = image.width;
+	textureInfo.height = image.height;
+	textureInfo.internalFormat = GetTextureInternalFormat(image.format);
+	textureInfo.levelCount = image.levelCount;
+
+	m_textureMemoryBytes += image.levels[image.levelCount - 1].offset + image.levels[image.levelCount - 1].size;
+	GetTextureLevels(image.width, image.height, GetUncompressedTextureFormat(image.channels), uncompressedLevels, uncompressedBytes);
+	m_uncompressedTextureBytes += uncompressedBytes;
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  With texture arrays each array is bound on its own unit
+ *  instead.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	if (m_bUseTextureArrays == true)
+	{
+		m_textureArrays->BindArrays();
+		return;
+	}
+
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		// bind textures on corresponding texture units
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		glDeleteTextures(1, &m_textureIDs[i].ID);
+		m_textureIDs[i].ID = 0;
+	}
+	m_textureIDs.clear();
+	m_loadedTextures = 0;
+	delete m_textureArrays;
+	m_textureArrays = NULL;
+	m_bUseTextureArrays = false;
+}
+
+/***********************************************************
+ *  InternSceneTags()
+ *
+ *  This method is used for turning the tags of the loaded
+ *  textures and the defined materials into small integer
+ *  handles, the texture slot and the material index. It is
+ *  called once after the textures and materials are ready so
+ *  the lookups on the draw path are a single table probe.
+ ***********************************************************/
+void SceneManager::InternSceneTags()
+{
+	m_textureTags.Reset(m_loadedTextures);
+	for (int index = 0; index < m_loadedTextures; index++)
+	{
+		if (m_textureTags.Insert(HashSceneTag(m_textureIDs[index].tag.c_str()), m_textureIDs[index].tag, index) == false)
+		{
+			std::cout << "Texture tag is defined twice:"
+				<< m_textureIDs[index].tag << std::endl;
+		}
+	}
+
+	m_materialTags.Reset((int)m_objectMaterials.size());
+	for (int index = 0; index < (int)m_objectMaterials.size(); index++)
+	{
+		if (m_materialTags.Insert(HashSceneTag(m_objectMaterials[index].tag.c_str()), m_objectMaterials[index].tag, index) == false)
+		{
+			std::cout << "Material tag is defined twice:"
+				<< m_objectMaterials[index].tag << std::endl;
+		}
+	}
+}
+
+/***********************************************************
+ *  ReportMissingTag()
+ *
+ *  This method is used for reporting a texture or material
+ *  tag that could not be found. Each tag is only reported
+ *  once so the draw path does not flood the console.
+ ***********************************************************/
+void SceneManager::ReportMissingTag(const char* tagType, const SceneTag& tag)
+{
+	for (size_t i = 0; i < m_reportedTags.size(); i++)
+	{
+		if (m_reportedTags[i] == tag.hash)
+		{
+			return;
+		}
+	}
+	m_reportedTags.push_back(tag.hash);
+
+	std::cout << "Could not find " << tagType << " tag:" << tag.name << std::endl;
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ *  With texture arrays it is the array that holds it.
+ ***********************************************************/
+int SceneManager::FindTextureID(const SceneTag& tag)
+{
+	int textureSlot = FindTextureSlot(tag);
+
+	if (textureSlot < 0)
+	{
+		return(-1);
+	}
+	if (m_bUseTextureArrays == true)
+	{
+		return(m_textureArrays->GetArrayTexture(m_textureIDs[textureSlot].arrayIndex));
+	}
+
+	return(m_textureIDs[textureSlot].ID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const SceneTag& tag)
+{
+	int textureSlot = m_textureTags.Find(tag);
+
+	if (textureSlot < 0)
+	{
+		ReportMissingTag("texture", tag);
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const SceneTag& tag, OBJECT_MATERIAL& material)
+{
+	int index = FindMaterialIndex(tag);
+
+	if (index < 0)
+	{
+		return(false);
+	}
+
+	material = m_objectMaterials[index];
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the index of a material
+ *  in the defined materials list that is associated with the
+ *  passed in tag, or -1 when the tag is not defined.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const SceneTag& tag)
+{
+	int index = m_materialTags.Find(tag);
+
+	if (index < 0)
+	{
+		ReportMissingTag("material", tag);
+	}
+
+	return(index);
+}
+
+/***********************************************************
+ *  BuildTransformations()
+ *
+ *  This method is used for gathering the passed in
+ *  transformation values into transform values. The model
+ *  matrix is built from them by the transform table.
+ ***********************************************************/
+TRANSFORM_VALUES SceneManager::BuildTransformations(
+	glm::vec3 scaleXYZ,
+	const glm::quat& rotation,
+	glm::vec3 positionXYZ)
+{
+	TRANSFORM_VALUES values;
+
+	values.scale = scaleXYZ;
+	values.rotation = rotation;
+	values.position = positionXYZ;
+
+	return(values);
+}
+
+/***********************************************************
+ *  BuildTransformations()
+ *
+ *  This method is used for gathering the passed in
+ *  transformation values into transform values, with the
+ *  rotation about each axis in degrees. The angles are
+ *  turned into a quaternion here, once, when the scene is
+ *  defined.
+ ***********************************************************/
+TRANSFORM_VALUES SceneManager::BuildTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	return(BuildTransformations(
+		scaleXYZ,
+		TransformTable::EulerToQuaternion(glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees)),
+		positionXYZ));
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform of the
+ *  next drawn mesh using the passed in transformation
+ *  values. Its model matrix is built later, together with
+ *  those of the other scene objects.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	const glm::quat& rotation,
+	glm::vec3 positionXYZ)
+{
+	m_drawTransform = BuildTransformations(
+		scaleXYZ,
+		rotation,
+		positionXYZ);
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform of the
+ *  next drawn mesh, with the rotation about each axis in
+ *  degrees.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	m_drawTransform = BuildTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+}
+
+/***********************************************************
+ *  PushSceneNode()
+ *
+ *  This method is used for opening a group node under the
+ *  node that is currently open. The meshes and nodes added
+ *  until the matching PopSceneNode() are placed relative to
+ *  it, so moving the group later is one node change. The
+ *  world matrix of the group is kept while it is open, for
+ *  the meshes merged into the static batches.
+ ***********************************************************/
+int SceneManager::PushSceneNode(
+	const SceneTag& nodeTag,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	const TRANSFORM_VALUES local = BuildTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	glm::mat4 world = TransformTable::ComputeModel(local);
+	int node = -1;
+
+	if (m_openNodes.empty() == false)
+	{
+		world = m_openNodeWorlds.back() * world;
+	}
+	node = m_sceneGraph->AddNode((m_openNodes.empty() == true) ? -1 : m_openNodes.back(), local);
+	m_nodeObjects.push_back(-1);
+	m_nodeTags.push_back(nodeTag.hash);
+	m_openNodes.push_back(node);
+	m_openNodeWorlds.push_back(world);
+
+	return(node);
+}
+
+/***********************************************************
+ *  PopSceneNode()
+ *
+ *  This method is used for closing the group node opened
+ *  last, the meshes added after it are placed relative to
+ *  its parent again.
+ ***********************************************************/
+void SceneManager::PopSceneNode()
+{
+	if (m_openNodes.empty() == true)
+	{
+		std::cout << "ERROR::SCENE_GRAPH: PopSceneNode() without an open scene node" << std::endl;
+		return;
+	}
+
+	m_openNodes.pop_back();
+	m_openNodeWorlds.pop_back();
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  for the next drawn mesh
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	m_drawState.bUseTexture = false;
+	m_drawState.color = currentColor;
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture associated
+ *  with the passed in tag for the next drawn mesh.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	const SceneTag& textureTag)
+{
+	m_drawState.bUseTexture = true;
+	m_drawState.textureSlot = FindTextureSlot(textureTag);
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values for the next drawn mesh.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	m_drawState.uvScale = glm::vec2(u, v);
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for setting the material associated
+ *  with the passed in tag for the next drawn mesh. When the
+ *  tag is not defined the previous material is kept.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	const SceneTag& materialTag)
+{
+	int materialIndex = FindMaterialIndex(materialTag);
+
+	if (materialIndex >= 0)
+	{
+		m_drawState.materialIndex = materialIndex;
+	}
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used for adding an object that uses one
+ *  of the basic shape meshes, with the current
+ *  transformation, color, texture, material and UV scale,
+ *  to the scene. The world bounds of the object are taken
+ *  from the mesh bounds and the model matrix, once the
+ *  matrices of all the objects are built. The visible
+ *  objects are drawn every frame by RenderScene(). While
+ *  the static batches are recorded the mesh is merged into
+ *  a batch instead of becoming a scene object.
+ ***********************************************************/
+void SceneManager::DrawMesh(MESH_TYPE mesh)
+{
+	SCENE_OBJECT object;
+
+	m_drawState.mesh = mesh;
+	if (m_bRecordStaticBatches == true)
+	{
+		STATIC_BATCH_STATE state;
+		STATIC_BATCH_ITEM item;
+
+		state.color = m_drawState.color;
+		state.textureSlot = (m_drawState.bUseTexture == true) ? m_drawState.textureSlot : -1;
+		state.materialIndex = m_drawState.materialIndex;
+		item.mesh = (int)mesh;
+		item.model = TransformTable::ComputeModel(m_drawTransform);
+		if (m_openNodeWorlds.empty() == false)
+		{
+			item.model = m_openNodeWorlds.back() * item.model;
+		}
+		item.uvScale = m_drawState.uvScale;
+		m_staticBatches->AddItem(state, item);
+		return;
+	}
+
+	// the object gets a node under the open group node, the
+	// model matrix and bounds are filled once all objects are
+	// added
+	m_objectNodes.push_back(m_sceneGraph->AddNode(
+		(m_openNodes.empty() == true) ? -1 : m_openNodes.back(),
+		m_drawTransform));
+	m_nodeObjects.push_back((int)m_sceneObjects.size());
+	m_nodeTags.push_back(0);
+	object.packet = m_drawState;
+	object.bounds = g_MeshBounds[mesh];
+	object.bDynamic = false;
+	object.cell = -1;
+	m_sceneObjects.push_back(object);
+}
+
+/***********************************************************
+ *  DrawMeshInstanced()
+ *
+ *  This method is used for adding copies of one of the
+ *  basic shape meshes to the scene, one for each passed in
+ *  model matrix, with the current color, texture, material
+ *  and UV scale. The matrices are relative to the open
+ *  group node like SetTransformations(), but the copies are
+ *  placed once and do not get scene graph nodes. All of
+ *  them are drawn by DrawInstanceGroups() with a single
+ *  draw call when the group is inside the view frustum.
+ ***********************************************************/
+void SceneManager::DrawMeshInstanced(MESH_TYPE mesh, const glm::mat4* models, int count)
+{
+	INSTANCE_GROUP group;
+	MESH_INSTANCE instance;
+
+	if ((NULL == models) || (count <= 0))
+	{
+		return;
+	}
+
+	group.object.packet = m_drawState;
+	group.object.packet.mesh = mesh;
+	group.object.bDynamic = false;
+	group.firstInstance = (int)m_meshInstances.size();
+	group.instanceCount = count;
+
+	for (int i = 0; i < count; i++)
+	{
+		instance.model = models[i];
+		if (m_openNodeWorlds.empty() == false)
+		{
+			instance.model = m_openNodeWorlds.back() * instance.model;
+		}
+		instance.normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.model)));
+		m_meshInstances.push_back(instance);
+
+		if (i == 0)
+		{
+			group.object.bounds = TransformBoundingBox(g_MeshBounds[mesh], instance.model);
+		}
+		else
+		{
+			MergeBoundingBox(group.object.bounds, TransformBoundingBox(g_MeshBounds[mesh], instance.model));
+		}
+	}
+	group.object.cell = FindContainingCell(group.object.bounds);
+	m_instanceGroups.push_back(group);
+}
+
+/***********************************************************
+ *  DrawSphereMeshInstanced()
+ *
+ *  This method is used for adding copies of the sphere
+ *  mesh, one for each passed in model matrix.
+ ***********************************************************/
+void SceneManager::DrawSphereMeshInstanced(const glm::mat4* models, int count)
+{
+	DrawMeshInstanced(MESH_SPHERE, models, count);
+}
+
+/***********************************************************
+ *  DrawConeMeshInstanced()
+ *
+ *  This method is used for adding copies of the cone mesh,
+ *  one for each passed in model matrix.
+ ***********************************************************/
+void SceneManager::DrawConeMeshInstanced(const glm::mat4* models, int count)
+{
+	DrawMeshInstanced(MESH_CONE, models, count);
+}
+
+/***********************************************************
+ *  BuildSceneObjects()
+ *
+ *  This method is used for adding every object of the scene
+ *  once, by calling the individual render functions, and
+ *  then building the bounding volume trees over them. The
+ *  floor and walls go into the static batches.
+ ***********************************************************/
+void SceneManager::BuildSceneObjects()
+{
+	int cellObjects = 0;
+
+	m_sceneObjects.clear();
+	m_sceneGraph->Clear();
+	m_objectNodes.clear();
+	m_nodeObjects.clear();
+	m_nodeTags.clear();
+	m_instanceGroups.clear();
+	m_meshInstances.clear();
+	DefinePortalCells();
+
+	// the floor and walls never move, they are merged
+	// instead of culled one by one
+	RecordStaticBatches();
+	RenderQuadrantOne();
+	RenderQuadrantTwo();
+	RenderQuadrantThree();
+	RenderQuadrantFour();
+	if (m_openNodes.empty() == false)
+	{
+		std::cout << "ERROR::SCENE_GRAPH: " << m_openNodes.size()
+			<< " scene nodes were not closed by PopSceneNode()" << std::endl;
+		m_openNodes.clear();
+		m_openNodeWorlds.clear();
+	}
+
+	// build every world matrix in one pass over the scene
+	// graph, then place the objects with them
+	m_sceneGraph->UpdateWorldMatrices();
+	for (size_t i = 0; i < m_sceneObjects.size(); i++)
+	{
+		SCENE_OBJECT& object = m_sceneObjects[i];
+
+		object.packet.model = m_sceneGraph->GetWorld(m_objectNodes[i]);
+		object.packet.normalMatrix = m_sceneGraph->GetWorldNormalMatrix(m_objectNodes[i]);
+		object.bounds = TransformBoundingBox(g_MeshBounds[object.packet.mesh], object.packet.model);
+		object.cell = FindContainingCell(object.bounds);
+	}
+
+	m_meshBuffer->SetInstances(m_meshInstances);
+
+	m_bRebuildTrees = true;
+	UpdateSceneTrees();
+
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		cellObjects += m_cellTrees[i]->GetItemCount();
+	}
+	std::cout << "INFO: " << m_sceneObjects.size() << " scene objects in a bounding volume tree of "
+		<< m_staticTree->GetNodeCount() << " nodes" << std::endl;
+	std::cout << "INFO: " << cellObjects << " scene objects inside " << m_cellTrees.size()
+		<< " portal cells" << std::endl;
+	std::cout << "INFO: " << m_meshInstances.size() << " mesh instances in "
+		<< m_instanceGroups.size() << " instanced draws" << std::endl;
+	std::cout << "INFO: " << m_sceneGraph->GetNodeCount() << " scene graph nodes, transforms built with the "
+		<< GetTransformKernelName(m_sceneGraph->GetKernel()) << " kernel" << std::endl;
+}
+
+/***********************************************************
+ *  CreateStaticBatches()
+ *
+ *  This method is used for creating the static batches and
+ *  giving them the geometry of the basic shape meshes, in
+ *  the same order as MESH_TYPE.
+ ***********************************************************/
+void SceneManager::CreateStaticBatches()
+{
+	MESH_GEOMETRY geometry;
+
+	m_staticBatches = new StaticBatchSet();
+	for (int i = 0; i < MESH_TYPE_COUNT; i++)
+	{
+		GenerateBasicMesh((MESH_TYPE)i, 0, geometry);
+		m_staticBatches->AddSourceMesh(geometry);
+	}
+}
+
+/***********************************************************
+ *  RecordStaticBatches()
+ *
+ *  This method is used for adding the floor, the outer
+ *  walls and the dividers to the static batches, by calling
+ *  their render functions while the batches are recorded.
+ *  Without static batches they are added as scene objects.
+ ***********************************************************/
+void SceneManager::RecordStaticBatches()
+{
+	int bakedCount = 0;
+
+	if (NULL != m_staticBatches)
+	{
+		m_staticBatches->BeginBatches();
+		m_bRecordStaticBatches = true;
+	}
+
+	RenderFloor();
+	RenderWalls();
+	RenderQuadrantWalls();
+
+	if (NULL != m_staticBatches)
+	{
+		m_bRecordStaticBatches = false;
+		bakedCount = m_staticBatches->EndBatches();
+		std::cout << "INFO: " << bakedCount << " of " << m_staticBatches->GetBatchCount()
+			<< " static batches merged" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  RebuildStaticBatches()
+ *
+ *  This method is used for merging the floor and walls
+ *  again after their render functions were changed. Only
+ *  the batches whose meshes changed are sent again.
+ ***********************************************************/
+void SceneManager::RebuildStaticBatches()
+{
+	DRAW_PACKET drawState = m_drawState;
+
+	RecordStaticBatches();
+	// the next recorded object starts from the same state
+	m_drawState = drawState;
+}
+
+/***********************************************************
+ *  DrawStaticBatches()
+ *
+ *  This method is used for drawing the static batches that
+ *  are inside the view frustum, each with one draw call.
+ *  Their vertices are already in world space, so they are
+ *  drawn with the identity model matrix.
+ ***********************************************************/
+void SceneManager::DrawStaticBatches(DRAW_STATS& batchStats)
+{
+	ResetDrawStats(batchStats);
+	if ((NULL == m_staticBatches) || (NULL == m_pShaderUniforms))
+	{
+		return;
+	}
+
+	m_appliedMaterialIndex = -1;
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_DRAW_DATA, false);
+	m_pShaderUniforms->setMat4Value(UNIFORM_MODEL, glm::mat4(1.0f));
+	m_pShaderUniforms->setMat3Value(UNIFORM_NORMAL_MATRIX, glm::mat3(1.0f));
+	m_pShaderUniforms->setVec2Value(UNIFORM_UV_SCALE, glm::vec2(1.0f, 1.0f));
+
+	for (int i = 0; i < m_staticBatches->GetBatchCount(); i++)
+	{
+		const STATIC_BATCH_STATE& state = m_staticBatches->GetBatchState(i);
+
+		if (m_viewFrustum.ClassifyBox(m_staticBatches->GetBatchBounds(i)) == FRUSTUM_OUTSIDE)
+		{
+			continue;
+		}
+
+		m_pShaderUniforms->setVec4Value(UNIFORM_OBJECT_COLOR, state.color);
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_TEXTURE, state.textureSlot != -1);
+		if (state.textureSlot != -1)
+		{
+			ApplyTexture(state.textureSlot);
+		}
+		if ((state.materialIndex >= 0) && (state.materialIndex != m_appliedMaterialIndex))
+		{
+			ApplyMaterial(state.materialIndex);
+		}
+		m_pShaderUniforms->ApplyPendingValues();
+
+		m_staticBatches->DrawBatch(i);
+		batchStats.objectDraws += m_staticBatches->GetBatchItemCount(i);
+		batchStats.drawCalls++;
+		// the batched meshes are not curved
+		batchStats.levelTriangles[0] += m_staticBatches->GetBatchTriangleCount(i);
+	}
+}
+
+/***********************************************************
+ *  DrawInstanceGroups()
+ *
+ *  This method is used for drawing the instanced meshes
+ *  whose group is inside the view frustum and not in a
+ *  hidden cell, each group with one draw call that reads
+ *  the model and normal matrices per instance. A shader
+ *  without the instance attributes gets the copies one by
+ *  one through the model uniform instead.
+ ***********************************************************/
+void SceneManager::DrawInstanceGroups(DRAW_STATS& instanceStats)
+{
+	bool bInstanced = false;
+
+	ResetDrawStats(instanceStats);
+	if ((NULL == m_pShaderUniforms) || (m_instanceGroups.empty() == true))
+	{
+		return;
+	}
+
+	bInstanced = m_pShaderUniforms->HasUniform(UNIFORM_USE_INSTANCE_DATA);
+	m_appliedMaterialIndex = -1;
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_DRAW_DATA, false);
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_INSTANCE_DATA, bInstanced);
+	m_meshBuffer->Bind();
+
+	for (size_t i = 0; i < m_instanceGroups.size(); i++)
+	{
+		INSTANCE_GROUP& group = m_instanceGroups[i];
+		DRAW_PACKET& packet = group.object.packet;
+		int mesh = 0;
+
+		if (((group.object.cell != -1) && ((m_visibleCells & (1u << group.object.cell)) == 0)) ||
+			(m_viewFrustum.ClassifyBox(group.object.bounds) == FRUSTUM_OUTSIDE))
+		{
+			continue;
+		}
+
+		packet.lod = SelectMeshLod(group.object);
+		mesh = GetLodMesh(packet);
+		m_pShaderUniforms->setVec4Value(UNIFORM_OBJECT_COLOR, packet.color);
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_TEXTURE, packet.bUseTexture);
+		if (packet.bUseTexture == true)
+		{
+			ApplyTexture(packet.textureSlot);
+		}
+		m_pShaderUniforms->setVec2Value(UNIFORM_UV_SCALE, packet.uvScale);
+		if ((packet.materialIndex >= 0) && (packet.materialIndex != m_appliedMaterialIndex))
+		{
+			ApplyMaterial(packet.materialIndex);
+		}
+
+		if (bInstanced == true)
+		{
+			m_pShaderUniforms->ApplyPendingValues();
+			m_meshBuffer->DrawMeshInstanced(mesh, group.firstInstance, group.instanceCount);
+			instanceStats.drawCalls++;
+		}
+		else
+		{
+			for (int j = 0; j < group.instanceCount; j++)
+			{
+				const MESH_INSTANCE& instance = m_meshInstances[group.firstInstance + j];
+
+				m_pShaderUniforms->setMat4Value(UNIFORM_MODEL, instance.model);
+				m_pShaderUniforms->setMat3Value(UNIFORM_NORMAL_MATRIX, instance.normalMatrix);
+				m_pShaderUniforms->ApplyPendingValues();
+				m_meshBuffer->DrawMesh(mesh);
+			}
+			instanceStats.drawCalls += group.instanceCount;
+		}
+		instanceStats.objectDraws += group.instanceCount;
+		instanceStats.levelTriangles[packet.lod] += group.instanceCount * (int)(m_meshBuffer->GetMeshRange(mesh).indexCount / 3);
+	}
+
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_INSTANCE_DATA, false);
+	m_meshBuffer->Unbind();
+}
+
+/***********************************************************
+ *  DefinePortalCells()
+ *
+ *  This method is used for defining the cells used to skip
+ *  the quadrants that cannot be seen. Each quadrant between
+ *  the outer walls and the dividers is a cell, up to the
+ *  height of the walls. The dividers stop short of the
+ *  middle of the room, and each of those gaps is a portal
+ *  between the two quadrants on either side of it.
+ ***********************************************************/
+void SceneManager::DefinePortalCells()
+{
+	BOUNDING_BOX cellBounds;
+	glm::vec3 corners[4];
+	int frontRight, frontLeft, backRight, backLeft;
+
+	m_portalCells.Clear();
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		delete m_cellTrees[i];
+	}
+	m_cellTrees.clear();
+
+	// quadrant cells, inside the outer walls
+	cellBounds.minPoint = glm::vec3(0.0f, -1.0f, 0.0f);
+	cellBounds.maxPoint = glm::vec3(95.0f, 20.0f, 75.0f);
+	frontRight = m_portalCells.AddCell(cellBounds);
+	cellBounds.minPoint = glm::vec3(-95.0f, -1.0f, 0.0f);
+	cellBounds.maxPoint = glm::vec3(0.0f, 20.0f, 75.0f);
+	frontLeft = m_portalCells.AddCell(cellBounds);
+	cellBounds.minPoint = glm::vec3(0.0f, -1.0f, -115.0f);
+	cellBounds.maxPoint = glm::vec3(95.0f, 20.0f, 0.0f);
+	backRight = m_portalCells.AddCell(cellBounds);
+	cellBounds.minPoint = glm::vec3(-95.0f, -1.0f, -115.0f);
+	cellBounds.maxPoint = glm::vec3(0.0f, 20.0f, 0.0f);
+	backLeft = m_portalCells.AddCell(cellBounds);
+
+	// gap between the middle and the front divider
+	corners[0] = glm::vec3(0.0f, 0.0f, 0.0f);
+	corners[1] = glm::vec3(0.0f, 0.0f, 25.0f);
+	corners[2] = glm::vec3(0.0f, 20.0f, 25.0f);
+	corners[3] = glm::vec3(0.0f, 20.0f, 0.0f);
+	m_portalCells.AddPortal(frontRight, frontLeft, corners);
+
+	// gap between the middle and the back divider
+	corners[0] = glm::vec3(0.0f, 0.0f, -65.0f);
+	corners[1] = glm::vec3(0.0f, 0.0f, 0.0f);
+	corners[2] = glm::vec3(0.0f, 20.0f, 0.0f);
+	corners[3] = glm::vec3(0.0f, 20.0f, -65.0f);
+	m_portalCells.AddPortal(backRight, backLeft, corners);
+
+	// gap between the middle and the left divider
+	corners[0] = glm::vec3(-45.0f, 0.0f, 0.0f);
+	corners[1] = glm::vec3(0.0f, 0.0f, 0.0f);
+	corners[2] = glm::vec3(0.0f, 20.0f, 0.0f);
+	corners[3] = glm::vec3(-45.0f, 20.0f, 0.0f);
+	m_portalCells.AddPortal(frontLeft, backLeft, corners);
+
+	// gap between the middle and the right divider
+	corners[0] = glm::vec3(0.0f, 0.0f, 0.0f);
+	corners[1] = glm::vec3(45.0f, 0.0f, 0.0f);
+	corners[2] = glm::vec3(45.0f, 20.0f, 0.0f);
+	corners[3] = glm::vec3(0.0f, 20.0f, 0.0f);
+	m_portalCells.AddPortal(frontRight, backRight, corners);
+
+	for (int i = 0; i < m_portalCells.GetCellCount(); i++)
+	{
+		m_cellTrees.push_back(new BoundingVolumeHierarchy(m_workerPool));
+	}
+	m_cullingStats.cellCount = m_portalCells.GetCellCount();
+}
+
+/***********************************************************
+ *  FindContainingCell()
+ *
+ *  This method is used for getting the cell that holds the
+ *  whole of a box. Objects that reach into more than one
+ *  cell, like the floor and the walls, get -1 and are drawn
+ *  whenever they are inside the view frustum.
+ ***********************************************************/
+int SceneManager::FindContainingCell(const BOUNDING_BOX& bounds) const
+{
+	int cell = m_portalCells.FindCell(bounds.minPoint);
+
+	if ((cell == -1) || (m_portalCells.FindCell(bounds.maxPoint) != cell))
+	{
+		return(-1);
+	}
+
+	return(cell);
+}
+
+/***********************************************************
+ *  UpdateSceneTrees()
+ *
+ *  This method is used for keeping the bounding volume trees
+ *  in step with the scene objects. When an object first
+ *  moves, it leaves the static tree and both trees are
+ *  rebuilt. Later moves only refit the dynamic tree, until
+ *  the refit tree costs twice as much as a fresh build.
+ ***********************************************************/
+void SceneManager::UpdateSceneTrees()
+{
+	if (m_bRebuildTrees == true)
+	{
+		std::vector<BOUNDING_BOX> staticBounds;
+		std::vector<int> staticObjects;
+		std::vector<std::vector<BOUNDING_BOX> > cellBounds(m_cellTrees.size());
+		std::vector<std::vector<int> > cellObjects(m_cellTrees.size());
+
+		m_dynamicObjects.clear();
+		m_dynamicBounds.clear();
+		for (int i = 0; i < (int)m_sceneObjects.size(); i++)
+		{
+			if (m_sceneObjects[i].bDynamic == true)
+			{
+				m_dynamicObjects.push_back(i);
+				m_dynamicBounds.push_back(m_sceneObjects[i].bounds);
+			}
+			else if (m_sceneObjects[i].cell != -1)
+			{
+				cellObjects[m_sceneObjects[i].cell].push_back(i);
+				cellBounds[m_sceneObjects[i].cell].push_back(m_sceneObjects[i].bounds);
+			}
+			else
+			{
+				staticObjects.push_back(i);
+				staticBounds.push_back(m_sceneObjects[i].bounds);
+			}
+		}
+		m_staticTree->Build(staticBounds, staticObjects);
+		for (size_t i = 0; i < m_cellTrees.size(); i++)
+		{
+			m_cellTrees[i]->Build(cellBounds[i], cellObjects[i]);
+		}
+		m_dynamicTree->Build(m_dynamicBounds, m_dynamicObjects);
+	}
+	else if (m_bRefitDynamicTree == true)
+	{
+		for (size_t i = 0; i < m_dynamicObjects.size(); i++)
+		{
+			m_dynamicBounds[i] = m_sceneObjects[m_dynamicObjects[i]].bounds;
+		}
+		if (m_dynamicTree->Refit(m_dynamicBounds) > 2.0f)
+		{
+			m_dynamicTree->Build(m_dynamicBounds, m_dynamicObjects);
+		}
+	}
+
+	m_bRebuildTrees = false;
+	m_bRefitDynamicTree = false;
+}
+
+/***********************************************************
+ *  GetSceneObjectCount()
+ *
+ *  This method is used for getting the number of objects in
+ *  the scene.
+ ***********************************************************/
+int SceneManager::GetSceneObjectCount() const
+{
+	return((int)m_sceneObjects.size());
+}
+
+/***********************************************************
+ *  SetObjectTransform()
+ *
+ *  This method is used for moving a scene object. Its world
+ *  bounds follow the new model matrix, and the trees are
+ *  updated before the next frame is drawn. The matrix is
+ *  kept until the transform values of the object change.
+ ***********************************************************/
+void SceneManager::SetObjectTransform(int objectID, const glm::mat4& model)
+{
+	SetObjectTransform(objectID, model, glm::transpose(glm::inverse(glm::mat3(model))));
+}
+
+/***********************************************************
+ *  SetObjectTransform()
+ *
+ *  This method is used for moving a scene object to a model
+ *  matrix whose normal matrix was built with it, as by the
+ *  scene graph.
+ ***********************************************************/
+void SceneManager::SetObjectTransform(int objectID, const glm::mat4& model, const glm::mat3& normalMatrix)
+{
+	if ((objectID < 0) || (objectID >= (int)m_sceneObjects.size()))
+	{
+		return;
+	}
+
+	SCENE_OBJECT& object = m_sceneObjects[objectID];
+	object.packet.model = model;
+	object.packet.normalMatrix = normalMatrix;
+	object.bounds = TransformBoundingBox(g_MeshBounds[object.packet.mesh], model);
+	object.cell = FindContainingCell(object.bounds);
+	if (NULL != m_gpuCulling)
+	{
+		m_gpuDirtyObjects.push_back(objectID);
+	}
+	if (object.bDynamic == false)
+	{
+		object.bDynamic = true;
+		m_bRebuildTrees = true;
+	}
+	else
+	{
+		m_bRefitDynamicTree = true;
+	}
+}
+
+/***********************************************************
+ *  UpdateObjectTransforms()
+ *
+ *  This method is used for building the world matrices of
+ *  the scene objects whose position, rotation or scale, or
+ *  that of a group node above them, changed since the last
+ *  frame, and moving the objects to their new matrices.
+ ***********************************************************/
+void SceneManager::UpdateObjectTransforms()
+{
+	if (m_sceneGraph->UpdateWorldMatrices() == 0)
+	{
+		return;
+	}
+
+	const std::vector<int>& updatedNodes = m_sceneGraph->GetUpdatedNodes();
+	for (size_t i = 0; i < updatedNodes.size(); i++)
+	{
+		int objectID = m_nodeObjects[updatedNodes[i]];
+
+		if (objectID != -1)
+		{
+			SetObjectTransform(
+				objectID,
+				m_sceneGraph->GetWorld(updatedNodes[i]),
+				m_sceneGraph->GetWorldNormalMatrix(updatedNodes[i]));
+		}
+	}
+}
+
+/***********************************************************
+ *  SetObjectPosition()
+ *
+ *  This method is used for moving a scene object to a new
+ *  position, relative to the group node it was added under.
+ ***********************************************************/
+void SceneManager::SetObjectPosition(int objectID, const glm::vec3& position)
+{
+	SetNodePosition(GetObjectNode(objectID), position);
+}
+
+/***********************************************************
+ *  SetObjectRotation()
+ *
+ *  This method is used for turning a scene object.
+ ***********************************************************/
+void SceneManager::SetObjectRotation(int objectID, const glm::quat& rotation)
+{
+	SetNodeRotation(GetObjectNode(objectID), rotation);
+}
+
+/***********************************************************
+ *  SetObjectRotation()
+ *
+ *  This method is used for turning a scene object, with the
+ *  rotation about each axis in degrees.
+ ***********************************************************/
+void SceneManager::SetObjectRotation(int objectID, const glm::vec3& rotationDegrees)
+{
+	SetNodeRotation(GetObjectNode(objectID), rotationDegrees);
+}
+
+/***********************************************************
+ *  SetObjectScale()
+ *
+ *  This method is used for scaling a scene object.
+ ***********************************************************/
+void SceneManager::SetObjectScale(int objectID, const glm::vec3& scale)
+{
+	SetNodeScale(GetObjectNode(objectID), scale);
+}
+
+/***********************************************************
+ *  FindSceneNode()
+ *
+ *  This method is used for finding the first group node
+ *  opened with a tag, so the scene code can move a whole
+ *  group after it is defined.
+ ***********************************************************/
+int SceneManager::FindSceneNode(const SceneTag& nodeTag) const
+{
+	for (size_t i = 0; i < m_nodeTags.size(); i++)
+	{
+		if ((m_nodeObjects[i] == -1) && (m_nodeTags[i] == nodeTag.hash))
+		{
+			return((int)i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  GetObjectNode()
+ *
+ *  This method is used for getting the scene graph node
+ *  that holds the transform of a scene object.
+ ***********************************************************/
+int SceneManager::GetObjectNode(int objectID) const
+{
+	if ((objectID < 0) || (objectID >= (int)m_objectNodes.size()))
+	{
+		return(-1);
+	}
+
+	return(m_objectNodes[objectID]);
+}
+
+/***********************************************************
+ *  SetNodePosition()
+ *
+ *  This method is used for moving a node, and every node
+ *  and object below it, to a new position relative to its
+ *  parent.
+ ***********************************************************/
+void SceneManager::SetNodePosition(int node, const glm::vec3& position)
+{
+	m_sceneGraph->SetPosition(node, position);
+}
+
+/***********************************************************
+ *  SetNodeRotation()
+ *
+ *  This method is used for turning a node, and every node
+ *  and object below it.
+ ***********************************************************/
+void SceneManager::SetNodeRotation(int node, const glm::quat& rotation)
+{
+	m_sceneGraph->SetRotation(node, rotation);
+}
+
+/***********************************************************
+ *  SetNodeRotation()
+ *
+ *  This method is used for turning a node, and every node
+ *  and object below it, with the rotation about each axis
+ *  in degrees.
+ ***********************************************************/
+void SceneManager::SetNodeRotation(int node, const glm::vec3& rotationDegrees)
+{
+	m_sceneGraph->SetRotation(node, rotationDegrees);
+}
+
+/***********************************************************
+ *  SetNodeScale()
+ *
+ *  This method is used for scaling a node, and every node
+ *  and object below it.
+ ***********************************************************/
+void SceneManager::SetNodeScale(int node, const glm::vec3& scale)
+{
+	m_sceneGraph->SetScale(node, scale);
+}
+
+/***********************************************************
+ *  RayCastScene()
+ *
+ *  This method is used for finding the nearest scene object
+ *  whose bounds are hit by a ray. The distance along the ray
+ *  is returned in hitDistance, and -1 when nothing is hit.
+ ***********************************************************/
+int SceneManager::RayCastScene(
+	const glm::vec3& origin,
+	const glm::vec3& direction,
+	float maxDistance,
+	float& hitDistance) const
+{
+	int hitObject = -1;
+	int dynamicObject = -1;
+	float dynamicDistance = 0.0f;
+
+	hitDistance = maxDistance;
+	if (m_staticTree->RayCast(origin, direction, maxDistance, hitObject, hitDistance) == false)
+	{
+		hitObject = -1;
+		hitDistance = maxDistance;
+	}
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		int cellObject = -1;
+		float cellDistance = 0.0f;
+
+		if (m_cellTrees[i]->RayCast(origin, direction, hitDistance, cellObject, cellDistance) == true)
+		{
+			hitObject = cellObject;
+			hitDistance = cellDistance;
+		}
+	}
+	if (m_dynamicTree->RayCast(origin, direction, hitDistance, dynamicObject, dynamicDistance) == true)
+	{
+		hitObject = dynamicObject;
+		hitDistance = dynamicDistance;
+	}
+
+	return(hitObject);
+}
+
+/***********************************************************
+ *  FindObjectsInSphere()
+ *
+ *  This method is used for finding the scene objects whose
+ *  bounds overlap a sphere.
+ ***********************************************************/
+void SceneManager::FindObjectsInSphere(
+	const glm::vec3& center,
+	float radius,
+	std::vector<int>& objectIDs) const
+{
+	m_staticTree->QuerySphere(BOUNDING_SPHERE(center, radius), objectIDs);
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		m_cellTrees[i]->QuerySphere(BOUNDING_SPHERE(center, radius), objectIDs);
+	}
+	m_dynamicTree->QuerySphere(BOUNDING_SPHERE(center, radius), objectIDs);
+}
+
+/***********************************************************
+ *  CullSceneObjects()
+ *
+ *  This method is used for finding the objects inside the
+ *  view frustum with the bounding volume trees, skipping
+ *  the trees of the cells that cannot be seen, and putting
+ *  them into the frame draw list.
+ ***********************************************************/
+void SceneManager::CullSceneObjects()
+{
+	size_t dynamicStart = 0;
+	size_t visibleCount = 0;
+
+	UpdateSceneTrees();
+
+	m_visibleObjects.clear();
+	m_cullingStats.nodesVisited = m_staticTree->QueryFrustum(m_viewFrustum, m_visibleObjects);
+	for (size_t i = 0; i < m_cellTrees.size(); i++)
+	{
+		if ((m_visibleCells & (1u << i)) != 0)
+		{
+			m_cullingStats.nodesVisited += m_cellTrees[i]->QueryFrustum(m_viewFrustum, m_visibleObjects);
+		}
+	}
+
+	// moved objects are kept when they are in no cell or in
+	// a visible cell
+	dynamicStart = m_visibleObjects.size();
+	m_cullingStats.nodesVisited += m_dynamicTree->QueryFrustum(m_viewFrustum, m_visibleObjects);
+	visibleCount = dynamicStart;
+	for (size_t i = dynamicStart; i < m_visibleObjects.size(); i++)
+	{
+		int cell = m_sceneObjects[m_visibleObjects[i]].cell;
+
+		if ((cell == -1) || ((m_visibleCells & (1u << cell)) != 0))
+		{
+			m_visibleObjects[visibleCount++] = m_visibleObjects[i];
+		}
+	}
+	m_visibleObjects.resize(visibleCount);
+	m_cullingStats.testedObjects = (int)m_sceneObjects.size();
+	m_cullingStats.culledObjects = (int)(m_sceneObjects.size() - m_visibleObjects.size());
+
+	// the visible objects go into the frame draw list, at the
+	// level of their size on the screen
+	m_drawList.clear();
+	for (size_t i = 0; i < m_visibleObjects.size(); i++)
+	{
+		SCENE_OBJECT& object = m_sceneObjects[m_visibleObjects[i]];
+
+		object.packet.lod = SelectMeshLod(object);
+		m_drawList.push_back(object.packet);
+	}
+}
+
+/***********************************************************
+ *  DrawBasicMesh()
+ *
+ *  This method is used for drawing one of the loaded basic
+ *  shape meshes at the level of a draw, with the values
+ *  already set in the shader. The shared mesh buffer must
+ *  already be bound.
+ ***********************************************************/
+void SceneManager::DrawBasicMesh(const DRAW_PACKET& packet)
+{
+	const int mesh = GetLodMesh(packet);
+
+	// send only the shader values that changed since the last draw
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->ApplyPendingValues();
+	}
+
+	m_meshBuffer->DrawMesh(mesh);
+	m_drawStats.levelTriangles[packet.lod] += (int)(m_meshBuffer->GetMeshRange(mesh).indexCount / 3);
+}
+
+/***********************************************************
+ *  CreateMaterialBuffer()
+ *
+ *  This method is used for packing all of the defined object
+ *  materials into one std140 uniform buffer. When the shader
+ *  declares the MaterialBlock uniform block and the
+ *  materialIndex uniform, a draw selects its material with
+ *  that single index instead of five material uniforms. The
+ *  buffer always holds the whole MaterialBlock array, so the
+ *  block is never bound to a smaller buffer.
+ ***********************************************************/
+void SceneManager::CreateMaterialBuffer()
+{
+	glGenBuffers(1, &m_materialBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+	glBufferData(
+		GL_UNIFORM_BUFFER,
+		MAX_BLOCK_MATERIALS * sizeof(MATERIAL_BLOCK_ENTRY),
+		NULL,
+		GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// attach the buffer to the block binding point
+	glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, m_materialBuffer);
+
+	m_bUseMaterialBlock = false;
+	if ((int)m_objectMaterials.size() > MAX_BLOCK_MATERIALS)
+	{
+		std::cout << "INFO: " << m_objectMaterials.size() << " materials do not fit the "
+			<< MAX_BLOCK_MATERIALS << " in the material buffer, using material uniforms" << std::endl;
+		return;
+	}
+	UploadMaterials(0, (int)m_objectMaterials.size());
+	if ((NULL != m_pShaderUniforms) &&
+		(m_pShaderUniforms->HasUniform(UNIFORM_MATERIAL_INDEX) == true) &&
+		(m_pShaderUniforms->BindUniformBlock("MaterialBlock", MATERIAL_BLOCK_BINDING) == true))
+	{
+		m_bUseMaterialBlock = true;
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_MATERIAL_BLOCK, true);
+	}
+
+	std::cout << "INFO: " << m_objectMaterials.size() << " materials packed into the material buffer, "
+		<< (m_bUseMaterialBlock ? "selected by index" : "shader has no MaterialBlock, using material uniforms")
+		<< std::endl;
+}
+
+/***********************************************************
+ *  UploadMaterials()
+ *
+ *  This method is used for copying a range of the defined
+ *  object materials into the material uniform buffer. A
+ *  range that reaches past the MaterialBlock array is not
+ *  copied at all.
+ ***********************************************************/
+void SceneManager::UploadMaterials(int firstIndex, int materialCount)
+{
+	if ((m_materialBuffer == 0) ||
+		(materialCount <= 0) ||
+		(firstIndex < 0) ||
+		((firstIndex + materialCount) > MAX_BLOCK_MATERIALS))
+	{
+		return;
+	}
+
+	std::vector<MATERIAL_BLOCK_ENTRY> entries(materialCount);
+	for (int i = 0; i < materialCount; i++)
+	{
+		const OBJECT_MATERIAL& material = m_objectMaterials[firstIndex + i];
+
+		entries[i].ambientColor = material.ambientColor;
+		entries[i].ambientStrength = material.ambientStrength;
+		entries[i].diffuseColor = material.diffuseColor;
+		entries[i].padding = 0.0f;
+		entries[i].specularColor = material.specularColor;
+		entries[i].shininess = material.shininess;
+	}
+
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+	glBufferSubData(
+		GL_UNIFORM_BUFFER,
+		firstIndex * sizeof(MATERIAL_BLOCK_ENTRY),
+		materialCount * sizeof(MATERIAL_BLOCK_ENTRY),
+		entries.data());
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method is used for defining a new object material
+ *  after the scene has been prepared. Only the new material
+ *  is uploaded. The index of the new material is returned,
+ *  or -1 when the material buffer is in use and full.
+ ***********************************************************/
+int SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	int materialIndex = (int)m_objectMaterials.size();
+
+	if ((m_bUseMaterialBlock == true) && (materialIndex >= MAX_BLOCK_MATERIALS))
+	{
+		std::cout << "Could not add material " << material.tag << ", all "
+			<< MAX_BLOCK_MATERIALS << " entries of the material buffer are used" << std::endl;
+		return(-1);
+	}
+
+	m_objectMaterials.push_back(material);
+	// the material tag table is rebuilt to include the new tag
+	InternSceneTags();
+	UploadMaterials(materialIndex, 1);
+
+	return(materialIndex);
+}
+
+/***********************************************************
+ *  ApplyMaterial()
+ *
+ *  This method is used for selecting the material of the
+ *  next draw, by index when the shader reads the material
+ *  buffer, otherwise by staging the material uniforms.
+ ***********************************************************/
+void SceneManager::ApplyMaterial(int materialIndex)
+{
+	if (m_bUseMaterialBlock == true)
+	{
+		m_pShaderUniforms->setIntValue(UNIFORM_MATERIAL_INDEX, materialIndex);
+	}
+	else
+	{
+		const OBJECT_MATERIAL& material = m_objectMaterials[materialIndex];
+
+		m_pShaderUniforms->setVec3Value(UNIFORM_MATERIAL_AMBIENT_COLOR, material.ambientColor);
+		m_pShaderUniforms->setFloatValue(UNIFORM_MATERIAL_AMBIENT_STRENGTH, material.ambientStrength);
+		m_pShaderUniforms->setVec3Value(UNIFORM_MATERIAL_DIFFUSE_COLOR, material.diffuseColor);
+		m_pShaderUniforms->setVec3Value(UNIFORM_MATERIAL_SPECULAR_COLOR, material.specularColor);
+		m_pShaderUniforms->setFloatValue(UNIFORM_MATERIAL_SHININESS, material.shininess);
+	}
+	m_appliedMaterialIndex = materialIndex;
+}
+
+/***********************************************************
+ *  GetTextureGroup()
+ *
+ *  This method is used for getting the texture group a draw
+ *  reads. Draws in the same group need no sampler change
+ *  between them, so with texture arrays every texture of
+ *  one size and format is in one group.
+ ***********************************************************/
+int SceneManager::GetTextureGroup(const DRAW_PACKET& packet) const
+{
+	return((packet.bUseTexture == true) ? GetTextureGroup(packet.textureSlot) : -1);
+}
+
+int SceneManager::GetTextureGroup(int textureSlot) const
+{
+	if ((textureSlot < 0) || (m_bUseTextureArrays == false))
+	{
+		return(textureSlot);
+	}
+
+	return(m_textureIDs[textureSlot].arrayIndex);
+}
+
+/***********************************************************
+ *  GetTextureLayer()
+ *
+ *  This method is used for getting the array layer of a
+ *  texture slot, or the slot itself when the textures are
+ *  not in arrays.
+ ***********************************************************/
+int SceneManager::GetTextureLayer(int textureSlot) const
+{
+	if ((textureSlot < 0) || (m_bUseTextureArrays == false))
+	{
+		return(textureSlot);
+	}
+
+	return(m_textureIDs[textureSlot].layer);
+}
+
+/***********************************************************
+ *  ApplyTexture()
+ *
+ *  This method is used for selecting the texture of the
+ *  next draw, by its array and layer with texture arrays,
+ *  otherwise by the unit of its slot.
+ ***********************************************************/
+void SceneManager::ApplyTexture(int textureSlot)
+{
+	ApplyTextureGroup(GetTextureGroup(textureSlot));
+	if (m_bUseTextureArrays == true)
+	{
+		m_pShaderUniforms->setIntValue(UNIFORM_TEXTURE_LAYER, GetTextureLayer(textureSlot));
+	}
+}
+
+/***********************************************************
+ *  ApplyTextureGroup()
+ *
+ *  This method is used for pointing the object sampler at
+ *  the unit of a texture group, the texture array or the
+ *  texture slot. The draws of a multi-draw read their
+ *  layers from the draw data.
+ ***********************************************************/
+void SceneManager::ApplyTextureGroup(int textureGroup)
+{
+	if (textureGroup < 0)
+	{
+		return;
+	}
+	if (m_bUseTextureArrays == true)
+	{
+		m_pShaderUniforms->setIntValue(UNIFORM_OBJECT_TEXTURE_ARRAY, textureGroup);
+	}
+	else
+	{
+		m_pShaderUniforms->setSampler2DValue(UNIFORM_OBJECT_TEXTURE, textureGroup);
+	}
+}
+
+/***********************************************************
+ *  SetViewTransform()
+ *
+ *  This method is used for setting the camera view and
+ *  projection matrices of the frame that is being rendered.
+ ***********************************************************/
+void SceneManager::SetViewTransform(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec2& viewportSize)
+{
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+	m_viewportSize = viewportSize;
+	// a sphere of radius r at distance d covers r / d times
+	// this many pixels of the screen height
+	m_cameraPosition = glm::vec3(glm::inverse(view)[3]);
+	m_lodScale = projection[1][1] * viewportSize.y;
+}
+
+/***********************************************************
+ *  CheckAllCellsVisible()
+ *
+ *  This method is used for checking the portal cells from
+ *  a camera that should see all of them, such as the start
+ *  camera in the middle of the room. A cell left out is
+ *  reported, since its objects would be culled while they
+ *  are on screen.
+ ***********************************************************/
+bool SceneManager::CheckAllCellsVisible() const
+{
+	uint32_t visibleCells = m_portalCells.FindVisibleCells(m_viewMatrix, m_projectionMatrix);
+
+	for (int i = 0; i < m_portalCells.GetCellCount(); i++)
+	{
+		if ((visibleCells & (1u << i)) == 0)
+		{
+			std::cout << "Could not see portal cell " << i << " from the camera at "
+				<< m_cameraPosition.x << ", " << m_cameraPosition.y << ", " << m_cameraPosition.z << std::endl;
+			return(false);
+		}
+	}
+
+	std::cout << "INFO: all " << m_portalCells.GetCellCount() << " portal cells visible from the camera" << std::endl;
+	return(true);
+}
+
+/***********************************************************
+ *  SetClusteredLighting()
+ *
+ *  This method is used for switching the fragment shading
+ *  between the per-cluster light lists and the loop over
+ *  every light, so the frame times can be compared.
+ ***********************************************************/
+void SceneManager::SetClusteredLighting(bool bEnabled)
+{
+	m_lightClusters->SetEnabled(bEnabled);
+}
+
+/***********************************************************
+ *  GetCullingStats()
+ *
+ *  This method is used for getting the number of objects
+ *  tested against the view frustum in the last frame, and
+ *  how many of them were culled.
+ ***********************************************************/
+const SceneManager::CULLING_STATS& SceneManager::GetCullingStats() const
+{
+	return(m_cullingStats);
+}
+
+/***********************************************************
+ *  SetIndirectDraws()
+ *
+ *  This method is used for switching between drawing every
+ *  object with its own draw call and sending the whole
+ *  frame with a few multi-draw indirect calls. The switch
+ *  is ignored when the multi-draws are not supported.
+ ***********************************************************/
+void SceneManager::SetIndirectDraws(bool bEnabled)
+{
+	m_bUseIndirectDraws = bEnabled && m_bIndirectSupported;
+}
+
+/***********************************************************
+ *  SetGpuCulling()
+ *
+ *  This method is used for switching between culling the
+ *  objects with the bounding volume trees and with the GPU
+ *  culling pass, and for switching the test against the
+ *  depth of the last frame. It is ignored when the culling
+ *  pass could not be created.
+ ***********************************************************/
+void SceneManager::SetGpuCulling(bool bEnabled, bool bOcclusionCulling)
+{
+	m_bUseGpuCulling = bEnabled && (NULL != m_gpuCulling);
+	if (NULL != m_gpuCulling)
+	{
+		m_gpuCulling->SetOcclusionCulling(m_bUseGpuCulling && bOcclusionCulling);
+	}
+}
+
+/***********************************************************
+ *  GetDrawStats()
+ *
+ *  This method is used for getting the number of objects
+ *  drawn in the last frame and the draw calls made for them.
+ ***********************************************************/
+const SceneManager::DRAW_STATS& SceneManager::GetDrawStats() const
+{
+	return(m_drawStats);
+}
+
+/***********************************************************
+ *  GetLightClusters()
+ *
+ *  This method is used for getting the view cluster light
+ *  lists, for reporting their statistics.
+ ***********************************************************/
+const LightClusterGrid* SceneManager::GetLightClusters() const
+{
+	return(m_lightClusters);
+}
+
+/***********************************************************
+ *  GetTextureUploader()
+ *
+ *  This method is used for getting the texture upload
+ *  thread, for reporting its queue depth and bandwidth.
+ ***********************************************************/
+const TextureUploader* SceneManager::GetTextureUploader() const
+{
+	return(m_textureUploader);
+}
+
+/***********************************************************
+ *  BuildSortKey()
+ *
+ *  This method is used for building the 64 bit sort key of
+ *  a recorded draw. From the highest bits down the key holds
+ *  the opaque or blended flag, the texture slot, the material
+ *  and the mesh, so draws that share shader state end up next
+ *  to each other, then the view depth so opaque draws go from
+ *  front to back. Blended draws must be drawn after all the
+ *  opaque ones from back to front, so their depth is inverted
+ *  and placed above the shader state.
+ ***********************************************************/
+uint64_t SceneManager::BuildSortKey(const DRAW_PACKET& packet) const
+{
+	uint64_t key = 0;
+	glm::vec4 viewPosition;
+	float depth = 0.0f;
+	uint32_t depthBits = 0;
+	bool bBlended = false;
+
+	// the view depth of the object origin, positive in front of the camera
+	viewPosition = m_viewMatrix * glm::vec4(packet.model[3].x, packet.model[3].y, packet.model[3].z, 1.0f);
+	depth = -viewPosition.z;
+	if (depth < 0.0f)
+	{
+		depth = 0.0f;
+	}
+	// the bits of a positive float sort in the same order as the values
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	// only untextured draws can be partially transparent
+	bBlended = (packet.bUseTexture == false) && (packet.color.a < 1.0f);
+
+	if (bBlended == true)
+	{
+		key = ((uint64_t)1 << 63) | ((uint64_t)(~depthBits) << 31);
+	}
+	else
+	{
+		key |= (uint64_t)((GetTextureGroup(packet) + 1) & 0xFF) << 55;
+		// 9 bits so the last of the MAX_BLOCK_MATERIALS does
+		// not wrap onto the value of a draw without a material
+		key |= (uint64_t)((packet.materialIndex + 1) & 0x1FF) << 46;
+		key |= (uint64_t)(packet.mesh & 0x7) << 43;
+		key |= (uint64_t)(packet.lod & 0x3) << 41;
+		key |= (uint64_t)depthBits;
+	}
+
+	return(key);
+}
+
+/***********************************************************
+ *  SortDrawList()
+ *
+ *  This method is used for ordering the recorded draws by
+ *  their sort keys with a least significant digit radix
+ *  sort, one byte per pass. Passes where every key has the
+ *  same byte are skipped.
+ ***********************************************************/
+void SceneManager::SortDrawList()
+{
+	const size_t drawCount = m_drawList.size();
+
+	m_sortEntries.resize(drawCount);
+	m_sortScratch.resize(drawCount);
+	for (size_t i = 0; i < drawCount; i++)
+	{
+		m_sortEntries[i].key = BuildSortKey(m_drawList[i]);
+		m_sortEntries[i].packetIndex = (uint32_t)i;
+	}
+
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		size_t counts[256] = { 0 };
+		size_t offset = 0;
+
+		for (size_t i = 0; i < drawCount; i++)
+		{
+			counts[(m_sortEntries[i].key >> shift) & 0xFF]++;
+		}
+		// every key has the same byte, this pass would not move anything
+		if ((drawCount == 0) || (counts[(m_sortEntries[0].key >> shift) & 0xFF] == drawCount))
+		{
+			continue;
+		}
+
+		for (int digit = 0; digit < 256; digit++)
+		{
+			size_t count = counts[digit];
+			counts[digit] = offset;
+			offset += count;
+		}
+		for (size_t i = 0; i < drawCount; i++)
+		{
+			m_sortScratch[counts[(m_sortEntries[i].key >> shift) & 0xFF]++] = m_sortEntries[i];
+		}
+		m_sortEntries.swap(m_sortScratch);
+	}
+}
+
+/***********************************************************
+ *  SubmitDrawList()
+ *
+ *  This method is used for drawing the recorded draws in
+ *  sorted order. The shader values of every draw are staged
+ *  and only the ones that changed are sent to the shader.
+ ***********************************************************/
+void SceneManager::SubmitDrawList()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	// the first draw of every frame selects its material again
+	m_appliedMaterialIndex = -1;
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_DRAW_DATA, false);
+	ResetDrawStats(m_drawStats);
+	m_drawStats.objectDraws = (int)m_sortEntries.size();
+	m_drawStats.drawCalls = (int)m_sortEntries.size();
+	// every mesh is in the same buffers, so the vertex array
+	// is bound once for the whole list
+	m_meshBuffer->Bind();
+
+	for (size_t i = 0; i < m_sortEntries.size(); i++)
+	{
+		const DRAW_PACKET& packet = m_drawList[m_sortEntries[i].packetIndex];
+
+		m_pShaderUniforms->setMat4Value(UNIFORM_MODEL, packet.model);
+		m_pShaderUniforms->setMat3Value(UNIFORM_NORMAL_MATRIX, packet.normalMatrix);
+		m_pShaderUniforms->setVec4Value(UNIFORM_OBJECT_COLOR, packet.color);
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_TEXTURE, packet.bUseTexture);
+		if (packet.bUseTexture == true)
+		{
+			ApplyTexture(packet.textureSlot);
+		}
+		m_pShaderUniforms->setVec2Value(UNIFORM_UV_SCALE, packet.uvScale);
+		// draws sorted next to each other mostly share a material
+		if ((packet.materialIndex >= 0) && (packet.materialIndex != m_appliedMaterialIndex))
+		{
+			ApplyMaterial(packet.materialIndex);
+		}
+
+		DrawBasicMesh(packet);
+	}
+
+	m_meshBuffer->Unbind();
+}
+
+/***********************************************************
+ *  CreateMeshBuffer()
+ *
+ *  This method is used for building the basic shape meshes
+ *  into one shared vertex and index buffer behind a single
+ *  vertex array. Each mesh is drawn from its base vertex
+ *  and first index, so draws of different shapes never
+ *  switch buffers. The cone, sphere and torus are also
+ *  built at the lower tessellation levels.
+ ***********************************************************/
+void SceneManager::CreateMeshBuffer()
+{
+	MESH_GEOMETRY geometry;
+
+	// the full meshes are added first, in the same order as
+	// MESH_TYPE, so a mesh type is also its full mesh index
+	m_meshBuffer = new BasicMeshBuffer();
+	for (int i = 0; i < MESH_TYPE_COUNT; i++)
+	{
+		GenerateBasicMesh((MESH_TYPE)i, 0, geometry);
+		m_lodMeshes[i][0] = m_meshBuffer->AddMesh(geometry);
+	}
+	for (int lod = 1; lod < MESH_LOD_COUNT; lod++)
+	{
+		for (int i = 0; i < MESH_TYPE_COUNT; i++)
+		{
+			if (IsCurvedMesh((MESH_TYPE)i) == true)
+			{
+				GenerateBasicMesh((MESH_TYPE)i, lod, geometry);
+				m_lodMeshes[i][lod] = m_meshBuffer->AddMesh(geometry);
+			}
+			else
+			{
+				m_lodMeshes[i][lod] = m_lodMeshes[i][0];
+			}
+		}
+	}
+	m_meshBuffer->CreateBuffers();
+}
+
+/***********************************************************
+ *  SelectMeshLod()
+ *
+ *  This method is used for choosing the tessellation level
+ *  of a scene object from the size of its bounding sphere
+ *  on the screen. An object only moves to another level
+ *  once its size is past the level screen size by the
+ *  hysteresis, so an object sitting at one of the sizes
+ *  keeps the level it has.
+ ***********************************************************/
+int SceneManager::SelectMeshLod(const SCENE_OBJECT& object) const
+{
+	const int currentLod = object.packet.lod;
+	BOUNDING_SPHERE sphere;
+	float distance = 0.0f;
+	float screenSize = 0.0f;
+	int lod = 0;
+
+	if (IsCurvedMesh(object.packet.mesh) == false)
+	{
+		return(0);
+	}
+
+	sphere = GetBoundingSphere(object.bounds);
+	distance = glm::length(glm::vec3(sphere) - m_cameraPosition);
+	if (distance <= sphere.w)
+	{
+		return(0);
+	}
+	screenSize = (sphere.w / distance) * m_lodScale;
+
+	while (lod < (MESH_LOD_COUNT - 1))
+	{
+		float threshold = g_LodScreenSizes[lod];
+
+		// going to a finer level than the current one needs a
+		// larger size, leaving the current one a smaller size
+		if (lod < currentLod)
+		{
+			threshold *= (1.0f + LOD_HYSTERESIS);
+		}
+		else
+		{
+			threshold *= (1.0f - LOD_HYSTERESIS);
+		}
+		if (screenSize >= threshold)
+		{
+			break;
+		}
+		lod++;
+	}
+
+	return(lod);
+}
+
+/***********************************************************
+ *  GetLodMesh()
+ *
+ *  This method is used for getting the shared buffer mesh
+ *  of a draw, from its mesh type and level.
+ ***********************************************************/
+int SceneManager::GetLodMesh(const DRAW_PACKET& packet) const
+{
+	return(m_lodMeshes[packet.mesh][packet.lod]);
+}
+
+/***********************************************************
+ *  CreateIndirectDrawBuffers()
+ *
+ *  This method is used for preparing the multi-draw path
+ *  over the shared mesh buffer. The path needs OpenGL 4.3,
+ *  the material buffer, and a shader that declares:
+ *
+ *    struct DrawData { mat4 model; mat4 normalMatrix; vec4 color;
+ *                      vec2 uvScale; int materialIndex; int textureLayer; };
+ *    layout(std430) buffer DrawDataBuffer { DrawData drawData[]; };
+ *    layout(location = 3) in uint drawID;
+ *    uniform bool bUseDrawData;
+ *
+ *  where drawID, or gl_BaseInstance, indexes drawData[].
+ ***********************************************************/
+void SceneManager::CreateIndirectDrawBuffers()
+{
+	m_bIndirectSupported = false;
+	m_bUseIndirectDraws = false;
+	if ((NULL == m_pShaderUniforms) ||
+		(m_bUseMaterialBlock == false) ||
+		(m_pShaderUniforms->HasUniform(UNIFORM_USE_DRAW_DATA) == false) ||
+		(m_pShaderUniforms->BindStorageBlock("DrawDataBuffer", DRAW_DATA_BINDING) == false))
+	{
+		std::cout << "INFO: Multi-draw indirect not available, shader has no DrawDataBuffer" << std::endl;
+		return;
+	}
+
+	glGenBuffers(1, &m_drawDataBuffer);
+	glGenBuffers(1, &m_drawCommandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_drawDataBuffer);
+	m_bIndirectSupported = true;
+
+	std::cout << "INFO: Multi-draw indirect available, "
+		<< m_meshBuffer->GetMeshCount() << " basic meshes in shared buffers" << std::endl;
+}
+
+/***********************************************************
+ *  SubmitIndirectDrawList()
+ *
+ *  This method is used for drawing the recorded draws with
+ *  multi-draw indirect calls. The per draw values go into
+ *  the draw data buffer and one indirect command is built
+ *  for every draw, both in sorted order. Draws only have to
+ *  be split where the texture group changes, so the frame
+ *  takes about one call per texture, or per texture array.
+ ***********************************************************/
+void SceneManager::SubmitIndirectDrawList()
+{
+	const size_t drawCount = m_sortEntries.size();
+	size_t groupStart = 0;
+	int groupTexture = -1;
+
+	ResetDrawStats(m_drawStats);
+	m_drawStats.objectDraws = (int)drawCount;
+	if (drawCount == 0)
+	{
+		return;
+	}
+
+	m_drawData.resize(drawCount);
+	m_drawCommands.resize(drawCount);
+	for (size_t i = 0; i < drawCount; i++)
+	{
+		const DRAW_PACKET& packet = m_drawList[m_sortEntries[i].packetIndex];
+
+		BuildDrawData(packet, m_drawData[i]);
+		m_meshBuffer->BuildDrawCommand(GetLodMesh(packet), (GLuint)i, m_drawCommands[i]);
+		m_drawStats.levelTriangles[packet.lod] += (int)(m_drawCommands[i].count / 3);
+	}
+
+	// grow the buffers by doubling, and orphan them every
+	// frame so the driver does not wait on the last frame
+	if ((int)drawCount > m_drawBufferCapacity)
+	{
+		m_drawBufferCapacity = (m_drawBufferCapacity == 0) ? 256 : m_drawBufferCapacity;
+		while (m_drawBufferCapacity < (int)drawCount)
+		{
+			m_drawBufferCapacity *= 2;
+		}
+		m_meshBuffer->ReserveDrawIDs(m_drawBufferCapacity);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_drawBufferCapacity * sizeof(DRAW_DATA_ENTRY), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, drawCount * sizeof(DRAW_DATA_ENTRY), m_drawData.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_drawCommandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, m_drawBufferCapacity * sizeof(DRAW_ELEMENTS_COMMAND), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, drawCount * sizeof(DRAW_ELEMENTS_COMMAND), m_drawCommands.data());
+
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_DRAW_DATA, true);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_drawDataBuffer);
+	m_meshBuffer->SetDrawIDSource(0);
+	m_meshBuffer->Bind();
+
+	for (size_t i = 0; i <= drawCount; i++)
+	{
+		int textureGroup = (i < drawCount) ? GetTextureGroup(m_drawList[m_sortEntries[i].packetIndex]) : -1;
+
+		// untextured draws never read the sampler, so they can
+		// join any group
+		if ((i < drawCount) && ((textureGroup == -1) || (groupTexture == -1) || (textureGroup == groupTexture)))
+		{
+			if (textureGroup != -1)
+			{
+				groupTexture = textureGroup;
+			}
+			continue;
+		}
+
+		if (i > groupStart)
+		{
+			ApplyTextureGroup(groupTexture);
+			m_pShaderUniforms->ApplyPendingValues();
+			glMultiDrawElementsIndirect(
+				GL_TRIANGLES,
+				GL_UNSIGNED_INT,
+				(const void*)(groupStart * sizeof(DRAW_ELEMENTS_COMMAND)),
+				(GLsizei)(i - groupStart),
+				0);
+			m_drawStats.drawCalls++;
+		}
+		groupStart = i;
+		groupTexture = textureGroup;
+	}
+
+	m_meshBuffer->Unbind();
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/***********************************************************
+ *  BuildDrawData()
+ *
+ *  This method is used for filling the per draw values that
+ *  the shader reads for a multi-draw.
+ ***********************************************************/
+void SceneManager::BuildDrawData(const DRAW_PACKET& packet, DRAW_DATA_ENTRY& entry) const
+{
+	entry.model = packet.model;
+	entry.normalMatrix = glm::mat4(packet.normalMatrix);
+	entry.color = packet.color;
+	entry.uvScale = packet.uvScale;
+	// draws without a material use the first one
+	entry.materialIndex = (packet.materialIndex >= 0) ? packet.materialIndex : 0;
+	entry.textureLayer = (packet.bUseTexture == true) ? GetTextureLayer(packet.textureSlot) : -1;
+}
+
+/***********************************************************
+ *  BuildCullInstance()
+ *
+ *  This method is used for filling the bounds, cell and
+ *  command of a scene object for the GPU culling pass.
+ ***********************************************************/
+void SceneManager::BuildCullInstance(int objectID, GLuint commandIndex, GPU_CULL_INSTANCE& instance) const
+{
+	const SCENE_OBJECT& object = m_sceneObjects[objectID];
+
+	instance.minPoint = glm::vec4(object.bounds.minPoint, 1.0f);
+	instance.maxPoint = glm::vec4(object.bounds.maxPoint, 1.0f);
+	instance.commandIndex = commandIndex;
+	instance.cellBit = (object.cell == -1) ? 0 : (1u << object.cell);
+	instance.padding[0] = 0;
+	instance.padding[1] = 0;
+}
+
+/***********************************************************
+ *  CreateGpuCulling()
+ *
+ *  This method is used for creating the GPU culling pass
+ *  once the scene objects are known, and sending it the
+ *  objects grouped into its indirect commands.
+ ***********************************************************/
+void SceneManager::CreateGpuCulling()
+{
+	if ((m_bIndirectSupported == false) || (m_sceneObjects.empty() == true))
+	{
+		return;
+	}
+
+	m_gpuCulling = new GpuCullingPass();
+	if (m_gpuCulling->Initialize() == false)
+	{
+		std::cout << "INFO: GPU culling not available, compute shaders are not supported" << std::endl;
+		delete m_gpuCulling;
+		m_gpuCulling = NULL;
+		return;
+	}
+
+	glGenBuffers(1, &m_instanceDataBuffer);
+	BuildGpuCullGroups();
+
+	std::cout << "INFO: GPU culling available, " << m_sceneObjects.size() << " objects in "
+		<< m_gpuCulling->GetCommandCount() << " indirect commands" << std::endl;
+}
+
+/***********************************************************
+ *  BuildGpuCullGroups()
+ *
+ *  This method is used for splitting the scene objects into
+ *  groups that share a mesh and a texture group, with the
+ *  blended ones last, and each group gets one indirect
+ *  command that draws its visible objects as instances.
+ *  Commands next to each other with the same texture group
+ *  are drawn by one multi-draw call. With texture arrays
+ *  the instances of one command read different layers, so
+ *  the groups are built again whenever a loaded texture
+ *  moves to its array.
+ ***********************************************************/
+void SceneManager::BuildGpuCullGroups()
+{
+	std::vector<uint32_t> objectKeys(m_sceneObjects.size());
+	std::vector<uint32_t> groupKeys;
+	std::vector<DRAW_ELEMENTS_COMMAND> commands;
+	std::vector<GPU_CULL_INSTANCE> instances(m_sceneObjects.size());
+	std::vector<DRAW_DATA_ENTRY> drawData(m_sceneObjects.size());
+	GLuint firstInstance = 0;
+
+	// group key of the blended flag, texture group and mesh
+	for (size_t i = 0; i < m_sceneObjects.size(); i++)
+	{
+		const DRAW_PACKET& packet = m_sceneObjects[i].packet;
+		bool bBlended = (packet.bUseTexture == false) && (packet.color.a < 1.0f);
+
+		objectKeys[i] =
+			((bBlended ? 1u : 0u) << 16) |
+			((uint32_t)((GetTextureGroup(packet) + 1) & 0xFF) << 8) |
+			(uint32_t)packet.mesh;
+	}
+	groupKeys = objectKeys;
+	std::sort(groupKeys.begin(), groupKeys.end());
+	groupKeys.erase(std::unique(groupKeys.begin(), groupKeys.end()), groupKeys.end());
+
+	// each command gets a range of the visible ID buffer as
+	// large as its group
+	commands.resize(groupKeys.size());
+	m_gpuObjectCommands.resize(m_sceneObjects.size());
+	for (size_t i = 0; i < m_sceneObjects.size(); i++)
+	{
+		m_gpuObjectCommands[i] = (GLuint)(std::lower_bound(groupKeys.begin(), groupKeys.end(), objectKeys[i]) - groupKeys.begin());
+		commands[m_gpuObjectCommands[i]].instanceCount++;
+	}
+
+	m_gpuTextureRuns.clear();
+	for (size_t i = 0; i < groupKeys.size(); i++)
+	{
+		GLuint groupSize = commands[i].instanceCount;
+		int textureGroup = (int)((groupKeys[i] >> 8) & 0xFF) - 1;
+
+		m_meshBuffer->BuildDrawCommand((int)(groupKeys[i] & 0xFF), firstInstance, commands[i]);
+		commands[i].instanceCount = 0;
+		firstInstance += groupSize;
+
+		// untextured commands never read the sampler, so they
+		// can join any run
+		if ((m_gpuTextureRuns.empty() == false) &&
+			((textureGroup == -1) ||
+			 (m_gpuTextureRuns.back().textureGroup == -1) ||
+			 (m_gpuTextureRuns.back().textureGroup == textureGroup)))
+		{
+			m_gpuTextureRuns.back().commandCount++;
+			if (textureGroup != -1)
+			{
+				m_gpuTextureRuns.back().textureGroup = textureGroup;
+			}
+		}
+		else
+		{
+			GPU_TEXTURE_RUN run;
+
+			run.firstCommand = (int)i;
+			run.commandCount = 1;
+			run.textureGroup = textureGroup;
+			m_gpuTextureRuns.push_back(run);
+		}
+	}
+
+	for (size_t i = 0; i < m_sceneObjects.size(); i++)
+	{
+		BuildCullInstance((int)i, m_gpuObjectCommands[i], instances[i]);
+		BuildDrawData(m_sceneObjects[i].packet, drawData[i]);
+	}
+	m_gpuCulling->SetInstances(instances, commands);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceDataBuffer);
+	glBufferData(
+		GL_SHADER_STORAGE_BUFFER,
+		drawData.size() * sizeof(DRAW_DATA_ENTRY),
+		drawData.data(),
+		GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	// every object was just sent whole
+	m_gpuDirtyObjects.clear();
+	m_gpuTextureLayout = m_textureLayout;
+}
+
+/***********************************************************
+ *  UpdateGpuInstances()
+ *
+ *  This method is used for sending the new bounds, cells
+ *  and model matrices of the objects that moved to the GPU
+ *  culling pass.
+ ***********************************************************/
+void SceneManager::UpdateGpuInstances()
+{
+	GPU_CULL_INSTANCE instance;
+	DRAW_DATA_ENTRY entry;
+
+	for (size_t i = 0; i < m_gpuDirtyObjects.size(); i++)
+	{
+		int objectID = m_gpuDirtyObjects[i];
+
+		BuildCullInstance(objectID, m_gpuObjectCommands[objectID], instance);
+		m_gpuCulling->UpdateInstance(objectID, instance);
+
+		BuildDrawData(m_sceneObjects[objectID].packet, entry);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceDataBuffer);
+		glBufferSubData(
+			GL_SHADER_STORAGE_BUFFER,
+			objectID * sizeof(DRAW_DATA_ENTRY),
+			sizeof(DRAW_DATA_ENTRY),
+			&entry);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+	m_gpuDirtyObjects.clear();
+}
+
+/***********************************************************
+ *  SubmitGpuCulledDrawList()
+ *
+ *  This method is used for drawing the objects found by the
+ *  GPU culling pass. The draw ID attribute reads the visible
+ *  ID buffer the pass wrote, which gives the object index
+ *  into the per object draw values. Blended objects are
+ *  drawn after the opaque ones, but not sorted by depth.
+ ***********************************************************/
+void SceneManager::SubmitGpuCulledDrawList()
+{
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_DRAW_DATA, true);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_instanceDataBuffer);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_gpuCulling->GetCommandBuffer());
+	m_meshBuffer->SetDrawIDSource(m_gpuCulling->GetVisibleIDBuffer());
+	m_meshBuffer->Bind();
+
+	ResetDrawStats(m_drawStats);
+	m_drawStats.objectDraws = (int)m_sceneObjects.size();
+	for (size_t i = 0; i < m_gpuTextureRuns.size(); i++)
+	{
+		const GPU_TEXTURE_RUN& run = m_gpuTextureRuns[i];
+
+		ApplyTextureGroup(run.textureGroup);
+		m_pShaderUniforms->ApplyPendingValues();
+		glMultiDrawElementsIndirect(
+			GL_TRIANGLES,
+			GL_UNSIGNED_INT,
+			(const void*)(run.firstCommand * sizeof(DRAW_ELEMENTS_COMMAND)),
+			run.commandCount,
+			0);
+		m_drawStats.drawCalls++;
+	}
+
+	m_meshBuffer->Unbind();
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+/// <summary>
+/// Loads the images and converts them to textures.
+/// </summary>
+void SceneManager::LoadSceneTextures() 
+{
+	bool bReturn = false;
+	// the flip is read by the loader threads, so it is set
+	// before any image is queued
+	stbi_set_flip_vertically_on_load(true);
+	// queue the texture images, they are decoded together on
+	// the loader threads and uploaded as they finish
+	bReturn = CreateGLTexture("../../Utilities/Textures/BushDenseBerries.jpg", "DenseBerries");
+	bReturn = CreateGLTexture("../../Utilities/Textures/bushDense.jpg", "Hedge");
+	bReturn = CreateGLTexture("../../Utilities/Textures/BarkTexture.jpg", "bark");
+	bReturn = CreateGLTexture("../../Utilities/Textures/pavers.jpg", "brick");
+	bReturn = CreateGLTexture("../../Utilities/Textures/tilesf2.jpg", "tile");
+	bReturn = CreateGLTexture("../../Utilities/Textures/rocks.jpg", "rocks");
+	
+	BindGLTextures();
+}
+
+/// <summary>
+/// Creates the object shader material
+/// </summary>
+void SceneManager::DefineObjectMaterials()
+{
+
+	//Cement Type of material or dark material
+	OBJECT_MATERIAL cementMaterial;
+	cementMaterial.ambientColor = glm::vec3(0.6f, 0.6f, 0.6f);
+	cementMaterial.ambientStrength = 0.0f;
+	cementMaterial.diffuseColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	cementMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	cementMaterial.shininess = 0.1;
+	cementMaterial.tag = "cement";
+
+	m_objectMaterials.push_back(cementMaterial);
+
+	//Tile material with a tint of blue
+	OBJECT_MATERIAL blueTile;
+	blueTile.ambientColor = glm::vec3(0.1f, 0.1f, 0.6f);
+	blueTile.ambientStrength = 0.1f;
+	blueTile.diffuseColor = glm::vec3(0.1f, 0.1f, 0.3f);
+	blueTile.specularColor = glm::vec3(0.1f, 0.1f, 0.3f);
+	blueTile.shininess = 0.6f;
+	blueTile.tag = "blueTile";
+
+	m_objectMaterials.push_back(blueTile);
+
+	//bush material with a tint of green
+	OBJECT_MATERIAL bush;
+	bush.ambientColor = glm::vec3(0.1f, 0.8f, 0.1f);
+	bush.ambientStrength = 0.1f;
+	bush.diffuseColor = glm::vec3(0.1f, 0.8, 0.1f);
+	bush.specularColor = glm::vec3(0.1f, 0.8, 0.1f);
+	bush.shininess = 0.1f;
+	bush.tag = "bush";
+
+	m_objectMaterials.push_back(bush);
+
+	//bark material with a mixed tint
+	OBJECT_MATERIAL bark;
+	bark.ambientColor = glm::vec3(0.5f, 0.5f, 0.1f);
+	bark.ambientStrength = 0.1f;
+	bark.diffuseColor = glm::vec3(0.5f, 0.5, 0.1f);
+	bark.specularColor = glm::vec3(0.5f, 0.5, 0.1f);
+	bark.shininess = 0.1f;
+	bark.tag = "bark";
+
+	m_objectMaterials.push_back(bark);
+
+}
+
+/// <summary>
+/// Defines and sets scene lights
+/// </summary>
+void SceneManager::SetupSceneLights()
+{
+	// this line of code is NEEDED for telling the shaders to render 
+	// the 3D scene with custom lighting, if no light sources have
+	// been added then the display window will be black - to use the 
+	// default OpenGL lighting then comment out the following line
+	//m_pShaderUniforms->setBoolValue(UNIFORM_USE_LIGHTING, true);
+
+	LightManager::LIGHT_SOURCE light;
+
+	// the light ranges cover the whole scene so the four
+	// lights reach every object, as they did before
+	//Light one
+	light.position = glm::vec3(0.0f, 11.0f, 0.0f);
+	light.ambientColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	light.diffuseColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	light.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	light.focalStrength = 0.0f;
+	light.specularIntensity = 0.0f;
+	light.ambientStrength = 0.6f;
+	light.range = 150.0f;
+	m_lightManager->AddLight(light);
+
+	//Light two
+	light.position = glm::vec3(-50.0f, 11.0f, -50.0f);
+	light.ambientColor = glm::vec3(0.8f, 0.1f, 0.1f);
+	light.diffuseColor = glm::vec3(0.8f, 0.1f, 0.1f);
+	light.specularColor = glm::vec3(0.8f, 0.1f, 0.1f);
+	light.focalStrength = 0.5f;
+	light.specularIntensity = 0.5f;
+	light.ambientStrength = 0.6f;
+	light.range = 150.0f;
+	m_lightManager->AddLight(light);
+
+	//Light three
+	light.position = glm::vec3(50.0f, 11.0f, 50.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.1f, 0.8f);
+	light.diffuseColor = glm::vec3(0.1f, 0.1f, 0.8f);
+	light.specularColor = glm::vec3(0.1f, 0.1f, 0.8f);
+	light.focalStrength = 0.6f;
+	light.specularIntensity = 0.6f;
+	light.ambientStrength = 0.6f;
+	light.range = 150.0f;
+	m_lightManager->AddLight(light);
+
+	//Light four
+	light.position = glm::vec3(50.0f, 11.0f, -50.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.7f, 0.0f);
+	light.diffuseColor = glm::vec3(0.1f, 0.7f, 0.0f);
+	light.specularColor = glm::vec3(0.0f, 0.7f, 0.0f);
+	light.focalStrength = 1.0f;
+	light.specularIntensity = 1.0f;
+	light.ambientStrength = 1.0f;
+	light.range = 150.0f;
+	m_lightManager->AddLight(light);
+
+	m_pShaderUniforms->setBoolValue(UNIFORM_USE_LIGHTING, true);
+
+}
+
+/// <summary>
+/// Gets the light manager holding the scene light sources
+/// </summary>
+LightManager* SceneManager::GetLightManager()
+{
+	return(m_lightManager);
+}
+
+/// <summary>
+/// Loads the object meshes and prepares scene lights and textures
+/// </summary>
+void SceneManager::PrepareScene()
+{
+	// define the materials for objects in the scene
+	DefineObjectMaterials();
+	// create the light buffer, then add and define the
+	// light sources for the scene
+	m_lightManager->Initialize();
+	m_lightClusters->Initialize(m_lightManager->IsUsingLightBuffer());
+	SetupSceneLights();
+
+	LoadSceneTextures();
+	// turn the texture and material tags into integer handles
+	InternSceneTags();
+	// pack the materials so a draw can select one by index
+	CreateMaterialBuffer();
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene, and every mesh shares the
+	// same vertex and index buffer
+	CreateMeshBuffer();
+	// prepare the multi-draws of the shared meshes
+	CreateIndirectDrawBuffers();
+
+	// merge the floor and walls as they are added
+	CreateStaticBatches();
+	// add the scene objects and build the culling trees
+	BuildSceneObjects();
+	// send the scene objects to the GPU culling pass
+	CreateGpuCulling();
+}
+
+/// <summary>
+/// The full render function
+/// Finds the quadrant cells seen through the portals and the
+/// scene objects inside the view frustum, with the bounding
+/// volume trees or the GPU culling pass, then draws them after
+/// the merged floor and walls
+/// </summary>
+void SceneManager::RenderScene()
+{
+	DRAW_STATS batchStats;
+	DRAW_STATS instanceStats;
+
+	// textures whose images finished decoding are uploaded
+	UploadDecodedTextures();
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->setBoolValue(UNIFORM_USE_TEXTURE_ARRAYS, m_bUseTextureArrays);
+		// the object sampler that is not read is kept off the
+		// units of the one that is
+		if (m_bUseTextureArrays == true)
+		{
+			m_pShaderUniforms->setSampler2DValue(UNIFORM_OBJECT_TEXTURE, UNUSED_SAMPLER_UNIT);
+		}
+		else
+		{
+			m_pShaderUniforms->setIntValue(UNIFORM_OBJECT_TEXTURE_ARRAY, UNUSED_SAMPLER_UNIT);
+		}
+	}
+	// objects with changed transform values are moved first
+	UpdateObjectTransforms();
+	// objects outside the camera view are not drawn
+	m_viewFrustum.SetFromMatrices(m_viewMatrix, m_projectionMatrix);
+
+	// quadrants hidden behind the dividers are skipped whole
+	m_visibleCells = m_portalCells.FindVisibleCells(m_viewMatrix, m_projectionMatrix);
+	m_cullingStats.visibleCells = 0;
+	for (int i = 0; i < m_portalCells.GetCellCount(); i++)
+	{
+		if ((m_visibleCells & (1u << i)) != 0)
+		{
+			m_cullingStats.visibleCells++;
+		}
+	}
+
+	// the culling commands follow the textures into their
+	// array layers
+	if ((NULL != m_gpuCulling) && (m_gpuTextureLayout != m_textureLayout))
+	{
+		BuildGpuCullGroups();
+	}
+	if (m_bUseGpuCulling == true)
+	{
+		// the visible objects never come back to the CPU
+		UpdateGpuInstances();
+		m_gpuCulling->Cull(m_viewFrustum, m_visibleCells);
+		m_cullingStats.testedObjects = (int)m_sceneObjects.size();
+		m_cullingStats.culledObjects = 0;
+		m_cullingStats.nodesVisited = 0;
+		m_cullingStats.bGpuCulling = true;
+	}
+	else
+	{
+		CullSceneObjects();
+		// group the draws by shader state and depth before drawing them
+		SortDrawList();
+		m_cullingStats.bGpuCulling = false;
+	}
+
+	// send the lights that changed since the last frame
+	m_lightManager->UploadLights();
+	// assign the lights to the view clusters they reach
+	if (m_lightClusters->IsEnabled() == true)
+	{
+		m_lightManager->GetLightSpheres(m_lightSpheres);
+		m_lightClusters->BuildClusters(m_lightSpheres, m_viewMatrix, m_projectionMatrix, m_viewportSize);
+	}
+	// the opaque floor and walls go before any blended draw
+	DrawStaticBatches(batchStats);
+	DrawInstanceGroups(instanceStats);
+	if (m_bUseGpuCulling == true)
+	{
+		SubmitGpuCulledDrawList();
+		// the depth of this frame hides objects in the next one
+		m_gpuCulling->BuildDepthPyramid(m_projectionMatrix * m_viewMatrix, m_viewportSize);
+	}
+	else if (m_bUseIndirectDraws == true)
+	{
+		SubmitIndirectDrawList();
+	}
+	else
+	{
+		SubmitDrawList();
+	}
+	AddDrawStats(m_drawStats, batchStats);
+	AddDrawStats(m_drawStats, instanceStats);
+}
+
+/// <summary>
+/// Renders and defines the floor
+/// </summary>
+void SceneManager::RenderFloor() 
+{
+	//FLOOR
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(100.0f, 1.0f, 100.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.0f, -20.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("brick"));
+	SetShaderMaterial(SCENE_TAG("cement"));
+	SetTextureUVScale(20, 20);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PLANE);
+	/****************************************************************/
+
+	
+}
+
+/// <summary>
+/// Renders all the objects in quadrant one
+/// </summary>
+void SceneManager::RenderQuadrantOne()
+{
+	//QUADRANT 1
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+
+	//CENTER BLOCK	
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 0.5f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("tile"));
+	SetShaderMaterial(SCENE_TAG("blueTile"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/ 
+
+	//CENTER MULCH
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 0.6f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("rocks"));
+	SetShaderMaterial(SCENE_TAG("cement"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//LEFT BOTTOM CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(50.0f, 0.9f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//LEFT TOP CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(50.0f, 2.9f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//RIGHT BOTTOM CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(60.0f, 0.9f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//RIGHT TOP CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(60.0f, 2.9f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//RIGHT TORUS
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(60.0f, 8.8f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(3, 2);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_TORUS);
+	/******************************************************************/
+
+	//LEFT TORUS
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(50.0f, 8.8f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(3, 2);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_TORUS);
+	/******************************************************************/
+
+	//CENTER TORUS
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 5.0f, 3.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 18.5f, 35.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(3, 2);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_TORUS);
+	/******************************************************************/
+
+
+
+}
+
+/// <summary>
+/// Renders all the small bushes in quadrant two
+/// uses helper function add root, which defines the root height also
+/// </summary>
+void SceneManager::RenderQuadrantTwo() 
+{
+	//QUADRANT 2
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+	//Usefull for moveving all spheres
+	float sHeight = 3.3;
+	float sSize = 1.3;
+
+	//SHRUB BED
+	/******************************************************************/
+	// everything in the bed is placed relative to its center, so
+	// moving this one node moves the whole bed
+	PushSceneNode(
+		SCENE_TAG("shrubBed"),
+		glm::vec3(1.0f, 1.0f, 1.0f),
+		0.0f,
+		0.0f,
+		0.0f,
+		glm::vec3(-55.0f, 0.0f, 35.0f));
+	/******************************************************************/
+
+	//CENTER BLOCK	
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.5f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("tile"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//CENTER MULCH
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.6f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("rocks"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//SMALL BUSHES
+	/******************************************************************/
+	// every bush sits at the same height and size, so only the
+	// x, z offset from the bed center is needed to place the
+	// bush, and its root is placed relative to the bush. The
+	// bushes and roots are each drawn with one instanced draw
+	const glm::vec2 bushOffsets[] =
+	{
+		glm::vec2(7.0f, 0.0f),
+		glm::vec2(-7.0f, 0.0f),
+		glm::vec2(0.0f, 7.0f),
+		glm::vec2(0.0f, -7.0f),
+		glm::vec2(5.0f, 5.0f),
+		glm::vec2(-5.0f, -5.0f),
+		glm::vec2(-5.0f, 5.0f),
+		glm::vec2(5.0f, -5.0f),
+		glm::vec2(2.7f, -6.7f),
+		glm::vec2(-2.7f, 6.7f),
+		glm::vec2(-2.7f, -6.7f),
+		glm::vec2(2.7f, 6.7f),
+		glm::vec2(-6.7f, 2.7f),
+		glm::vec2(6.7f, -2.7f),
+		glm::vec2(-6.7f, -2.7f),
+		glm::vec2(6.7f, 2.7f)
+	};
+	const int bushCount = sizeof(bushOffsets) / sizeof(bushOffsets[0]);
+	glm::mat4 bushModels[bushCount];
+	glm::mat4 rootModels[bushCount * 2];
+
+	for (int i = 0; i < bushCount; i++)
+	{
+		const glm::mat4 bushModel = TransformTable::ComputeModel(BuildTransformations(
+			glm::vec3(1.0f, 1.0f, 1.0f),
+			0.0f,
+			0.0f,
+			0.0f,
+			glm::vec3(bushOffsets[i].x, 0.0f, bushOffsets[i].y)));
+
+		// set the XYZ scale for the mesh
+		scaleXYZ = glm::vec3(sSize, sSize, sSize);
+		// set the XYZ rotation for the mesh
+		XrotationDegrees = 0.0f;
+		YrotationDegrees = 0.0f;
+		ZrotationDegrees = 0.0f;
+		// set the XYZ position for the mesh
+		positionXYZ = glm::vec3(0.0f, sHeight, 0.0f);
+		// keep the model matrix of the bush for the instanced draw
+		bushModels[i] = bushModel * TransformTable::ComputeModel(BuildTransformations(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ));
+
+		AddRoot(bushModel, &rootModels[i * 2]);
+	}
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(10, 10);
+	// draw every bush with one instanced draw
+	DrawSphereMeshInstanced(bushModels, bushCount);
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw every root cone with one instanced draw
+	DrawConeMeshInstanced(rootModels, bushCount * 2);
+	/******************************************************************/
+
+	PopSceneNode();
+}
+
+/// <summary>
+/// Renders all the objects in quadrant three
+/// </summary>
+void SceneManager::RenderQuadrantThree()
+{
+	//QUADRANT 3
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+
+	//CENTER BLOCK	
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 0.5f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("tile"));
+	SetShaderMaterial(SCENE_TAG("blueTile"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//CENTER MULCH
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 0.6f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("rocks"));
+	SetShaderMaterial(SCENE_TAG("cement"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//BOTTOM CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 0.9f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//TOP CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 2.9f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//bottom square
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(4.0f, 4.0f, 4.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 4.9f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//sphere
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(2.5f, 2.5f, 2.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 9.3f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_SPHERE);
+	/******************************************************************/
+
+	//bottom square
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(4.0f, 4.0f, 4.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(55.0f, 13.5f, -75.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PYRAMID4);
+	/******************************************************************/
+
+
+}
+
+/// <summary>
+/// Renders all the objects in quadrant four
+/// </summary>
+void SceneManager::RenderQuadrantFour()
+{
+	//QUADRANT 4
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+	//TREE BED
+	/******************************************************************/
+	// the block, mulch and trees are placed relative to the bed
+	// center, so moving this one node moves all of them
+	PushSceneNode(
+		SCENE_TAG("treeBed"),
+		glm::vec3(1.0f, 1.0f, 1.0f),
+		0.0f,
+		0.0f,
+		0.0f,
+		glm::vec3(-55.0f, 0.0f, -75.0f));
+	/******************************************************************/
+
+	//CENTER BLOCK	
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(20.0f, 0.5f, 20.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.5f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("tile"));
+	SetShaderMaterial(SCENE_TAG("blueTile"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//CENTER MULCH
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(19.0f, 0.5f, 19.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.6f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("rocks"));
+	SetShaderMaterial(SCENE_TAG("cement"));
+	SetTextureUVScale(10, 10);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/******************************************************************/
+
+	//TREES
+	/******************************************************************/
+	// each tree is its own node, at an offset from the bed center
+	const glm::vec2 treeOffsets[] =
+	{
+		glm::vec2(5.0f, 5.0f),
+		glm::vec2(-5.0f, -5.0f),
+		glm::vec2(-5.0f, 5.0f),
+		glm::vec2(5.0f, -5.0f)
+	};
+	const int treeCount = sizeof(treeOffsets) / sizeof(treeOffsets[0]);
+
+	for (int i = 0; i < treeCount; i++)
+	{
+		PushSceneNode(
+			SCENE_TAG("tree"),
+			glm::vec3(1.0f, 1.0f, 1.0f),
+			0.0f,
+			0.0f,
+			0.0f,
+			glm::vec3(treeOffsets[i].x, 0.0f, treeOffsets[i].y));
+		AddTree();
+		PopSceneNode();
+	}
+	/******************************************************************/
+
+	//Pyramid top
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(11.0f, 11.0f, 11.0f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 16.0f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PYRAMID4);
+	/******************************************************************/
+
+	PopSceneNode();
+}
+
+/// <summary>
+/// Renders the divind walls between the quadrants
+/// </summary>
+void SceneManager::RenderQuadrantWalls() 
+{
+	//QUADRANT WALLS
+	
+	// declare the variables for the transformations
+	/******************************************************************/
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+	//FRONT DIVIDER
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, 50.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("DenseBerries"));
+	SetTextureUVScale(10, 5);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	//BACK DIVIDER
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, -90.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("DenseBerries"));
+	SetTextureUVScale(10, 5);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	//LEFT DIVIDER
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 90.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-70.0f, 10.0f, 0.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("DenseBerries"));
+	SetTextureUVScale(10, 5);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	//RIGHT DIVIDER
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 50.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 90.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(70.0f, 10.0f, 0.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("DenseBerries"));
+	SetTextureUVScale(10, 5);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+}
+
+/// <summary>
+/// Renders the outer border walls
+/// </summary>
+void SceneManager::RenderWalls() 
+{
+	//WALLS
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+
+	// BACK WALL
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 90.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, -117.5f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("DenseBerries"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(10, 5);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	// LEFT WALL
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(-97.5f, 10.0f, -20.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	// RIGHT WALL
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(97.5f, 10.0f, -20.0f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+	// FRONT WALL
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(5.0f, 20.0f, 200.0f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 90.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 10.0f, 77.5f);
+
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// draw the mesh with transformation values
+	DrawMesh(MESH_BOX);
+	/****************************************************************/
+
+}
+
+/// <summary>
+/// Add Root builds the model matrices of the two cones of a small root
+/// under a bush on the ground, rootModels must hold two matrices. The
+/// cones are placed relative to the bush model matrix.
+/// </summary>
+void SceneManager::AddRoot(const glm::mat4& bushModel, glm::mat4* rootModels) 
+{
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+	//LEFT BOTTOM CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.9f, 0.0f);
+	// keep the model matrix of the cone for the instanced draw
+	rootModels[0] = bushModel * TransformTable::ComputeModel(BuildTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ));
+	/******************************************************************/
+
+	//TOP CONE
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 2.9f, 0.0f);
+	// keep the model matrix of the cone for the instanced draw
+	rootModels[1] = bushModel * TransformTable::ComputeModel(BuildTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ));
+	/******************************************************************/
+}
+
+/// <summary>
+/// Add Tree draws a tree, two trunk cones and a pyramid of leaves, under the scene node that is
+/// open, which is the center of the tree on the ground. Moving the tree node moves the whole tree.
+/// </summary>
+void SceneManager::AddTree()
+{
+	/******************************************************************/
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+	/******************************************************************/
+
+	//Useful variables for the tree
+	float pSize = 8.5f;
+	float pHeight = 6.7f;
+
+	//cone bottom
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.0f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.6f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//cone top
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 2.5f, 0.5f);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 180.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 2.6f, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("bark"));
+	SetShaderMaterial(SCENE_TAG("bark"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_CONE);
+	/******************************************************************/
+
+	//Pyramid
+	/******************************************************************/
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(pSize, pSize, pSize);
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, pHeight, 0.0f);
+	// set the transformations into memory to be used on the drawn meshes
+	SetTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	SetShaderColor(1, 1, 1, 1);
+	SetShaderTexture(SCENE_TAG("Hedge"));
+	SetShaderMaterial(SCENE_TAG("bush"));
+	SetTextureUVScale(1, 1);
+	// draw the mesh with transformation values
+	DrawMesh(MESH_PYRAMID4);
+	/******************************************************************/
 }
\ No newline at end of file
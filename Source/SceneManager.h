@@ -1,130 +1,618 @@
-///////////////////////////////////////////////////////////////////////////////
-// shadermanager.h
-// ============
-// manage the loading and rendering of 3D scenes
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
-
-#include <string>
-#include <vector>
-
-/***********************************************************
- *  SceneManager
- *
- *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
- ***********************************************************/
-class SceneManager
-{
-public:
-	// constructor
-	SceneManager(ShaderManager *pShaderManager);
-	// destructor
-	~SceneManager();
-
-	struct TEXTURE_INFO
-	{
-		std::string tag;
-		uint32_t ID;
-	};
-
-	struct OBJECT_MATERIAL
-	{
-		float ambientStrength;
-		glm::vec3 ambientColor;
-		glm::vec3 diffuseColor;
-		glm::vec3 specularColor;
-		float shininess;
-		std::string tag;
-	};
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
-	std::vector<OBJECT_MATERIAL> m_objectMaterials;
-
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
-	void BindGLTextures();
-	// free the loaded OpenGL textures
-	void DestroyGLTextures();
-	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
-	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
-
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
-		glm::vec3 scaleXYZ,
-		float XrotationDegrees,
-		float YrotationDegrees,
-		float ZrotationDegrees,
-		glm::vec3 positionXYZ);
-
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
-
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-public:
-
-	//Loads the textures for the scene
-	void LoadSceneTextures();
-	//Loads meshes and lights
-	void PrepareScene();
-	//Renders the basic scene by calling the other render functions
-	void RenderScene();
-	//Light defining function
-	void SetupSceneLights();
-	//Object material definition
-	void DefineObjectMaterials();
-	//Renders the main floor
-	void RenderFloor();
-	//Renders the four side walls
-	void RenderWalls();
-	//Renders All walls that divide the quadrants
-	void RenderQuadrantWalls();
-	//Renders All the objects in quadrant one
-	void RenderQuadrantOne();
-	//Renders all the objects in quadrant two
-	void RenderQuadrantTwo();
-	//Renders all the objects in quadrant three
-	void RenderQuadrantThree();
-	//Renders all the objects in quadrant four
-	void RenderQuadrantFour();
-	//Adds a root for a short bush at each x,z coordinate
-	//helper function for RenderQuadrantTwo
-	void AddRoot(float x, float z);
-
+///////////////////////////////////////////////////////////////////////////////
+// shadermanager.h
+// ============
+// manage the loading and rendering of 3D scenes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "LightManager.h"
+#include "LightClusters.h"
+#include "WorkerPool.h"
+#include "BoundingVolumeHierarchy.h"
+#include "PortalVisibility.h"
+#include "BasicMeshBuffer.h"
+#include "GpuCulling.h"
+#include "StaticBatches.h"
+#include "SceneGraph.h"
+#include "SceneTags.h"
+#include "AsyncTextureLoader.h"
+#include "TextureUploader.h"
+#include "TextureArrays.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneManager
+ *
+ *  This class contains the code for preparing and rendering
+ *  3D scenes, including the shader settings.
+ ***********************************************************/
+class SceneManager
+{
+public:
+	// constructor
+	SceneManager(ShaderManager *pShaderManager, ShaderUniforms* pShaderUniforms);
+	// destructor
+	~SceneManager();
+
+	struct TEXTURE_INFO
+	{
+		std::string tag;
+		uint32_t ID;
+		// size and format of the loaded image, which decide
+		// the texture array it goes into
+		int width;
+		int height;
+		GLenum internalFormat;
+		int levelCount;
+		// texture array and layer the texture is read from,
+		// the placeholder layer until the image is loaded
+		int arrayIndex;
+		int layer;
+	};
+
+	struct OBJECT_MATERIAL
+	{
+		float ambientStrength;
+		glm::vec3 ambientColor;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		std::string tag;
+	};
+
+	// basic shape meshes that can be drawn by the scene manager
+	enum MESH_TYPE
+	{
+		MESH_PLANE,
+		MESH_BOX,
+		MESH_CONE,
+		MESH_SPHERE,
+		MESH_TORUS,
+		MESH_PYRAMID4,
+		MESH_TYPE_COUNT
+	};
+
+	// tessellation levels of the curved meshes, level 0 is the
+	// full mesh and each next level has fewer triangles
+	static const int MESH_LOD_COUNT = 3;
+
+	// objects tested against the view frustum in one frame
+	struct CULLING_STATS
+	{
+		int testedObjects;
+		int culledObjects;
+		// bounding volume tree nodes tested
+		int nodesVisited;
+		// scene cells seen through the portals
+		int visibleCells;
+		int cellCount;
+		// true when the objects were tested on the GPU, the
+		// object counts are then not known on the CPU
+		bool bGpuCulling;
+	};
+
+	// draws sent to OpenGL in one frame
+	struct DRAW_STATS
+	{
+		// objects drawn
+		int objectDraws;
+		// OpenGL draw calls made for them
+		int drawCalls;
+		// triangles drawn at each tessellation level, not
+		// known when the objects are culled on the GPU
+		int levelTriangles[MESH_LOD_COUNT];
+	};
+
+private:
+	// shader state and model matrix of one recorded draw
+	struct DRAW_PACKET
+	{
+		glm::mat4 model;
+		// inverse transpose of the model matrix, for normals
+		glm::mat3 normalMatrix;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		int textureSlot;
+		int materialIndex;
+		MESH_TYPE mesh;
+		// tessellation level the mesh is drawn at
+		int lod;
+		bool bUseTexture;
+	};
+
+	// one object material laid out for a std140 uniform block
+	struct MATERIAL_BLOCK_ENTRY
+	{
+		glm::vec3 ambientColor;
+		float ambientStrength;
+		glm::vec3 diffuseColor;
+		float padding;
+		glm::vec3 specularColor;
+		float shininess;
+	};
+
+	// an object of the scene, recorded once when the scene is
+	// prepared, with the world bounds of its mesh
+	struct SCENE_OBJECT
+	{
+		DRAW_PACKET packet;
+		BOUNDING_BOX bounds;
+		// true once the object has been moved, moving objects
+		// are kept in their own bounding volume tree
+		bool bDynamic;
+		// portal cell that fully holds the object, -1 when the
+		// object is not inside a single cell
+		int cell;
+	};
+
+	// copies of one mesh drawn with a single instanced draw,
+	// the object holds the shared draw state and the bounds
+	// of all the copies
+	struct INSTANCE_GROUP
+	{
+		SCENE_OBJECT object;
+		int firstInstance;
+		int instanceCount;
+	};
+
+	// per draw values of a multi-draw, laid out for a std430
+	// storage block and read with the draw index
+	struct DRAW_DATA_ENTRY
+	{
+		glm::mat4 model;
+		// the normal matrix in the upper 3x3, a std430 mat3
+		// would pad each column to 4 floats anyway
+		glm::mat4 normalMatrix;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		int materialIndex;
+		// layer of the texture array, or the texture slot when
+		// the textures are not in arrays, -1 when the draw is
+		// not textured
+		int textureLayer;
+	};
+
+	// indirect commands of the GPU culling pass that are drawn
+	// with the same texture or texture array bound
+	struct GPU_TEXTURE_RUN
+	{
+		int firstCommand;
+		int commandCount;
+		// texture group, -1 when no command of the run is textured
+		int textureGroup;
+	};
+
+	// sort key and draw list position of one recorded draw
+	struct DRAW_SORT_ENTRY
+	{
+		uint64_t key;
+		uint32_t packetIndex;
+	};
+
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to resolved shader uniform handles
+	ShaderUniforms* m_pShaderUniforms;
+	// pointer to the scene light sources
+	LightManager* m_lightManager;
+	// pointer to the threads shared by the per-frame work
+	WorkerPool* m_workerPool;
+	// pointer to the view cluster light lists
+	LightClusterGrid* m_lightClusters;
+	// light positions and ranges gathered for the clusters
+	std::vector<glm::vec4> m_lightSpheres;
+	// total number of loaded textures
+	int m_loadedTextures;
+	// loaded textures info
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// texture arrays the loaded textures are copied into
+	TextureArraySet* m_textureArrays;
+	// true when the draws select their texture by array layer
+	bool m_bUseTextureArrays;
+	// changed whenever a texture moves to a new array layer
+	int m_textureLayout;
+	// decodes the texture image files off the render thread
+	AsyncTextureLoader* m_textureLoader;
+	// uploads the decoded images on its own shared context
+	TextureUploader* m_textureUploader;
+	// time the first texture was requested, for the load report
+	std::chrono::high_resolution_clock::time_point m_textureLoadStart;
+	// memory of the loaded textures, and what they would take
+	// without block compression
+	uint64_t m_textureMemoryBytes;
+	uint64_t m_uncompressedTextureBytes;
+	// defined object materials
+	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// texture slots and material indexes by tag
+	SceneTagTable m_textureTags;
+	SceneTagTable m_materialTags;
+	// uniform buffer holding every defined material
+	GLuint m_materialBuffer;
+	// true when the shader selects materials by index
+	bool m_bUseMaterialBlock;
+	// material selected by the last submitted draw
+	int m_appliedMaterialIndex;
+	// tags that have already been reported as missing
+	std::vector<uint32_t> m_reportedTags;
+	// state applied to the next recorded draw
+	DRAW_PACKET m_drawState;
+	// transform applied to the next recorded draw
+	TRANSFORM_VALUES m_drawTransform;
+	// transforms of the scene objects and of the group nodes
+	// that place them
+	SceneGraph* m_sceneGraph;
+	// scene graph node of every scene object, by object ID
+	std::vector<int> m_objectNodes;
+	// scene object of every node, -1 for a group node
+	std::vector<int> m_nodeObjects;
+	// tag hash of every node, 0 for the object nodes
+	std::vector<uint32_t> m_nodeTags;
+	// group nodes opened while the scene is defined, and their
+	// world matrices for the static batches
+	std::vector<int> m_openNodes;
+	std::vector<glm::mat4> m_openNodeWorlds;
+	// every object of the scene
+	std::vector<SCENE_OBJECT> m_sceneObjects;
+	// meshes drawn as instances and the matrices of every
+	// instance, placed once when the scene is defined
+	std::vector<INSTANCE_GROUP> m_instanceGroups;
+	std::vector<MESH_INSTANCE> m_meshInstances;
+	// bounding volume trees over the objects that never moved
+	// and over the objects that have been moved
+	BoundingVolumeHierarchy* m_staticTree;
+	BoundingVolumeHierarchy* m_dynamicTree;
+	// cells of the scene, the quadrants, and the openings
+	// between them
+	PortalVisibility m_portalCells;
+	// bounding volume trees over the unmoved objects of each
+	// cell, the static tree holds the objects in no cell
+	std::vector<BoundingVolumeHierarchy*> m_cellTrees;
+	// cells that can be seen from the camera this frame
+	uint32_t m_visibleCells;
+	// moving objects and their bounds in dynamic tree order
+	std::vector<int> m_dynamicObjects;
+	std::vector<BOUNDING_BOX> m_dynamicBounds;
+	// set when an object moved into the dynamic tree, or a
+	// dynamic object changed its bounds
+	bool m_bRebuildTrees;
+	bool m_bRefitDynamicTree;
+	// objects found inside the view frustum this frame
+	std::vector<int> m_visibleObjects;
+	// draws recorded for the current frame
+	std::vector<DRAW_PACKET> m_drawList;
+	// recorded draws in sorted order and the sort buffer
+	std::vector<DRAW_SORT_ENTRY> m_sortEntries;
+	std::vector<DRAW_SORT_ENTRY> m_sortScratch;
+	// camera matrices of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	glm::vec2 m_viewportSize;
+	// view frustum of the current frame
+	ViewFrustum m_viewFrustum;
+	// frustum test counts of the current frame
+	CULLING_STATS m_cullingStats;
+	// draw call counts of the current frame
+	DRAW_STATS m_drawStats;
+	// basic shape meshes in one shared vertex and index buffer
+	BasicMeshBuffer* m_meshBuffer;
+	// shared buffer mesh of each basic mesh and level, the
+	// meshes that are not curved use the same mesh for all
+	int m_lodMeshes[MESH_TYPE_COUNT][MESH_LOD_COUNT];
+	// camera position and the scale from a view size to a
+	// screen size in pixels, for choosing the mesh levels
+	glm::vec3 m_cameraPosition;
+	float m_lodScale;
+	// per draw values and indirect commands of the frame
+	std::vector<DRAW_DATA_ENTRY> m_drawData;
+	std::vector<DRAW_ELEMENTS_COMMAND> m_drawCommands;
+	GLuint m_drawDataBuffer;
+	GLuint m_drawCommandBuffer;
+	int m_drawBufferCapacity;
+	// true when the context and shader can run the multi-draws
+	bool m_bIndirectSupported;
+	// true when the frame is sent with the multi-draws
+	bool m_bUseIndirectDraws;
+	// compute pass that culls the objects on the GPU
+	GpuCullingPass* m_gpuCulling;
+	// per draw values of every scene object, by object ID
+	GLuint m_instanceDataBuffer;
+	// culling pass command drawing each object, by object ID
+	std::vector<GLuint> m_gpuObjectCommands;
+	// culling pass commands grouped by bound texture
+	std::vector<GPU_TEXTURE_RUN> m_gpuTextureRuns;
+	// texture layout the culling pass commands were grouped by
+	int m_gpuTextureLayout;
+	// objects moved since their culling data was sent
+	std::vector<int> m_gpuDirtyObjects;
+	// true when the culling pass is running
+	bool m_bUseGpuCulling;
+	// floor and walls merged into one mesh per shader state
+	StaticBatchSet* m_staticBatches;
+	// true while the added objects go into the static batches
+	bool m_bRecordStaticBatches;
+
+	// load texture images and convert to OpenGL texture data
+	bool CreateGLTexture(const char* filename, std::string tag);
+	// choose between texture arrays and one texture unit for
+	// each texture
+	void CreateTextureArrays();
+	// send a decoded image to a new OpenGL texture
+	GLuint UploadGLTexture(DECODED_IMAGE& image);
+	// put an uploaded texture in place of the placeholder of
+	// its slot
+	void InstallTexture(int slot, GLuint textureID);
+	// upload the images decoded since the last frame and bind
+	// the textures that finished uploading
+	void UploadDecodedTextures();
+	// get the texel formats the driver can sample
+	uint32_t GetSupportedTextureFormats() const;
+	// keep the size and format of an image, and count its
+	// texture memory
+	void RecordTextureImage(const DECODED_IMAGE& image);
+	// bind loaded OpenGL textures to slots in memory
+	void BindGLTextures();
+	// free the loaded OpenGL textures
+	void DestroyGLTextures();
+	// turn the texture and material tags into integer handles
+	void InternSceneTags();
+	// report a tag that could not be found
+	void ReportMissingTag(const char* tagType, const SceneTag& tag);
+	// find a loaded texture by tag
+	int FindTextureID(const SceneTag& tag);
+	int FindTextureSlot(const SceneTag& tag);
+	// find a defined material by tag
+	bool FindMaterial(const SceneTag& tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(const SceneTag& tag);
+
+	// gather the transformation values
+	// into transform values
+	TRANSFORM_VALUES BuildTransformations(
+		glm::vec3 scaleXYZ,
+		const glm::quat& rotation,
+		glm::vec3 positionXYZ);
+	TRANSFORM_VALUES BuildTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// open a group node under the current one, the meshes
+	// and nodes added until PopSceneNode() are placed relative
+	// to it, returns the node index
+	int PushSceneNode(
+		const SceneTag& nodeTag,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// close the group node opened last
+	void PopSceneNode();
+
+	// set the transformation values 
+	// into the transform buffer
+	void SetTransformations(
+		glm::vec3 scaleXYZ,
+		const glm::quat& rotation,
+		glm::vec3 positionXYZ);
+	void SetTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the color values into the shader
+	void SetShaderColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+
+	// set the texture data into the shader
+	void SetShaderTexture(
+		const SceneTag& textureTag);
+
+	// set the UV scale for the texture mapping
+	void SetTextureUVScale(
+		float u, float v);
+
+	// set the object material into the shader
+	void SetShaderMaterial(
+		const SceneTag& materialTag);
+
+	// add a scene object using a basic mesh with the current settings
+	void DrawMesh(MESH_TYPE mesh);
+	// add copies of a basic mesh with the current settings,
+	// one for each model matrix, drawn with one draw call
+	void DrawMeshInstanced(MESH_TYPE mesh, const glm::mat4* models, int count);
+	void DrawSphereMeshInstanced(const glm::mat4* models, int count);
+	void DrawConeMeshInstanced(const glm::mat4* models, int count);
+	// draw the instanced meshes inside the view frustum
+	void DrawInstanceGroups(DRAW_STATS& instanceStats);
+	// add every object of the scene and build the trees
+	void BuildSceneObjects();
+	// create the static batches and their source meshes
+	void CreateStaticBatches();
+	// add the floor and walls to the static batches
+	void RecordStaticBatches();
+	// draw the static batches inside the view frustum
+	void DrawStaticBatches(DRAW_STATS& batchStats);
+	// define the quadrant cells and the portals joining them
+	void DefinePortalCells();
+	// get the cell that fully holds a box, -1 for none
+	int FindContainingCell(const BOUNDING_BOX& bounds) const;
+	// rebuild or refit the trees after objects moved
+	void UpdateSceneTrees();
+	// build the model matrices of the objects whose transform
+	// values changed and move the objects to them
+	void UpdateObjectTransforms();
+	// put the objects the camera can see into the draw list
+	void CullSceneObjects();
+	// choose the tessellation level of a scene object from its
+	// size on the screen
+	int SelectMeshLod(const SCENE_OBJECT& object) const;
+	// get the shared buffer mesh of a draw
+	int GetLodMesh(const DRAW_PACKET& packet) const;
+	// draw a loaded basic mesh with the values set in the shader
+	void DrawBasicMesh(const DRAW_PACKET& packet);
+
+	// pack the defined materials into the material buffer
+	void CreateMaterialBuffer();
+	// copy a range of materials into the material buffer
+	void UploadMaterials(int firstIndex, int materialCount);
+	// select the material of the next draw
+	void ApplyMaterial(int materialIndex);
+	// get the texture group a draw reads, the texture slot or
+	// the texture array, -1 when it is not textured
+	int GetTextureGroup(const DRAW_PACKET& packet) const;
+	int GetTextureGroup(int textureSlot) const;
+	// get the array layer, or the slot, a draw reads
+	int GetTextureLayer(int textureSlot) const;
+	// select the texture of the next draw
+	void ApplyTexture(int textureSlot);
+	// select the texture or texture array of a multi-draw
+	void ApplyTextureGroup(int textureGroup);
+
+	// build the sort key of a recorded draw
+	uint64_t BuildSortKey(const DRAW_PACKET& packet) const;
+	// sort the recorded draws by shader state and depth
+	void SortDrawList();
+	// draw the recorded draws in sorted order
+	void SubmitDrawList();
+	// build the basic shape meshes into the shared buffers
+	void CreateMeshBuffer();
+	// create the buffers for the multi-draws
+	void CreateIndirectDrawBuffers();
+	// draw the recorded draws in sorted order with a few
+	// multi-draw indirect calls
+	void SubmitIndirectDrawList();
+	// fill the per draw values of a recorded draw
+	void BuildDrawData(const DRAW_PACKET& packet, DRAW_DATA_ENTRY& entry) const;
+	// fill the culling data of a scene object
+	void BuildCullInstance(int objectID, GLuint commandIndex, GPU_CULL_INSTANCE& instance) const;
+	// create the GPU culling pass and send it the scene objects
+	void CreateGpuCulling();
+	// group the scene objects into the culling pass commands
+	// by texture group and mesh
+	void BuildGpuCullGroups();
+	// send the culling data of the objects that moved
+	void UpdateGpuInstances();
+	// draw the objects found by the GPU culling pass
+	void SubmitGpuCulledDrawList();
+
+public:
+
+	// set the camera matrices of the frame being rendered
+	void SetViewTransform(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec2& viewportSize);
+	// check that every portal cell is found visible from the
+	// camera of the view transform, false when one is not
+	bool CheckAllCellsVisible() const;
+
+	// switch the fragment shading to the cluster light lists
+	void SetClusteredLighting(bool bEnabled);
+	// get the view cluster light lists
+	const LightClusterGrid* GetLightClusters() const;
+	// get the texture upload thread, for its upload counts
+	const TextureUploader* GetTextureUploader() const;
+	// get the frustum culling counts of the last frame
+	const CULLING_STATS& GetCullingStats() const;
+	// send the frames with multi-draw indirect calls when the
+	// shader supports them
+	void SetIndirectDraws(bool bEnabled);
+	// get the draw call counts of the last frame
+	const DRAW_STATS& GetDrawStats() const;
+	// cull the objects with the GPU compute pass when it is
+	// supported, optionally against the last frame depth
+	void SetGpuCulling(bool bEnabled, bool bOcclusionCulling);
+
+	// merge the floor and walls again after their definition
+	// changed, only the changed batches are sent
+	void RebuildStaticBatches();
+
+	// number of objects in the scene
+	int GetSceneObjectCount() const;
+	// move a scene object to a new model matrix, until its
+	// transform values are next changed
+	void SetObjectTransform(int objectID, const glm::mat4& model);
+	// move a scene object to a new model matrix with the
+	// normal matrix already built for it
+	void SetObjectTransform(int objectID, const glm::mat4& model, const glm::mat3& normalMatrix);
+	// change the transform values of a scene object, its
+	// model matrix is built when the next frame is rendered
+	void SetObjectPosition(int objectID, const glm::vec3& position);
+	void SetObjectRotation(int objectID, const glm::quat& rotation);
+	void SetObjectRotation(int objectID, const glm::vec3& rotationDegrees);
+	void SetObjectScale(int objectID, const glm::vec3& scale);
+	// find the first group node with a tag, -1 for none
+	int FindSceneNode(const SceneTag& nodeTag) const;
+	// scene graph node of a scene object, -1 for none
+	int GetObjectNode(int objectID) const;
+	// change the transform values of a node relative to its
+	// parent, every object below it moves with it
+	void SetNodePosition(int node, const glm::vec3& position);
+	void SetNodeRotation(int node, const glm::quat& rotation);
+	void SetNodeRotation(int node, const glm::vec3& rotationDegrees);
+	void SetNodeScale(int node, const glm::vec3& scale);
+	// find the nearest scene object hit by a ray, -1 for none
+	int RayCastScene(
+		const glm::vec3& origin,
+		const glm::vec3& direction,
+		float maxDistance,
+		float& hitDistance) const;
+	// find the scene objects that overlap a sphere
+	void FindObjectsInSphere(
+		const glm::vec3& center,
+		float radius,
+		std::vector<int>& objectIDs) const;
+
+	//Loads the textures for the scene
+	void LoadSceneTextures();
+	//Loads meshes and lights
+	void PrepareScene();
+	//Renders the basic scene by calling the other render functions
+	void RenderScene();
+	//Light defining function
+	void SetupSceneLights();
+	//Gets the light sources so lights can be added, changed or removed
+	LightManager* GetLightManager();
+	//Object material definition
+	void DefineObjectMaterials();
+	//Adds a material after the scene has been prepared
+	int AddObjectMaterial(const OBJECT_MATERIAL& material);
+	//Renders the main floor
+	void RenderFloor();
+	//Renders the four side walls
+	void RenderWalls();
+	//Renders All walls that divide the quadrants
+	void RenderQuadrantWalls();
+	//Renders All the objects in quadrant one
+	void RenderQuadrantOne();
+	//Renders all the objects in quadrant two
+	void RenderQuadrantTwo();
+	//Renders all the objects in quadrant three
+	void RenderQuadrantThree();
+	//Renders all the objects in quadrant four
+	void RenderQuadrantFour();
+	//Builds the model matrices of the two root cones of a short bush
+	//helper function for RenderQuadrantTwo
+	void AddRoot(const glm::mat4& bushModel, glm::mat4* rootModels);
+	//Draws the trunk cones and pyramid of a tree under the current scene node
+	//helper function for RenderQuadrantFour
+	void AddTree();
+
 };
\ No newline at end of file
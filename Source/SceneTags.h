@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenetags.h
+// ============
+// intern the texture and material tags into small integer handles
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/***********************************************************
+ *  HashSceneTag()
+ *
+ *  FNV-1a hash of a tag string. This is constexpr so that
+ *  SCENE_TAG() can hash the tags passed as string literals
+ *  in the compiler instead of on every draw.
+ ***********************************************************/
+constexpr uint32_t HashSceneTag(const char* tagName)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*tagName != '\0')
+	{
+		hash = (hash ^ (uint32_t)(unsigned char)(*tagName)) * 16777619u;
+		tagName++;
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  SceneTag
+ *
+ *  A texture or material tag together with its hash. Tags
+ *  written in the scene code are made with SCENE_TAG(), a
+ *  tag made from a string at run time is hashed when it is
+ *  constructed.
+ ***********************************************************/
+struct SceneTag
+{
+	uint32_t hash;
+	// the tag text, compared on lookup and used when
+	// reporting errors
+	const char* name;
+
+	constexpr SceneTag(uint32_t tagHash, const char* tagName)
+		: hash(tagHash), name(tagName)
+	{
+	}
+
+	explicit SceneTag(const char* tagName)
+		: hash(HashSceneTag(tagName)), name(tagName)
+	{
+	}
+};
+
+// make a SceneTag from a string literal, the hash is passed
+// through a template argument so the compiler must work it
+// out, a constexpr call alone only may be
+#define SCENE_TAG(tagName) \
+	SceneTag(std::integral_constant<uint32_t, HashSceneTag(tagName)>::value, tagName)
+
+/***********************************************************
+ *  SceneTagTable
+ *
+ *  This class maps the tags to small integer handles with
+ *  an open addressed table keyed by the tag hash. The table
+ *  is built once at scene preparation time, after that a
+ *  lookup is a masked array index, and a name compare when
+ *  the hash matches, without any heap allocation. Tags with
+ *  the same hash are kept apart by their names.
+ ***********************************************************/
+class SceneTagTable
+{
+public:
+	// constructor
+	SceneTagTable()
+	{
+		m_mask = 0;
+	}
+
+	// remove every tag and size the table for the tag count
+	void Reset(int tagCount)
+	{
+		size_t capacity = 8;
+
+		// keep the table at most half full so probes stay short
+		while (capacity < (size_t)(tagCount * 2))
+		{
+			capacity *= 2;
+		}
+		m_hashes.assign(capacity, 0);
+		m_names.assign(capacity, std::string());
+		m_handles.assign(capacity, -1);
+		m_mask = (uint32_t)(capacity - 1);
+	}
+
+	// add a tag, false when the tag has already been added
+	bool Insert(uint32_t hash, const std::string& name, int handle)
+	{
+		uint32_t index = hash & m_mask;
+
+		if (m_handles.empty() == true)
+		{
+			return(false);
+		}
+		while (m_handles[index] != -1)
+		{
+			if ((m_hashes[index] == hash) && (m_names[index] == name))
+			{
+				return(false);
+			}
+			index = (index + 1) & m_mask;
+		}
+		m_hashes[index] = hash;
+		m_names[index] = name;
+		m_handles[index] = handle;
+
+		return(true);
+	}
+
+	// get the handle of a tag, -1 when the tag was not added
+	int Find(const SceneTag& tag) const
+	{
+		uint32_t index = tag.hash & m_mask;
+
+		if (m_handles.empty() == true)
+		{
+			return(-1);
+		}
+		while (m_handles[index] != -1)
+		{
+			if ((m_hashes[index] == tag.hash) && (strcmp(m_names[index].c_str(), tag.name) == 0))
+			{
+				return(m_handles[index]);
+			}
+			index = (index + 1) & m_mask;
+		}
+
+		return(-1);
+	}
+
+private:
+	std::vector<uint32_t> m_hashes;
+	std::vector<std::string> m_names;
+	std::vector<int> m_handles;
+	uint32_t m_mask;
+};
@@ -0,0 +1,485 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.cpp
+// ============
+// resolve the shader uniform locations once and set them by handle
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderUniforms.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// uniform names for the handles before UNIFORM_LIGHT_SOURCES,
+	// these must stay in the same order as the SHADER_UNIFORM values
+	const char* g_UniformNames[UNIFORM_LIGHT_SOURCES] =
+	{
+		"model",
+		"view",
+		"projection",
+		"viewPosition",
+		"objectColor",
+		"objectTexture",
+		"bUseTexture",
+		"bUseLighting",
+		"UVscale",
+		"material.ambientColor",
+		"material.ambientStrength",
+		"material.diffuseColor",
+		"material.specularColor",
+		"material.shininess",
+		"materialIndex",
+		"lightCount",
+		"bUseClusteredLights",
+		"clusterGridSize",
+		"clusterParams",
+		"bUseDrawData",
+		"bUseTextureArrays",
+		"objectTextureArray",
+		"textureLayer",
+		"bUseMaterialBlock",
+		"bUseLightBuffer",
+		"normalMatrix",
+		"bUseInstanceData"
+	};
+
+	// field names of each entry in the lightSources[] array
+	const char* g_LightFieldNames[LIGHT_UNIFORM_COUNT] =
+	{
+		"position",
+		"ambientColor",
+		"diffuseColor",
+		"specularColor",
+		"focalStrength",
+		"specularIntensity",
+		"ambientStrength"
+	};
+}
+
+/***********************************************************
+ *  ShaderUniforms()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderUniforms::ShaderUniforms()
+{
+	m_programID = 0;
+
+	for (int i = 0; i < UNIFORM_LIGHT_SOURCES; i++)
+	{
+		m_names[i] = g_UniformNames[i];
+	}
+	for (int light = 0; light < MAX_SHADER_LIGHTS; light++)
+	{
+		for (int field = 0; field < LIGHT_UNIFORM_COUNT; field++)
+		{
+			m_names[LightUniform(light, (LIGHT_UNIFORM)field)] =
+				"lightSources[" + std::to_string(light) + "]." + g_LightFieldNames[field];
+		}
+	}
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_locations[i] = -1;
+		m_states[i].type = TYPE_INT;
+		m_states[i].size = 0;
+		m_states[i].bPending = false;
+		m_states[i].bSent = false;
+	}
+	m_pendingCount = 0;
+	memset(&m_currentStats, 0, sizeof(m_currentStats));
+	memset(&m_frameStats, 0, sizeof(m_frameStats));
+}
+
+/***********************************************************
+ *  ~ShaderUniforms()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderUniforms::~ShaderUniforms()
+{
+}
+
+/***********************************************************
+ *  LightUniform()
+ *
+ *  This method is used for getting the handle of a field in
+ *  the shader lightSources[] array.
+ ***********************************************************/
+SHADER_UNIFORM ShaderUniforms::LightUniform(int lightIndex, LIGHT_UNIFORM field)
+{
+	return((SHADER_UNIFORM)(UNIFORM_LIGHT_SOURCES + (lightIndex * LIGHT_UNIFORM_COUNT) + field));
+}
+
+/***********************************************************
+ *  LoadUniforms()
+ *
+ *  This method is used for resolving the locations of all
+ *  the known uniforms in the shader program that is in use.
+ *  It must be called after the shaders have been loaded.
+ *  Any name that does not exist in the program is reported,
+ *  since setting it would otherwise silently do nothing.
+ ***********************************************************/
+bool ShaderUniforms::LoadUniforms()
+{
+	GLint programID = 0;
+	int unknownCount = 0;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &programID);
+	if (programID == 0)
+	{
+		std::cout << "ERROR::SHADER_UNIFORMS: no shader program is in use" << std::endl;
+		return(false);
+	}
+	m_programID = (GLuint)programID;
+
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_locations[i] = glGetUniformLocation(m_programID, m_names[i].c_str());
+		if ((m_locations[i] == -1) &&
+			((i < UNIFORM_FIRST_OPTIONAL) || (i >= UNIFORM_LIGHT_SOURCES)))
+		{
+			std::cout << "WARNING::SHADER_UNIFORMS: unknown uniform name \"" << m_names[i] << "\"" << std::endl;
+			unknownCount++;
+		}
+	}
+
+	// the new program has none of the shadowed values yet
+	InvalidateShadowState();
+
+	std::cout << "INFO: Resolved shader uniforms, " << unknownCount << " unknown names" << std::endl;
+
+	return(unknownCount == 0);
+}
+
+/***********************************************************
+ *  GetName()
+ *
+ *  This method is used for getting the shader name of the
+ *  uniform associated with the passed in handle.
+ ***********************************************************/
+const std::string& ShaderUniforms::GetName(SHADER_UNIFORM uniform) const
+{
+	return(m_names[uniform]);
+}
+
+/***********************************************************
+ *  GetLocation()
+ *
+ *  This method is used for getting the resolved location of
+ *  the uniform associated with the passed in handle.
+ ***********************************************************/
+GLint ShaderUniforms::GetLocation(SHADER_UNIFORM uniform) const
+{
+	return(m_locations[uniform]);
+}
+
+/***********************************************************
+ *  HasUniform()
+ *
+ *  This method is used for checking whether the shader
+ *  program declares the uniform of the passed in handle.
+ ***********************************************************/
+bool ShaderUniforms::HasUniform(SHADER_UNIFORM uniform) const
+{
+	return(m_locations[uniform] != -1);
+}
+
+/***********************************************************
+ *  BindUniformBlock()
+ *
+ *  This method is used for connecting a uniform block that
+ *  is declared in the shader program to a buffer binding
+ *  point. It returns false when the block is not declared.
+ ***********************************************************/
+bool ShaderUniforms::BindUniformBlock(const char* blockName, GLuint bindingPoint)
+{
+	GLuint blockIndex = GL_INVALID_INDEX;
+
+	if (m_programID == 0)
+	{
+		return(false);
+	}
+
+	blockIndex = glGetUniformBlockIndex(m_programID, blockName);
+	if (blockIndex == GL_INVALID_INDEX)
+	{
+		return(false);
+	}
+	glUniformBlockBinding(m_programID, blockIndex, bindingPoint);
+
+	return(true);
+}
+
+/***********************************************************
+ *  BindStorageBlock()
+ *
+ *  This method is used for connecting a shader storage block
+ *  that is declared in the shader program to a buffer binding
+ *  point. Storage blocks need OpenGL 4.3, so this returns
+ *  false on older contexts or when the block is not declared.
+ ***********************************************************/
+bool ShaderUniforms::BindStorageBlock(const char* blockName, GLuint bindingPoint)
+{
+	GLuint blockIndex = GL_INVALID_INDEX;
+
+	if ((m_programID == 0) || (!GLEW_VERSION_4_3))
+	{
+		return(false);
+	}
+
+	blockIndex = glGetProgramResourceIndex(m_programID, GL_SHADER_STORAGE_BLOCK, blockName);
+	if (blockIndex == GL_INVALID_INDEX)
+	{
+		return(false);
+	}
+	glShaderStorageBlockBinding(m_programID, blockIndex, bindingPoint);
+
+	return(true);
+}
+
+/***********************************************************
+ *  setBoolValue()
+ *
+ *  This method is used for staging a bool uniform value.
+ ***********************************************************/
+void ShaderUniforms::setBoolValue(SHADER_UNIFORM uniform, bool value)
+{
+	int intValue = (int)value;
+	StageValue(uniform, TYPE_INT, &intValue, sizeof(intValue));
+}
+
+/***********************************************************
+ *  setIntValue()
+ *
+ *  This method is used for staging an int uniform value.
+ ***********************************************************/
+void ShaderUniforms::setIntValue(SHADER_UNIFORM uniform, int value)
+{
+	StageValue(uniform, TYPE_INT, &value, sizeof(value));
+}
+
+/***********************************************************
+ *  setFloatValue()
+ *
+ *  This method is used for staging a float uniform value.
+ ***********************************************************/
+void ShaderUniforms::setFloatValue(SHADER_UNIFORM uniform, float value)
+{
+	StageValue(uniform, TYPE_FLOAT, &value, sizeof(value));
+}
+
+/***********************************************************
+ *  setVec2Value()
+ *
+ *  This method is used for staging a vec2 uniform value.
+ ***********************************************************/
+void ShaderUniforms::setVec2Value(SHADER_UNIFORM uniform, const glm::vec2& value)
+{
+	StageValue(uniform, TYPE_VEC2, glm::value_ptr(value), sizeof(value));
+}
+
+/***********************************************************
+ *  setVec3Value()
+ *
+ *  This method is used for staging a vec3 uniform value.
+ ***********************************************************/
+void ShaderUniforms::setVec3Value(SHADER_UNIFORM uniform, const glm::vec3& value)
+{
+	StageValue(uniform, TYPE_VEC3, glm::value_ptr(value), sizeof(value));
+}
+
+void ShaderUniforms::setVec3Value(SHADER_UNIFORM uniform, float x, float y, float z)
+{
+	setVec3Value(uniform, glm::vec3(x, y, z));
+}
+
+/***********************************************************
+ *  setVec4Value()
+ *
+ *  This method is used for staging a vec4 uniform value.
+ ***********************************************************/
+void ShaderUniforms::setVec4Value(SHADER_UNIFORM uniform, const glm::vec4& value)
+{
+	StageValue(uniform, TYPE_VEC4, glm::value_ptr(value), sizeof(value));
+}
+
+/***********************************************************
+ *  setMat3Value()
+ *
+ *  This method is used for staging a mat3 uniform value.
+ ***********************************************************/
+void ShaderUniforms::setMat3Value(SHADER_UNIFORM uniform, const glm::mat3& value)
+{
+	StageValue(uniform, TYPE_MAT3, glm::value_ptr(value), sizeof(value));
+}
+
+/***********************************************************
+ *  setMat4Value()
+ *
+ *  This method is used for staging a mat4 uniform value.
+ ***********************************************************/
+void ShaderUniforms::setMat4Value(SHADER_UNIFORM uniform, const glm::mat4& value)
+{
+	StageValue(uniform, TYPE_MAT4, glm::value_ptr(value), sizeof(value));
+}
+
+/***********************************************************
+ *  setSampler2DValue()
+ *
+ *  This method is used for staging the texture slot that a
+ *  sampler2D uniform reads from.
+ ***********************************************************/
+void ShaderUniforms::setSampler2DValue(SHADER_UNIFORM uniform, int textureSlot)
+{
+	StageValue(uniform, TYPE_INT, &textureSlot, sizeof(textureSlot));
+}
+
+/***********************************************************
+ *  StageValue()
+ *
+ *  This method is used for storing a uniform value until
+ *  the next draw. Setting the same uniform twice before a
+ *  draw only keeps the last value.
+ ***********************************************************/
+void ShaderUniforms::StageValue(
+	SHADER_UNIFORM uniform,
+	UNIFORM_TYPE type,
+	const void* value,
+	int size)
+{
+	UNIFORM_STATE& state = m_states[uniform];
+
+	m_currentStats.requested++;
+
+	state.type = type;
+	state.size = size;
+	memcpy(state.pending, value, size);
+	if (state.bPending == false)
+	{
+		state.bPending = true;
+		m_pendingUniforms[m_pendingCount] = uniform;
+		m_pendingCount++;
+	}
+	else
+	{
+		m_currentStats.collapsed++;
+	}
+}
+
+/***********************************************************
+ *  SendValue()
+ *
+ *  This method is used for sending the staged value of a
+ *  uniform to the shader program.
+ ***********************************************************/
+void ShaderUniforms::SendValue(SHADER_UNIFORM uniform)
+{
+	const UNIFORM_STATE& state = m_states[uniform];
+	const GLint location = m_locations[uniform];
+	const float* floatValue = (const float*)state.pending;
+
+	switch (state.type)
+	{
+	case TYPE_INT:
+		glUniform1i(location, *(const int*)state.pending);
+		break;
+	case TYPE_FLOAT:
+		glUniform1f(location, floatValue[0]);
+		break;
+	case TYPE_VEC2:
+		glUniform2fv(location, 1, floatValue);
+		break;
+	case TYPE_VEC3:
+		glUniform3fv(location, 1, floatValue);
+		break;
+	case TYPE_VEC4:
+		glUniform4fv(location, 1, floatValue);
+		break;
+	case TYPE_MAT3:
+		glUniformMatrix3fv(location, 1, GL_FALSE, floatValue);
+		break;
+	case TYPE_MAT4:
+		glUniformMatrix4fv(location, 1, GL_FALSE, floatValue);
+		break;
+	}
+}
+
+/***********************************************************
+ *  ApplyPendingValues()
+ *
+ *  This method is used for sending the staged uniform values
+ *  to the shader program. A value that matches the last one
+ *  sent for the same uniform is skipped. This is called right
+ *  before each draw command.
+ ***********************************************************/
+void ShaderUniforms::ApplyPendingValues()
+{
+	for (int i = 0; i < m_pendingCount; i++)
+	{
+		SHADER_UNIFORM uniform = (SHADER_UNIFORM)m_pendingUniforms[i];
+		UNIFORM_STATE& state = m_states[uniform];
+
+		state.bPending = false;
+
+		// unknown uniforms and unchanged values are not sent
+		if (m_locations[uniform] == -1)
+		{
+			m_currentStats.unknown++;
+			continue;
+		}
+		if ((state.bSent == true) && (memcmp(state.sent, state.pending, state.size) == 0))
+		{
+			m_currentStats.skipped++;
+			continue;
+		}
+
+		SendValue(uniform);
+		memcpy(state.sent, state.pending, state.size);
+		state.bSent = true;
+		m_currentStats.issued++;
+	}
+	m_pendingCount = 0;
+}
+
+/***********************************************************
+ *  InvalidateShadowState()
+ *
+ *  This method is used for forgetting the last sent values
+ *  so that every staged value is sent again.
+ ***********************************************************/
+void ShaderUniforms::InvalidateShadowState()
+{
+	for (int i = 0; i < UNIFORM_COUNT; i++)
+	{
+		m_states[i].bSent = false;
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting a new frame of uniform
+ *  update counts. The counts for the frame that just ended
+ *  are kept for GetFrameStats().
+ ***********************************************************/
+void ShaderUniforms::BeginFrame()
+{
+	m_frameStats = m_currentStats;
+	memset(&m_currentStats, 0, sizeof(m_currentStats));
+}
+
+/***********************************************************
+ *  GetFrameStats()
+ *
+ *  This method is used for getting the uniform update counts
+ *  of the last full frame.
+ ***********************************************************/
+const UNIFORM_STATS& ShaderUniforms::GetFrameStats() const
+{
+	return(m_frameStats);
+}
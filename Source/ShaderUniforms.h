@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.h
+// ============
+// resolve the shader uniform locations once and set them by handle
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+
+// number of light sources declared in the lightSources[] array
+const int MAX_SHADER_LIGHTS = 4;
+// number of materials declared in the MaterialBlock array, a
+// std140 block of this size fits the 16 KB every driver allows
+const int MAX_BLOCK_MATERIALS = 256;
+
+// fields of each entry in the lightSources[] array
+enum LIGHT_UNIFORM
+{
+	LIGHT_POSITION,
+	LIGHT_AMBIENT_COLOR,
+	LIGHT_DIFFUSE_COLOR,
+	LIGHT_SPECULAR_COLOR,
+	LIGHT_FOCAL_STRENGTH,
+	LIGHT_SPECULAR_INTENSITY,
+	LIGHT_AMBIENT_STRENGTH,
+	LIGHT_UNIFORM_COUNT
+};
+
+// handles for every shader uniform that is set by the application
+enum SHADER_UNIFORM
+{
+	UNIFORM_MODEL,
+	UNIFORM_VIEW,
+	UNIFORM_PROJECTION,
+	UNIFORM_VIEW_POSITION,
+	UNIFORM_OBJECT_COLOR,
+	UNIFORM_OBJECT_TEXTURE,
+	UNIFORM_USE_TEXTURE,
+	UNIFORM_USE_LIGHTING,
+	UNIFORM_UV_SCALE,
+	UNIFORM_MATERIAL_AMBIENT_COLOR,
+	UNIFORM_MATERIAL_AMBIENT_STRENGTH,
+	UNIFORM_MATERIAL_DIFFUSE_COLOR,
+	UNIFORM_MATERIAL_SPECULAR_COLOR,
+	UNIFORM_MATERIAL_SHININESS,
+	// the uniforms below are only declared by shaders that use the
+	// buffer based paths, they are not reported when missing
+	UNIFORM_MATERIAL_INDEX,
+	UNIFORM_LIGHT_COUNT,
+	UNIFORM_USE_CLUSTERED_LIGHTS,
+	UNIFORM_CLUSTER_GRID_SIZE,
+	UNIFORM_CLUSTER_PARAMS,
+	UNIFORM_USE_DRAW_DATA,
+	UNIFORM_USE_TEXTURE_ARRAYS,
+	UNIFORM_OBJECT_TEXTURE_ARRAY,
+	UNIFORM_TEXTURE_LAYER,
+	UNIFORM_USE_MATERIAL_BLOCK,
+	UNIFORM_USE_LIGHT_BUFFER,
+	UNIFORM_NORMAL_MATRIX,
+	UNIFORM_USE_INSTANCE_DATA,
+	// the lightSources[] fields follow, LIGHT_UNIFORM_COUNT per light
+	UNIFORM_LIGHT_SOURCES,
+	UNIFORM_COUNT = UNIFORM_LIGHT_SOURCES + (MAX_SHADER_LIGHTS * LIGHT_UNIFORM_COUNT),
+	UNIFORM_FIRST_OPTIONAL = UNIFORM_MATERIAL_INDEX
+};
+
+// counts of the uniform updates made during one frame
+struct UNIFORM_STATS
+{
+	// values passed to the set methods
+	int requested;
+	// values that were sent to OpenGL
+	int issued;
+	// values dropped because the shader already had them
+	int skipped;
+	// values replaced by another set before the next draw
+	int collapsed;
+	// values for uniforms the shader program does not have
+	int unknown;
+};
+
+/***********************************************************
+ *  ShaderUniforms
+ *
+ *  This class resolves the locations of the shader uniforms
+ *  once after the shaders are loaded, so the values can be
+ *  set by handle without a name lookup on every call.
+ *
+ *  It also keeps a shadow copy of the last value sent for
+ *  every uniform. The set methods only stage a value, and
+ *  ApplyPendingValues() sends the staged values that differ
+ *  from the shadow copy right before a draw command.
+ ***********************************************************/
+class ShaderUniforms
+{
+public:
+	// constructor
+	ShaderUniforms();
+	// destructor
+	~ShaderUniforms();
+
+	// get the handle of a field in the lightSources[] array
+	static SHADER_UNIFORM LightUniform(int lightIndex, LIGHT_UNIFORM field);
+
+	// resolve the uniform locations in the shader program
+	// that is currently in use
+	bool LoadUniforms();
+
+	// get the name and resolved location of a uniform
+	const std::string& GetName(SHADER_UNIFORM uniform) const;
+	GLint GetLocation(SHADER_UNIFORM uniform) const;
+	// check whether the shader program declares a uniform
+	bool HasUniform(SHADER_UNIFORM uniform) const;
+
+	// connect a uniform block in the shader program to a
+	// buffer binding point, false when it is not declared
+	bool BindUniformBlock(const char* blockName, GLuint bindingPoint);
+	// connect a shader storage block in the shader program to
+	// a buffer binding point, false when it is not declared
+	bool BindStorageBlock(const char* blockName, GLuint bindingPoint);
+
+	// set the uniform values by handle
+	void setBoolValue(SHADER_UNIFORM uniform, bool value);
+	void setIntValue(SHADER_UNIFORM uniform, int value);
+	void setFloatValue(SHADER_UNIFORM uniform, float value);
+	void setVec2Value(SHADER_UNIFORM uniform, const glm::vec2& value);
+	void setVec3Value(SHADER_UNIFORM uniform, const glm::vec3& value);
+	void setVec3Value(SHADER_UNIFORM uniform, float x, float y, float z);
+	void setVec4Value(SHADER_UNIFORM uniform, const glm::vec4& value);
+	void setMat3Value(SHADER_UNIFORM uniform, const glm::mat3& value);
+	void setMat4Value(SHADER_UNIFORM uniform, const glm::mat4& value);
+	void setSampler2DValue(SHADER_UNIFORM uniform, int textureSlot);
+
+	// send the staged values that changed since the last draw
+	void ApplyPendingValues();
+	// forget the shadow copy so every value is sent again
+	void InvalidateShadowState();
+
+	// start counting the uniform updates for a new frame
+	void BeginFrame();
+	// get the uniform update counts for the last full frame
+	const UNIFORM_STATS& GetFrameStats() const;
+
+private:
+	// the glUniform call used to send a value
+	enum UNIFORM_TYPE
+	{
+		TYPE_INT,
+		TYPE_FLOAT,
+		TYPE_VEC2,
+		TYPE_VEC3,
+		TYPE_VEC4,
+		TYPE_MAT3,
+		TYPE_MAT4
+	};
+
+	// staged and last sent values of one uniform
+	struct UNIFORM_STATE
+	{
+		UNIFORM_TYPE type;
+		int size;
+		bool bPending;
+		bool bSent;
+		unsigned char pending[sizeof(glm::mat4)];
+		unsigned char sent[sizeof(glm::mat4)];
+	};
+
+	// stage a value to be sent before the next draw
+	void StageValue(SHADER_UNIFORM uniform, UNIFORM_TYPE type, const void* value, int size);
+	// send a value to the shader program
+	void SendValue(SHADER_UNIFORM uniform);
+
+	// shadow state for every uniform
+	UNIFORM_STATE m_states[UNIFORM_COUNT];
+	// uniforms that have a staged value
+	int m_pendingUniforms[UNIFORM_COUNT];
+	int m_pendingCount;
+	// update counts for the current and last frames
+	UNIFORM_STATS m_currentStats;
+	UNIFORM_STATS m_frameStats;
+
+	// uniform names as declared in the shader code
+	std::string m_names[UNIFORM_COUNT];
+	// resolved uniform locations, -1 when not found
+	GLint m_locations[UNIFORM_COUNT];
+	// the shader program the locations were resolved in
+	GLuint m_programID;
+};
@@ -0,0 +1,408 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.cpp
+// ============
+// merge meshes that never move into one vertex and index buffer per
+// shader state, so each group is drawn with a single call
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticBatches.h"
+
+#include <cfloat>
+#include <cstddef>
+
+// declaration of global variables
+namespace
+{
+	// check whether two lists of batch items place the same
+	// meshes in the same way
+	bool ItemsMatch(
+		const std::vector<STATIC_BATCH_ITEM>& items,
+		const std::vector<STATIC_BATCH_ITEM>& otherItems)
+	{
+		if (items.size() != otherItems.size())
+		{
+			return(false);
+		}
+
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			if ((items[i].mesh != otherItems[i].mesh) ||
+				(items[i].model != otherItems[i].model) ||
+				(items[i].uvScale != otherItems[i].uvScale))
+			{
+				return(false);
+			}
+		}
+
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  StaticBatchSet()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StaticBatchSet::StaticBatchSet()
+{
+	m_bRecording = false;
+}
+
+/***********************************************************
+ *  ~StaticBatchSet()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StaticBatchSet::~StaticBatchSet()
+{
+	for (size_t i = 0; i < m_batches.size(); i++)
+	{
+		DestroyBatch(m_batches[i]);
+	}
+	m_batches.clear();
+}
+
+/***********************************************************
+ *  AddSourceMesh()
+ *
+ *  This method is used for adding the local geometry of a
+ *  mesh that the batch items can place in the world.
+ ***********************************************************/
+int StaticBatchSet::AddSourceMesh(const MESH_GEOMETRY& geometry)
+{
+	m_sourceMeshes.push_back(geometry);
+	return((int)m_sourceMeshes.size() - 1);
+}
+
+/***********************************************************
+ *  BeginBatches()
+ *
+ *  This method is used for starting a new recording of the
+ *  batch items. The items of the last recording are kept
+ *  to find the batches that changed.
+ ***********************************************************/
+void StaticBatchSet::BeginBatches()
+{
+	for (size_t i = 0; i < m_batches.size(); i++)
+	{
+		m_batches[i].previousItems.swap(m_batches[i].items);
+		m_batches[i].items.clear();
+	}
+	m_bRecording = true;
+}
+
+/***********************************************************
+ *  AddItem()
+ *
+ *  This method is used for adding a mesh to the batch with
+ *  the same shader state, a new batch is started for a
+ *  state that has not been seen.
+ ***********************************************************/
+int StaticBatchSet::AddItem(const STATIC_BATCH_STATE& state, const STATIC_BATCH_ITEM& item)
+{
+	int batchIndex = -1;
+
+	if ((m_bRecording == false) ||
+		(item.mesh < 0) || (item.mesh >= (int)m_sourceMeshes.size()))
+	{
+		return(-1);
+	}
+
+	batchIndex = FindBatch(state);
+	if (batchIndex == -1)
+	{
+		STATIC_BATCH batch;
+
+		batch.state = state;
+		batch.bounds.minPoint = glm::vec3(0.0f);
+		batch.bounds.maxPoint = glm::vec3(0.0f);
+		batch.vertexArray = 0;
+		batch.vertexBuffer = 0;
+		batch.indexBuffer = 0;
+		batch.indexCount = 0;
+		m_batches.push_back(batch);
+		batchIndex = (int)m_batches.size() - 1;
+	}
+	m_batches[batchIndex].items.push_back(item);
+
+	return(batchIndex);
+}
+
+/***********************************************************
+ *  EndBatches()
+ *
+ *  This method is used for finishing the recording. Only
+ *  the batches whose items are different from the last
+ *  recording are baked and sent again, and the batches
+ *  that were not recorded this time are removed.
+ ***********************************************************/
+int StaticBatchSet::EndBatches()
+{
+	int bakedCount = 0;
+	size_t keptCount = 0;
+
+	if (m_bRecording == false)
+	{
+		return(0);
+	}
+	m_bRecording = false;
+
+	for (size_t i = 0; i < m_batches.size(); i++)
+	{
+		STATIC_BATCH& batch = m_batches[i];
+
+		if (batch.items.empty() == true)
+		{
+			DestroyBatch(batch);
+			continue;
+		}
+
+		if ((batch.vertexArray == 0) || (ItemsMatch(batch.items, batch.previousItems) == false))
+		{
+			BakeBatch(batch);
+			bakedCount++;
+		}
+		batch.previousItems.clear();
+
+		if (keptCount != i)
+		{
+			m_batches[keptCount] = batch;
+		}
+		keptCount++;
+	}
+	m_batches.resize(keptCount);
+
+	return(bakedCount);
+}
+
+/***********************************************************
+ *  GetBatchCount()
+ *
+ *  This method is used for getting the number of batches.
+ ***********************************************************/
+int StaticBatchSet::GetBatchCount() const
+{
+	return((int)m_batches.size());
+}
+
+/***********************************************************
+ *  GetBatchState()
+ *
+ *  This method is used for getting the color, texture and
+ *  material shared by the meshes of a batch.
+ ***********************************************************/
+const STATIC_BATCH_STATE& StaticBatchSet::GetBatchState(int batch) const
+{
+	return(m_batches[batch].state);
+}
+
+/***********************************************************
+ *  GetBatchBounds()
+ *
+ *  This method is used for getting the world bounds of all
+ *  the meshes of a batch.
+ ***********************************************************/
+const BOUNDING_BOX& StaticBatchSet::GetBatchBounds(int batch) const
+{
+	return(m_batches[batch].bounds);
+}
+
+/***********************************************************
+ *  GetBatchItemCount()
+ *
+ *  This method is used for getting the number of meshes
+ *  merged into a batch.
+ ***********************************************************/
+int StaticBatchSet::GetBatchItemCount(int batch) const
+{
+	return((int)m_batches[batch].items.size());
+}
+
+/***********************************************************
+ *  GetBatchTriangleCount()
+ *
+ *  This method is used for getting the number of triangles
+ *  drawn for a batch.
+ ***********************************************************/
+int StaticBatchSet::GetBatchTriangleCount(int batch) const
+{
+	return((int)m_batches[batch].indexCount / 3);
+}
+
+/***********************************************************
+ *  DrawBatch()
+ *
+ *  This method is used for drawing every mesh of a batch
+ *  with one call. The model matrix must be the identity and
+ *  the UV scale one, since both are already baked in.
+ ***********************************************************/
+void StaticBatchSet::DrawBatch(int batch) const
+{
+	const STATIC_BATCH& staticBatch = m_batches[batch];
+
+	if (staticBatch.vertexArray == 0)
+	{
+		return;
+	}
+
+	glBindVertexArray(staticBatch.vertexArray);
+	glDrawElements(GL_TRIANGLES, staticBatch.indexCount, GL_UNSIGNED_INT, NULL);
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  FindBatch()
+ *
+ *  This method is used for finding the batch that has the
+ *  same color, texture and material as a state.
+ ***********************************************************/
+int StaticBatchSet::FindBatch(const STATIC_BATCH_STATE& state) const
+{
+	for (size_t i = 0; i < m_batches.size(); i++)
+	{
+		const STATIC_BATCH_STATE& batchState = m_batches[i].state;
+
+		if ((batchState.textureSlot == state.textureSlot) &&
+			(batchState.materialIndex == state.materialIndex) &&
+			(batchState.color == state.color))
+		{
+			return((int)i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  BakeBatch()
+ *
+ *  This method is used for moving the vertices of every
+ *  item of a batch into world space and sending them into
+ *  the batch buffers. Normals are moved by the inverse
+ *  transpose so scaled boxes keep square normals, and the
+ *  triangles of mirrored items are turned around so they
+ *  keep facing out.
+ ***********************************************************/
+void StaticBatchSet::BakeBatch(STATIC_BATCH& batch)
+{
+	MESH_GEOMETRY merged;
+	size_t vertexCount = 0;
+	size_t indexCount = 0;
+
+	for (size_t i = 0; i < batch.items.size(); i++)
+	{
+		vertexCount += m_sourceMeshes[batch.items[i].mesh].vertices.size();
+		indexCount += m_sourceMeshes[batch.items[i].mesh].indices.size();
+	}
+	merged.vertices.reserve(vertexCount);
+	merged.indices.reserve(indexCount);
+
+	batch.bounds.minPoint = glm::vec3(FLT_MAX);
+	batch.bounds.maxPoint = glm::vec3(-FLT_MAX);
+	for (size_t i = 0; i < batch.items.size(); i++)
+	{
+		const STATIC_BATCH_ITEM& item = batch.items[i];
+		const MESH_GEOMETRY& source = m_sourceMeshes[item.mesh];
+		const glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(item.model)));
+		const glm::mat3 linear = glm::mat3(item.model);
+		const bool bMirrored = glm::dot(glm::cross(linear[0], linear[1]), linear[2]) < 0.0f;
+		const GLuint baseVertex = (GLuint)merged.vertices.size();
+
+		for (size_t v = 0; v < source.vertices.size(); v++)
+		{
+			MESH_VERTEX vertex;
+
+			vertex.position = glm::vec3(item.model * glm::vec4(source.vertices[v].position, 1.0f));
+			vertex.normal = glm::normalize(normalMatrix * source.vertices[v].normal);
+			vertex.texCoord = glm::vec2(
+				source.vertices[v].texCoord.x * item.uvScale.x,
+				source.vertices[v].texCoord.y * item.uvScale.y);
+			merged.vertices.push_back(vertex);
+
+			batch.bounds.minPoint = glm::min(batch.bounds.minPoint, vertex.position);
+			batch.bounds.maxPoint = glm::max(batch.bounds.maxPoint, vertex.position);
+		}
+
+		for (size_t t = 0; t + 2 < source.indices.size(); t += 3)
+		{
+			merged.indices.push_back(baseVertex + source.indices[t]);
+			if (bMirrored == true)
+			{
+				merged.indices.push_back(baseVertex + source.indices[t + 2]);
+				merged.indices.push_back(baseVertex + source.indices[t + 1]);
+			}
+			else
+			{
+				merged.indices.push_back(baseVertex + source.indices[t + 1]);
+				merged.indices.push_back(baseVertex + source.indices[t + 2]);
+			}
+		}
+	}
+
+	if (batch.vertexArray == 0)
+	{
+		glGenVertexArrays(1, &batch.vertexArray);
+		glGenBuffers(1, &batch.vertexBuffer);
+		glGenBuffers(1, &batch.indexBuffer);
+	}
+
+	glBindVertexArray(batch.vertexArray);
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		merged.vertices.size() * sizeof(MESH_VERTEX),
+		merged.vertices.data(),
+		GL_STATIC_DRAW);
+	glVertexAttribPointer(
+		MESH_POSITION_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, position));
+	glEnableVertexAttribArray(MESH_POSITION_ATTRIBUTE);
+	glVertexAttribPointer(
+		MESH_NORMAL_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, normal));
+	glEnableVertexAttribArray(MESH_NORMAL_ATTRIBUTE);
+	glVertexAttribPointer(
+		MESH_TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(MESH_VERTEX),
+		(const void*)offsetof(MESH_VERTEX, texCoord));
+	glEnableVertexAttribArray(MESH_TEXCOORD_ATTRIBUTE);
+
+	// the index buffer binding is stored in the vertex array
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.indexBuffer);
+	glBufferData(
+		GL_ELEMENT_ARRAY_BUFFER,
+		merged.indices.size() * sizeof(GLuint),
+		merged.indices.data(),
+		GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	batch.indexCount = (GLsizei)merged.indices.size();
+}
+
+/***********************************************************
+ *  DestroyBatch()
+ *
+ *  This method is used for freeing the buffers of a batch.
+ ***********************************************************/
+void StaticBatchSet::DestroyBatch(STATIC_BATCH& batch)
+{
+	if (batch.indexBuffer != 0)
+	{
+		glDeleteBuffers(1, &batch.indexBuffer);
+		batch.indexBuffer = 0;
+	}
+	if (batch.vertexBuffer != 0)
+	{
+		glDeleteBuffers(1, &batch.vertexBuffer);
+		batch.vertexBuffer = 0;
+	}
+	if (batch.vertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &batch.vertexArray);
+		batch.vertexArray = 0;
+	}
+	batch.indexCount = 0;
+}
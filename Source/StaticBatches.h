@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.h
+// ============
+// merge meshes that never move into one vertex and index buffer per
+// shader state, so each group is drawn with a single call
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "BasicMeshBuffer.h"
+#include "BoundingVolumes.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// shader state shared by every mesh of a static batch
+struct STATIC_BATCH_STATE
+{
+	glm::vec4 color;
+	// texture slot, -1 when the batch is not textured
+	int textureSlot;
+	// material index, -1 when the batch has no material
+	int materialIndex;
+};
+
+// one mesh placed in the world by a static batch
+struct STATIC_BATCH_ITEM
+{
+	// source mesh index
+	int mesh;
+	glm::mat4 model;
+	// texture coordinates are scaled when they are baked
+	glm::vec2 uvScale;
+};
+
+/***********************************************************
+ *  StaticBatchSet
+ *
+ *  This class bakes the world transforms of meshes that
+ *  never move into merged vertex and index buffers. Meshes
+ *  with the same color, texture and material are put into
+ *  the same batch, and each batch is drawn with one call
+ *  and an identity model matrix.
+ *
+ *  The batches are recorded between BeginBatches() and
+ *  EndBatches(). Recording them again after the scene
+ *  definition changes only bakes and sends the batches
+ *  whose meshes are different from the last recording.
+ ***********************************************************/
+class StaticBatchSet
+{
+public:
+	// constructor
+	StaticBatchSet();
+	// destructor
+	~StaticBatchSet();
+
+	// add the local geometry of a mesh the items can place,
+	// returns the source mesh index
+	int AddSourceMesh(const MESH_GEOMETRY& geometry);
+
+	// start recording the batch items again
+	void BeginBatches();
+	// add an item to the batch with the same state, returns
+	// the batch index
+	int AddItem(const STATIC_BATCH_STATE& state, const STATIC_BATCH_ITEM& item);
+	// bake and send the batches that changed, batches left
+	// without items are removed, returns the number baked
+	int EndBatches();
+
+	// number of batches
+	int GetBatchCount() const;
+	// get the shader state of a batch
+	const STATIC_BATCH_STATE& GetBatchState(int batch) const;
+	// get the world bounds of a batch
+	const BOUNDING_BOX& GetBatchBounds(int batch) const;
+	// number of meshes merged into a batch
+	int GetBatchItemCount(int batch) const;
+	// number of triangles in a batch
+	int GetBatchTriangleCount(int batch) const;
+	// draw a batch with the values already set in the shader
+	void DrawBatch(int batch) const;
+
+private:
+	// one merged group of meshes
+	struct STATIC_BATCH
+	{
+		STATIC_BATCH_STATE state;
+		std::vector<STATIC_BATCH_ITEM> items;
+		// items of the last recording, compared to find the
+		// batches that have to be baked again
+		std::vector<STATIC_BATCH_ITEM> previousItems;
+		BOUNDING_BOX bounds;
+		GLuint vertexArray;
+		GLuint vertexBuffer;
+		GLuint indexBuffer;
+		GLsizei indexCount;
+	};
+
+	// find the batch with a state, -1 for none
+	int FindBatch(const STATIC_BATCH_STATE& state) const;
+	// move the items of a batch into world space and send them
+	void BakeBatch(STATIC_BATCH& batch);
+	// free the buffers of a batch
+	void DestroyBatch(STATIC_BATCH& batch);
+
+	// local geometry of the meshes the items place
+	std::vector<MESH_GEOMETRY> m_sourceMeshes;
+	std::vector<STATIC_BATCH> m_batches;
+	// true between BeginBatches() and EndBatches()
+	bool m_bRecording;
+};
@@ -0,0 +1,265 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.cpp
+// ============
+// gather the scene textures into 2D texture arrays by size and format, so
+// a draw selects its texture by array layer instead of by texture unit
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureArrays.h"
+
+#include <algorithm>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// layers an array is created with
+	const int INITIAL_ARRAY_LAYERS = 4;
+	// mid gray shown until the image of a texture is decoded
+	const unsigned char PLACEHOLDER_PIXEL[4] = { 128, 128, 128, 255 };
+}
+
+/***********************************************************
+ *  TextureArraySet()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureArraySet::TextureArraySet()
+{
+	m_maxLayers = 0;
+}
+
+/***********************************************************
+ *  ~TextureArraySet()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureArraySet::~TextureArraySet()
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		glDeleteTextures(1, &m_arrays[i].textureID);
+	}
+	m_arrays.clear();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the placeholder array,
+ *  a single layer of one gray texel, which is array 0. It
+ *  fails when the context cannot copy between textures.
+ ***********************************************************/
+bool TextureArraySet::Initialize()
+{
+	TEXTURE_ARRAY placeholder;
+
+	if (!GLEW_VERSION_4_3)
+	{
+		return(false);
+	}
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &m_maxLayers);
+
+	placeholder.format.width = 1;
+	placeholder.format.height = 1;
+	placeholder.format.internalFormat = GL_RGBA8;
+	placeholder.format.levelCount = 1;
+	placeholder.layerCount = 1;
+	placeholder.layerCapacity = 1;
+	placeholder.textureID = CreateArrayTexture(placeholder.format, placeholder.layerCapacity);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, placeholder.textureID);
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	m_arrays.push_back(placeholder);
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddTexture()
+ *
+ *  This method is used for copying every level of a 2D
+ *  texture into the next free layer of the array with its
+ *  size and format. The array is created on the first
+ *  texture with that size and format, and is grown when it
+ *  is full. The 2D texture is not needed after the copy.
+ ***********************************************************/
+int TextureArraySet::AddTexture(GLuint textureID, const TEXTURE_ARRAY_FORMAT& format, int& layer)
+{
+	int arrayIndex = FindArray(format);
+
+	if (arrayIndex < 0)
+	{
+		TEXTURE_ARRAY textureArray;
+
+		if ((int)m_arrays.size() >= MAX_TEXTURE_ARRAYS)
+		{
+			std::cout << "Could not add texture to an array, all " << MAX_TEXTURE_ARRAYS
+				<< " texture arrays are used" << std::endl;
+			return(-1);
+		}
+		textureArray.format = format;
+		textureArray.layerCount = 0;
+		textureArray.layerCapacity = std::min(INITIAL_ARRAY_LAYERS, m_maxLayers);
+		textureArray.textureID = CreateArrayTexture(format, textureArray.layerCapacity);
+		m_arrays.push_back(textureArray);
+		arrayIndex = (int)m_arrays.size() - 1;
+	}
+
+	TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+	if ((textureArray.layerCount == textureArray.layerCapacity) && (GrowArray(textureArray) == false))
+	{
+		std::cout << "Could not add texture to an array, all " << m_maxLayers
+			<< " layers of its array are used" << std::endl;
+		return(-1);
+	}
+
+	layer = textureArray.layerCount++;
+	for (int level = 0; level < format.levelCount; level++)
+	{
+		glCopyImageSubData(
+			textureID, GL_TEXTURE_2D, level, 0, 0, 0,
+			textureArray.textureID, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+			std::max(format.width >> level, 1), std::max(format.height >> level, 1), 1);
+	}
+
+	return(arrayIndex);
+}
+
+/***********************************************************
+ *  GetArrayCount()
+ *
+ *  This method is used for getting the number of arrays,
+ *  including the placeholder array.
+ ***********************************************************/
+int TextureArraySet::GetArrayCount() const
+{
+	return((int)m_arrays.size());
+}
+
+/***********************************************************
+ *  GetArrayTexture()
+ *
+ *  This method is used for getting the texture object of an
+ *  array, which changes when the array is grown.
+ ***********************************************************/
+GLuint TextureArraySet::GetArrayTexture(int arrayIndex) const
+{
+	return(m_arrays[arrayIndex].textureID);
+}
+
+/***********************************************************
+ *  GetLayerCount()
+ *
+ *  This method is used for getting the number of layers
+ *  used in an array.
+ ***********************************************************/
+int TextureArraySet::GetLayerCount(int arrayIndex) const
+{
+	return(m_arrays[arrayIndex].layerCount);
+}
+
+/***********************************************************
+ *  BindArrays()
+ *
+ *  This method is used for binding each array on the
+ *  texture unit of its index, where the draws that sample
+ *  it find it.
+ ***********************************************************/
+void TextureArraySet::BindArrays() const
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + (GLenum)i);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_arrays[i].textureID);
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  FindArray()
+ *
+ *  This method is used for finding the array that holds
+ *  the textures of a size and format. The placeholder array
+ *  is never handed out to the scene textures.
+ ***********************************************************/
+int TextureArraySet::FindArray(const TEXTURE_ARRAY_FORMAT& format) const
+{
+	for (size_t i = 1; i < m_arrays.size(); i++)
+	{
+		const TEXTURE_ARRAY_FORMAT& arrayFormat = m_arrays[i].format;
+
+		if ((arrayFormat.width == format.width) &&
+			(arrayFormat.height == format.height) &&
+			(arrayFormat.internalFormat == format.internalFormat) &&
+			(arrayFormat.levelCount == format.levelCount))
+		{
+			return((int)i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  GrowArray()
+ *
+ *  This method is used for replacing a full array with one
+ *  that has twice the layers. Every level of the used
+ *  layers is copied in one call, so growing costs a copy on
+ *  the GPU and never a read back.
+ ***********************************************************/
+bool TextureArraySet::GrowArray(TEXTURE_ARRAY& textureArray)
+{
+	const int layerCapacity = std::min(textureArray.layerCapacity * 2, m_maxLayers);
+	GLuint textureID = 0;
+
+	if (layerCapacity <= textureArray.layerCapacity)
+	{
+		return(false);
+	}
+
+	textureID = CreateArrayTexture(textureArray.format, layerCapacity);
+	for (int level = 0; level < textureArray.format.levelCount; level++)
+	{
+		glCopyImageSubData(
+			textureArray.textureID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+			textureID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+			std::max(textureArray.format.width >> level, 1),
+			std::max(textureArray.format.height >> level, 1),
+			textureArray.layerCount);
+	}
+	glDeleteTextures(1, &textureArray.textureID);
+	textureArray.textureID = textureID;
+	textureArray.layerCapacity = layerCapacity;
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateArrayTexture()
+ *
+ *  This method is used for creating the storage of an array
+ *  with all of its levels, sampled the same way as the 2D
+ *  textures of the scene.
+ ***********************************************************/
+GLuint TextureArraySet::CreateArrayTexture(const TEXTURE_ARRAY_FORMAT& format, int layerCapacity) const
+{
+	GLuint textureID = 0;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, format.levelCount, format.internalFormat, format.width, format.height, layerCapacity);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, format.levelCount - 1);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	return(textureID);
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.h
+// ============
+// gather the scene textures into 2D texture arrays by size and format, so
+// a draw selects its texture by array layer instead of by texture unit
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+// most texture arrays, one texture unit each, the units after
+// them are used by the GPU culling pass
+const int MAX_TEXTURE_ARRAYS = 16;
+
+// the textures that can share an array have the same size,
+// format and number of mip levels
+struct TEXTURE_ARRAY_FORMAT
+{
+	GLsizei width;
+	GLsizei height;
+	GLenum internalFormat;
+	GLint levelCount;
+};
+
+/***********************************************************
+ *  TextureArraySet
+ *
+ *  This class keeps one 2D texture array for each texture
+ *  size and format in the scene. AddTexture() copies every
+ *  level of a finished texture into the next free layer of
+ *  its array on the GPU, so the texels are never read back
+ *  or sent again. An array that is full is replaced by one
+ *  with twice the layers, with the layers it had copied
+ *  over the same way.
+ *
+ *  The first array holds a single gray layer that stands in
+ *  for the textures whose images have not been loaded yet.
+ *
+ *  The copies need OpenGL 4.3, and the arrays are made with
+ *  immutable storage, so every level is allocated at once.
+ ***********************************************************/
+class TextureArraySet
+{
+public:
+	// constructor
+	TextureArraySet();
+	// destructor
+	~TextureArraySet();
+
+	// create the placeholder array, false when the copies are
+	// not supported
+	bool Initialize();
+
+	// copy a texture into a layer of the array with its size
+	// and format, returns the array index, or -1 when no
+	// array can take it
+	int AddTexture(GLuint textureID, const TEXTURE_ARRAY_FORMAT& format, int& layer);
+
+	// number of arrays, including the placeholder array
+	int GetArrayCount() const;
+	// get the texture object of an array
+	GLuint GetArrayTexture(int arrayIndex) const;
+	// number of layers used in an array
+	int GetLayerCount(int arrayIndex) const;
+	// bind each array on the texture unit of its index
+	void BindArrays() const;
+
+private:
+	// one texture array and the layers used in it
+	struct TEXTURE_ARRAY
+	{
+		TEXTURE_ARRAY_FORMAT format;
+		GLuint textureID;
+		int layerCount;
+		int layerCapacity;
+	};
+
+	// find the array with a format, -1 when there is none
+	int FindArray(const TEXTURE_ARRAY_FORMAT& format) const;
+	// make an array with room for more layers and copy the
+	// used layers into it
+	bool GrowArray(TEXTURE_ARRAY& textureArray);
+	// create the storage of an array
+	GLuint CreateArrayTexture(const TEXTURE_ARRAY_FORMAT& format, int layerCapacity) const;
+
+	std::vector<TEXTURE_ARRAY> m_arrays;
+	// most layers the driver allows in an array
+	int m_maxLayers;
+};
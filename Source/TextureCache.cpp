@@ -0,0 +1,463 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.cpp
+// ============
+// store decoded textures with their mip levels in files that are mapped
+// and uploaded directly on later launches
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureCache.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// declaration of global variables
+namespace
+{
+	// "TXC1" read as a little endian integer
+	const uint32_t TEXTURE_CACHE_MAGIC = 0x31435854;
+	// raised whenever the file layout changes, so older files
+	// are written again
+	const uint32_t TEXTURE_CACHE_VERSION = 2;
+	// extension added to the source image file name
+	const char* const TEXTURE_CACHE_EXTENSION = ".texcache";
+
+	// FNV-1a constants for 64 bit hashes
+	const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	const uint64_t FNV_PRIME = 1099511628211ULL;
+
+	// channels of the texels of each format
+	const int g_FormatChannels[TEXTURE_FORMAT_COUNT] = { 3, 4, 3, 4, 4 };
+	// bytes of each 4x4 block, 0 for the uncompressed formats
+	const int g_FormatBlockBytes[TEXTURE_FORMAT_COUNT] = { 0, 0, 8, 16, 16 };
+	const char* const g_FormatNames[TEXTURE_FORMAT_COUNT] = { "RGB8", "RGBA8", "BC1", "BC3", "BC7" };
+}
+
+/***********************************************************
+ *  TextureCacheFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureCacheFile::TextureCacheFile()
+{
+	m_pMapping = NULL;
+	m_mappingSize = 0;
+	memset(&m_header, 0, sizeof(m_header));
+	memset(m_levels, 0, sizeof(m_levels));
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_fileDescriptor = -1;
+}
+
+/***********************************************************
+ *  ~TextureCacheFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureCacheFile::~TextureCacheFile()
+{
+	Close();
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for mapping a cache file for
+ *  reading. The mapping is closed again when the file does
+ *  not hold a texture made from the given source hash.
+ ***********************************************************/
+bool TextureCacheFile::Open(const std::string& cacheName, uint64_t sourceHash)
+{
+	Close();
+
+#ifdef _WIN32
+	LARGE_INTEGER fileSize;
+	HANDLE fileHandle = CreateFileA(cacheName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return(false);
+	}
+	m_fileHandle = fileHandle;
+	if ((GetFileSizeEx(fileHandle, &fileSize) == FALSE) || (fileSize.QuadPart < (LONGLONG)sizeof(TEXTURE_CACHE_HEADER)))
+	{
+		Close();
+		return(false);
+	}
+	m_mappingSize = (uint64_t)fileSize.QuadPart;
+	m_mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (NULL == m_mappingHandle)
+	{
+		Close();
+		return(false);
+	}
+	m_pMapping = (const unsigned char*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+	struct stat fileStatus;
+
+	m_fileDescriptor = open(cacheName.c_str(), O_RDONLY);
+	if (m_fileDescriptor < 0)
+	{
+		return(false);
+	}
+	if ((fstat(m_fileDescriptor, &fileStatus) != 0) || (fileStatus.st_size < (off_t)sizeof(TEXTURE_CACHE_HEADER)))
+	{
+		Close();
+		return(false);
+	}
+	m_mappingSize = (uint64_t)fileStatus.st_size;
+	void* pMapping = mmap(NULL, (size_t)m_mappingSize, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+	m_pMapping = (pMapping == MAP_FAILED) ? NULL : (const unsigned char*)pMapping;
+#endif
+
+	if ((NULL == m_pMapping) || (ValidateMapping(sourceHash) == false))
+	{
+		Close();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for unmapping the file.
+ ***********************************************************/
+void TextureCacheFile::Close()
+{
+#ifdef _WIN32
+	if (NULL != m_pMapping)
+	{
+		UnmapViewOfFile(m_pMapping);
+	}
+	if (NULL != m_mappingHandle)
+	{
+		CloseHandle((HANDLE)m_mappingHandle);
+	}
+	if (NULL != m_fileHandle)
+	{
+		CloseHandle((HANDLE)m_fileHandle);
+	}
+#else
+	if (NULL != m_pMapping)
+	{
+		munmap((void*)m_pMapping, (size_t)m_mappingSize);
+	}
+	if (m_fileDescriptor >= 0)
+	{
+		close(m_fileDescriptor);
+	}
+#endif
+	m_pMapping = NULL;
+	m_mappingSize = 0;
+	m_mappingHandle = NULL;
+	m_fileHandle = NULL;
+	m_fileDescriptor = -1;
+}
+
+/***********************************************************
+ *  GetHeader()
+ *
+ *  This method is used for getting the format, size and
+ *  level count of the stored texture.
+ ***********************************************************/
+const TEXTURE_CACHE_HEADER& TextureCacheFile::GetHeader() const
+{
+	return(m_header);
+}
+
+/***********************************************************
+ *  GetLevel()
+ *
+ *  This method is used for getting the size and place of a
+ *  stored mip level.
+ ***********************************************************/
+const TEXTURE_LEVEL& TextureCacheFile::GetLevel(int level) const
+{
+	return(m_levels[level]);
+}
+
+/***********************************************************
+ *  GetTexels()
+ *
+ *  This method is used for getting the first texel of the
+ *  base level, inside the mapping.
+ ***********************************************************/
+const unsigned char* TextureCacheFile::GetTexels() const
+{
+	return(m_pMapping + sizeof(TEXTURE_CACHE_HEADER) + m_header.levelCount * sizeof(TEXTURE_LEVEL));
+}
+
+/***********************************************************
+ *  ValidateMapping()
+ *
+ *  This method is used for checking that the mapped file
+ *  is a cache file of the current version, made from the
+ *  same source bytes, with levels that match a freshly
+ *  laid out chain and a size that holds all of them.
+ ***********************************************************/
+bool TextureCacheFile::ValidateMapping(uint64_t sourceHash)
+{
+	TEXTURE_LEVEL expectedLevels[MAX_TEXTURE_LEVELS];
+	uint64_t expectedBytes = 0;
+	int expectedCount = 0;
+
+	memcpy(&m_header, m_pMapping, sizeof(m_header));
+	if ((m_header.magic != TEXTURE_CACHE_MAGIC) ||
+		(m_header.version != TEXTURE_CACHE_VERSION) ||
+		(m_header.sourceHash != sourceHash) ||
+		(m_header.format >= TEXTURE_FORMAT_COUNT) ||
+		(m_header.width == 0) || (m_header.height == 0) ||
+		(m_header.width > 32768) || (m_header.height > 32768))
+	{
+		return(false);
+	}
+
+	expectedCount = GetTextureLevels(m_header.width, m_header.height, (TEXTURE_FORMAT)m_header.format, expectedLevels, expectedBytes);
+	if ((m_header.levelCount != (uint32_t)expectedCount) ||
+		(m_header.texelBytes != expectedBytes) ||
+		(m_mappingSize != sizeof(TEXTURE_CACHE_HEADER) + expectedCount * sizeof(TEXTURE_LEVEL) + expectedBytes))
+	{
+		return(false);
+	}
+
+	memcpy(m_levels, m_pMapping + sizeof(TEXTURE_CACHE_HEADER), expectedCount * sizeof(TEXTURE_LEVEL));
+	if (memcmp(m_levels, expectedLevels, expectedCount * sizeof(TEXTURE_LEVEL)) != 0)
+	{
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetUncompressedTextureFormat()
+ *
+ *  This function is used for getting the format of decoded
+ *  texels with 3 or 4 channels.
+ ***********************************************************/
+TEXTURE_FORMAT GetUncompressedTextureFormat(int channels)
+{
+	return((channels == 4) ? TEXTURE_FORMAT_RGBA8 : TEXTURE_FORMAT_RGB8);
+}
+
+/***********************************************************
+ *  IsCompressedTextureFormat()
+ *
+ *  This function is used for checking whether a format is
+ *  stored in 4x4 blocks.
+ ***********************************************************/
+bool IsCompressedTextureFormat(TEXTURE_FORMAT format)
+{
+	return(g_FormatBlockBytes[format] > 0);
+}
+
+/***********************************************************
+ *  GetTextureFormatChannels()
+ *
+ *  This function is used for getting the channels of the
+ *  texels a format holds.
+ ***********************************************************/
+int GetTextureFormatChannels(TEXTURE_FORMAT format)
+{
+	return(g_FormatChannels[format]);
+}
+
+/***********************************************************
+ *  GetTextureFormatName()
+ *
+ *  This function is used for getting the name of a format
+ *  for messages.
+ ***********************************************************/
+const char* GetTextureFormatName(TEXTURE_FORMAT format)
+{
+	return(g_FormatNames[format]);
+}
+
+/***********************************************************
+ *  HashTextureSource()
+ *
+ *  This function is used for hashing the bytes of a source
+ *  image file with 64 bit FNV-1a, which is quick next to
+ *  decoding the image and leaves no realistic chance of a
+ *  changed file keeping its hash.
+ ***********************************************************/
+uint64_t HashTextureSource(const unsigned char* data, size_t size)
+{
+	uint64_t hash = FNV_OFFSET_BASIS;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= data[i];
+		hash *= FNV_PRIME;
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  GetTextureCacheName()
+ *
+ *  This function is used for getting the name of the cache
+ *  file of a source image, kept next to the image.
+ ***********************************************************/
+std::string GetTextureCacheName(const std::string& sourceName)
+{
+	return(sourceName + TEXTURE_CACHE_EXTENSION);
+}
+
+/***********************************************************
+ *  GetTextureLevels()
+ *
+ *  This function is used for laying out the mip levels of
+ *  a texture one after another, each half the size of the
+ *  one above it and at least one texel, the same sizes
+ *  OpenGL gives a full mip chain. A level of a compressed
+ *  format takes whole blocks, rounding its size up to a
+ *  multiple of 4 texels.
+ ***********************************************************/
+int GetTextureLevels(int width, int height, TEXTURE_FORMAT format, TEXTURE_LEVEL levels[MAX_TEXTURE_LEVELS], uint64_t& texelBytes)
+{
+	int levelCount = 0;
+
+	memset(levels, 0, MAX_TEXTURE_LEVELS * sizeof(TEXTURE_LEVEL));
+	texelBytes = 0;
+	while (levelCount < MAX_TEXTURE_LEVELS)
+	{
+		levels[levelCount].width = (uint32_t)width;
+		levels[levelCount].height = (uint32_t)height;
+		levels[levelCount].offset = texelBytes;
+		if (IsCompressedTextureFormat(format) == true)
+		{
+			levels[levelCount].size = (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * g_FormatBlockBytes[format];
+		}
+		else
+		{
+			levels[levelCount].size = (uint64_t)width * height * g_FormatChannels[format];
+		}
+		texelBytes += levels[levelCount].size;
+		levelCount++;
+
+		if ((width == 1) && (height == 1))
+		{
+			break;
+		}
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+
+	return(levelCount);
+}
+
+/***********************************************************
+ *  BuildTextureMipChain()
+ *
+ *  This function is used for filling each level after the
+ *  base level with the average of two by two texel blocks
+ *  of the level above, the same box filter drivers use for
+ *  glGenerateMipmap. A level of odd size repeats its last
+ *  row or column.
+ ***********************************************************/
+void BuildTextureMipChain(unsigned char* texels, int channels, int levelCount, const TEXTURE_LEVEL levels[])
+{
+	for (int level = 1; level < levelCount; level++)
+	{
+		const TEXTURE_LEVEL& source = levels[level - 1];
+		const TEXTURE_LEVEL& target = levels[level];
+		const unsigned char* pSource = texels + source.offset;
+		unsigned char* pTarget = texels + target.offset;
+
+		for (uint32_t y = 0; y < target.height; y++)
+		{
+			const uint32_t row0 = std::min(y * 2, source.height - 1);
+			const uint32_t row1 = std::min(y * 2 + 1, source.height - 1);
+
+			for (uint32_t x = 0; x < target.width; x++)
+			{
+				const uint32_t column0 = std::min(x * 2, source.width - 1);
+				const uint32_t column1 = std::min(x * 2 + 1, source.width - 1);
+
+				for (int c = 0; c < channels; c++)
+				{
+					const unsigned int sum =
+						pSource[(row0 * source.width + column0) * channels + c] +
+						pSource[(row0 * source.width + column1) * channels + c] +
+						pSource[(row1 * source.width + column0) * channels + c] +
+						pSource[(row1 * source.width + column1) * channels + c];
+
+					pTarget[(y * target.width + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  WriteTextureCache()
+ *
+ *  This function is used for writing a texture with all of
+ *  its levels to a cache file. A file that could not be
+ *  written completely is removed, so it is not mistaken for
+ *  a good one.
+ ***********************************************************/
+bool WriteTextureCache(
+	const std::string& cacheName,
+	uint64_t sourceHash,
+	int width,
+	int height,
+	TEXTURE_FORMAT format,
+	int levelCount,
+	const TEXTURE_LEVEL levels[],
+	const unsigned char* texels)
+{
+	TEXTURE_CACHE_HEADER header;
+	std::ofstream file;
+	bool bWritten = false;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = TEXTURE_CACHE_MAGIC;
+	header.version = TEXTURE_CACHE_VERSION;
+	header.sourceHash = sourceHash;
+	header.width = (uint32_t)width;
+	header.height = (uint32_t)height;
+	header.format = (uint32_t)format;
+	header.levelCount = (uint32_t)levelCount;
+	header.texelBytes = levels[levelCount - 1].offset + levels[levelCount - 1].size;
+
+	file.open(cacheName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (file.is_open() == false)
+	{
+		return(false);
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)levels, levelCount * sizeof(TEXTURE_LEVEL));
+	file.write((const char*)texels, (std::streamsize)header.texelBytes);
+	file.close();
+	bWritten = (file.fail() == false);
+	if (bWritten == false)
+	{
+		remove(cacheName.c_str());
+	}
+
+	return(bWritten);
+}
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.h
+// ============
+// store decoded textures with their mip levels in files that are mapped
+// and uploaded directly on later launches
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// most mip levels a texture can have, enough for 32768 texels
+const int MAX_TEXTURE_LEVELS = 16;
+
+// formats of the texels of a texture, 8 bits a channel or
+// 4x4 blocks the GPU samples without decompressing them
+enum TEXTURE_FORMAT
+{
+	TEXTURE_FORMAT_RGB8,
+	TEXTURE_FORMAT_RGBA8,
+	// 8 bytes a block, RGB
+	TEXTURE_FORMAT_BC1,
+	// 16 bytes a block, RGB with interpolated alpha
+	TEXTURE_FORMAT_BC3,
+	// 16 bytes a block, RGBA at higher quality
+	TEXTURE_FORMAT_BC7,
+	TEXTURE_FORMAT_COUNT
+};
+
+// place of one mip level in the texels of a texture, as it is
+// stored in a cache file
+struct TEXTURE_LEVEL
+{
+	uint32_t width;
+	uint32_t height;
+	// from the first texel of the base level
+	uint64_t offset;
+	uint64_t size;
+};
+
+// start of a cache file, followed by the levels and then the
+// texels of every level, tightly packed
+struct TEXTURE_CACHE_HEADER
+{
+	uint32_t magic;
+	uint32_t version;
+	// hash of the bytes of the source image file
+	uint64_t sourceHash;
+	uint32_t width;
+	uint32_t height;
+	// one of TEXTURE_FORMAT
+	uint32_t format;
+	uint32_t levelCount;
+	uint64_t texelBytes;
+};
+
+/***********************************************************
+ *  TextureCacheFile
+ *
+ *  This class maps a texture cache file into memory. The
+ *  texels are read straight from the mapping, so only the
+ *  pages that are uploaded are ever read from the disk, and
+ *  nothing is decoded or filtered. A file is only opened
+ *  when it was made from source bytes with the same hash
+ *  and its size matches its header, so a stale or partly
+ *  written file is never used.
+ ***********************************************************/
+class TextureCacheFile
+{
+public:
+	// constructor
+	TextureCacheFile();
+	// destructor
+	~TextureCacheFile();
+
+	// map a cache file, false when it is missing, damaged or
+	// made from a different source image
+	bool Open(const std::string& cacheName, uint64_t sourceHash);
+	// unmap the file
+	void Close();
+
+	// get the stored texture
+	const TEXTURE_CACHE_HEADER& GetHeader() const;
+	const TEXTURE_LEVEL& GetLevel(int level) const;
+	const unsigned char* GetTexels() const;
+
+private:
+	// check the header and levels against the mapped size
+	bool ValidateMapping(uint64_t sourceHash);
+
+	const unsigned char* m_pMapping;
+	uint64_t m_mappingSize;
+	TEXTURE_CACHE_HEADER m_header;
+	TEXTURE_LEVEL m_levels[MAX_TEXTURE_LEVELS];
+	// operating system handles of the mapping
+	void* m_fileHandle;
+	void* m_mappingHandle;
+	int m_fileDescriptor;
+};
+
+// the uncompressed format of texels with 3 or 4 channels
+TEXTURE_FORMAT GetUncompressedTextureFormat(int channels);
+// true for the block compressed formats
+bool IsCompressedTextureFormat(TEXTURE_FORMAT format);
+// channels of the texels a format holds, 3 or 4
+int GetTextureFormatChannels(TEXTURE_FORMAT format);
+// name of a format for messages
+const char* GetTextureFormatName(TEXTURE_FORMAT format);
+
+// hash the bytes of a source image file
+uint64_t HashTextureSource(const unsigned char* data, size_t size);
+// name of the cache file of a source image file
+std::string GetTextureCacheName(const std::string& sourceName);
+// lay out the mip levels of a texture down to one texel,
+// returns the level count and sets the size of every level
+int GetTextureLevels(int width, int height, TEXTURE_FORMAT format, TEXTURE_LEVEL levels[MAX_TEXTURE_LEVELS], uint64_t& texelBytes);
+// fill the levels after the base level by averaging each
+// two by two block of the level above
+void BuildTextureMipChain(unsigned char* texels, int channels, int levelCount, const TEXTURE_LEVEL levels[]);
+// write a texture and its levels to a cache file
+bool WriteTextureCache(
+	const std::string& cacheName,
+	uint64_t sourceHash,
+	int width,
+	int height,
+	TEXTURE_FORMAT format,
+	int levelCount,
+	const TEXTURE_LEVEL levels[],
+	const unsigned char* texels);
@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureencodermain.cpp
+// ============
+// command line tool that encodes the scene texture images to BC1, BC3 or
+// BC7 with their mip chains and writes them as texture cache files
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BlockCompression.h"
+#include "TextureCache.h"
+#include "WorkerPool.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// block rows of a level encoded by one job
+	const int ENCODE_CHUNK_ROWS = 4;
+	// format chosen per image from its alpha
+	const int FORMAT_AUTO = -1;
+
+	// seconds since the start of a timed step
+	double GetSeconds(const std::chrono::steady_clock::time_point& start)
+	{
+		return(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	// true when any texel of an RGBA image is not opaque
+	bool HasAlpha(const unsigned char* texels, int width, int height, int channels)
+	{
+		if (channels != 4)
+		{
+			return(false);
+		}
+		for (size_t i = 0; i < (size_t)width * height; i++)
+		{
+			if (texels[i * 4 + 3] != 255)
+			{
+				return(true);
+			}
+		}
+
+		return(false);
+	}
+
+	// peak signal to noise ratio of a decoded level against
+	// its source texels, over the channels both of them hold
+	double MeasurePSNR(const unsigned char* source, int sourceChannels, const unsigned char* decoded, int width, int height, int channels)
+	{
+		const size_t texelCount = (size_t)width * height;
+		double squaredError = 0.0;
+
+		for (size_t i = 0; i < texelCount; i++)
+		{
+			for (int c = 0; c < channels; c++)
+			{
+				const double difference = (double)source[i * sourceChannels + c] - (double)decoded[i * 4 + c];
+
+				squaredError += difference * difference;
+			}
+		}
+		squaredError /= (double)(texelCount * channels);
+		if (squaredError <= 0.0)
+		{
+			return(99.0);
+		}
+
+		return(10.0 * std::log10(255.0 * 255.0 / squaredError));
+	}
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: TextureEncoder [--format auto|bc1|bc3|bc7] [--threads N] image..." << std::endl;
+		std::cout << "  Writes each image with its mip chain, block compressed, to image"
+			<< GetTextureCacheName("") << std::endl;
+		std::cout << "  auto picks BC1 for opaque images and BC3 for images with alpha" << std::endl;
+	}
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool EncodeImage(const std::string& filename, int requestedFormat, WorkerPool* pWorkerPool);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the tool has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> filenames;
+	int requestedFormat = FORMAT_AUTO;
+	int threadCount = 0;
+	int failedCount = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--format") == 0) && (i + 1 < argc))
+		{
+			const std::string format = argv[++i];
+
+			if (format == "auto")
+			{
+				requestedFormat = FORMAT_AUTO;
+			}
+			else if (format == "bc1")
+			{
+				requestedFormat = TEXTURE_FORMAT_BC1;
+			}
+			else if (format == "bc3")
+			{
+				requestedFormat = TEXTURE_FORMAT_BC3;
+			}
+			else if (format == "bc7")
+			{
+				requestedFormat = TEXTURE_FORMAT_BC7;
+			}
+			else
+			{
+				PrintUsage();
+				return(EXIT_FAILURE);
+			}
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			threadCount = atoi(argv[++i]);
+		}
+		else if (strncmp(argv[i], "--", 2) == 0)
+		{
+			PrintUsage();
+			return(EXIT_FAILURE);
+		}
+		else
+		{
+			filenames.push_back(argv[i]);
+		}
+	}
+	if (filenames.empty() == true)
+	{
+		PrintUsage();
+		return(EXIT_FAILURE);
+	}
+
+	// the scene loads its images bottom row first, and the
+	// cache files have to hold the texels the same way
+	stbi_set_flip_vertically_on_load(true);
+
+	// the pool counts the threads besides the caller, and one
+	// thread needs no pool at all
+	WorkerPool* pWorkerPool = NULL;
+	if (threadCount != 1)
+	{
+		pWorkerPool = new WorkerPool(threadCount - 1);
+	}
+
+	std::cout << "INFO: encoding " << filenames.size() << " images on "
+		<< ((NULL != pWorkerPool) ? pWorkerPool->GetThreadCount() : 1) << " threads, "
+		<< ((IsBlockCompressionSimd() == true) ? "SSE2" : "scalar") << " index search" << std::endl;
+	for (size_t i = 0; i < filenames.size(); i++)
+	{
+		if (EncodeImage(filenames[i], requestedFormat, pWorkerPool) == false)
+		{
+			failedCount++;
+		}
+	}
+	delete pWorkerPool;
+
+	return((failedCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/***********************************************************
+ *  EncodeImage()
+ *
+ *  This function is used for encoding one image file. The
+ *  image is decoded and filtered into its mip chain exactly
+ *  as the scene would, then every level is encoded with the
+ *  block rows split across the worker pool. The cache file
+ *  carries the hash of the image file, so the scene maps it
+ *  in place of decoding the image until the image changes.
+ ***********************************************************/
+bool EncodeImage(const std::string& filename, int requestedFormat, WorkerPool* pWorkerPool)
+{
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	std::vector<unsigned char> fileBytes;
+	TEXTURE_LEVEL sourceLevels[MAX_TEXTURE_LEVELS];
+	TEXTURE_LEVEL levels[MAX_TEXTURE_LEVELS];
+	std::vector<unsigned char> sourceTexels;
+	std::vector<unsigned char> blocks;
+	std::vector<unsigned char> decodedTexels;
+	uint64_t sourceBytes = 0;
+	uint64_t blockBytes = 0;
+	unsigned char* pPixels = NULL;
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	int levelCount = 0;
+	int blockCount = 0;
+	TEXTURE_FORMAT format = TEXTURE_FORMAT_BC1;
+	double encodeSeconds = 0.0;
+	double psnr = 0.0;
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return(false);
+	}
+	fileBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	file.close();
+	if (fileBytes.empty() == false)
+	{
+		pPixels = stbi_load_from_memory(&fileBytes[0], (int)fileBytes.size(), &width, &height, &channels, 0);
+	}
+	if (NULL == pPixels)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return(false);
+	}
+	if ((channels != 3) && (channels != 4))
+	{
+		std::cout << "Not implemented to handle image with " << channels << " channels" << std::endl;
+		stbi_image_free(pPixels);
+		return(false);
+	}
+
+	levelCount = GetTextureLevels(width, height, GetUncompressedTextureFormat(channels), sourceLevels, sourceBytes);
+	sourceTexels.resize((size_t)sourceBytes);
+	memcpy(&sourceTexels[0], pPixels, (size_t)sourceLevels[0].size);
+	stbi_image_free(pPixels);
+	BuildTextureMipChain(&sourceTexels[0], channels, levelCount, sourceLevels);
+
+	if (requestedFormat == FORMAT_AUTO)
+	{
+		format = (HasAlpha(&sourceTexels[0], width, height, channels) == true) ? TEXTURE_FORMAT_BC3 : TEXTURE_FORMAT_BC1;
+	}
+	else
+	{
+		format = (TEXTURE_FORMAT)requestedFormat;
+	}
+	GetTextureLevels(width, height, format, levels, blockBytes);
+	blocks.resize((size_t)blockBytes);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int level = 0; level < levelCount; level++)
+	{
+		const int levelWidth = (int)levels[level].width;
+		const int levelHeight = (int)levels[level].height;
+		const int blockRows = (levelHeight + 3) / 4;
+		const unsigned char* pSource = &sourceTexels[0] + sourceLevels[level].offset;
+		unsigned char* pBlocks = &blocks[0] + levels[level].offset;
+
+		if (NULL != pWorkerPool)
+		{
+			pWorkerPool->ParallelFor(blockRows, ENCODE_CHUNK_ROWS, [&](int begin, int end)
+				{
+					EncodeTextureBlocks(format, pSource, levelWidth, levelHeight, channels, begin, end - begin, pBlocks);
+				});
+		}
+		else
+		{
+			EncodeTextureBlocks(format, pSource, levelWidth, levelHeight, channels, 0, blockRows, pBlocks);
+		}
+		blockCount += blockRows * ((levelWidth + 3) / 4);
+	}
+	encodeSeconds = GetSeconds(start);
+
+	// the base level shows the error the sampled texture has
+	decodedTexels.resize((size_t)width * height * 4);
+	if (DecodeTextureBlocks(format, &blocks[0], width, height, &decodedTexels[0]) == true)
+	{
+		psnr = MeasurePSNR(&sourceTexels[0], channels, &decodedTexels[0], width, height,
+			std::min(channels, GetTextureFormatChannels(format)));
+	}
+
+	const std::string cacheName = GetTextureCacheName(filename);
+	if (WriteTextureCache(cacheName, HashTextureSource(&fileBytes[0], fileBytes.size()),
+		width, height, format, levelCount, levels, &blocks[0]) == false)
+	{
+		std::cout << "Could not write texture cache:" << cacheName << std::endl;
+		return(false);
+	}
+
+	std::cout << "INFO: " << filename << ", " << width << "x" << height << ", "
+		<< levelCount << " levels, " << GetTextureFormatName(format) << ", "
+		<< std::fixed << std::setprecision(2)
+		<< sourceBytes / (1024.0 * 1024.0) << " MB to " << blockBytes / (1024.0 * 1024.0) << " MB ("
+		<< (double)sourceBytes / (double)blockBytes << ":1), PSNR " << psnr << " dB, "
+		<< encodeSeconds * 1000.0 << " ms, " << blockCount / std::max(encodeSeconds, 1.0e-6) / 1.0e6
+		<< " Mblocks/s" << std::defaultfloat << std::endl;
+
+	return(true);
+}
@@ -0,0 +1,490 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureuploader.cpp
+// ============
+// upload decoded texture images on a thread with its own shared OpenGL
+// context, streaming the pixels through a ring of unpack buffers
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureUploader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// number of unpack buffers in the ring, so the thread can
+	// fill one strip while OpenGL reads the ones before it
+	const int UNPACK_BUFFER_COUNT = 3;
+	// size of each unpack buffer
+	const GLsizeiptr UNPACK_BUFFER_SIZE = 4 * 1024 * 1024;
+	// longest single wait on a fence, in nanoseconds, before
+	// the wait is retried
+	const GLuint64 FENCE_WAIT_NANOSECONDS = 1000000000;
+}
+
+/***********************************************************
+ *  TextureUploader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureUploader::TextureUploader()
+{
+	m_uploadWindow = NULL;
+	m_stats.queuedImages = 0;
+	m_stats.uploadedImages = 0;
+	m_stats.uploadedMegabytes = 0.0;
+	m_stats.uploadMilliseconds = 0.0;
+	m_stats.megabytesPerSecond = 0.0;
+	m_bShutdown = false;
+	m_nextBuffer = 0;
+	m_bPersistentMapping = false;
+}
+
+/***********************************************************
+ *  ~TextureUploader()
+ *
+ *  The destructor for the class. The textures and fences
+ *  the render thread has not taken are shared with its
+ *  context, so they are deleted here after the thread ends.
+ ***********************************************************/
+TextureUploader::~TextureUploader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bShutdown = true;
+	}
+	m_wakeCondition.notify_all();
+
+	if (m_thread.joinable() == true)
+	{
+		m_thread.join();
+	}
+
+	for (size_t i = 0; i < m_images.size(); i++)
+	{
+		AsyncTextureLoader::FreeDecodedImage(m_images[i]);
+	}
+	m_images.clear();
+	for (size_t i = 0; i < m_fencedTextures.size(); i++)
+	{
+		glDeleteSync(m_fencedTextures[i].fence);
+		glDeleteTextures(1, &m_fencedTextures[i].texture.textureID);
+	}
+	m_fencedTextures.clear();
+
+	if (NULL != m_uploadWindow)
+	{
+		glfwDestroyWindow(m_uploadWindow);
+		m_uploadWindow = NULL;
+	}
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for creating the hidden window that
+ *  holds the upload context and starting the upload thread.
+ *  GLFW only creates windows on the main thread, while the
+ *  context can then be made current on any thread.
+ ***********************************************************/
+bool TextureUploader::Start(GLFWwindow* pShareWindow)
+{
+	if ((NULL == pShareWindow) || (m_thread.joinable() == true))
+	{
+		return(false);
+	}
+
+	// the context version hints are still the ones the
+	// display window was created with
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	m_uploadWindow = glfwCreateWindow(1, 1, "texture upload", NULL, pShareWindow);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (NULL == m_uploadWindow)
+	{
+		std::cout << "INFO: no shared context for texture uploads, textures are uploaded on the render thread" << std::endl;
+		return(false);
+	}
+
+	m_bPersistentMapping = (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage);
+	m_thread = std::thread(&TextureUploader::UploadLoop, this);
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsRunning()
+ *
+ *  This method is used for checking whether images can be
+ *  queued on the upload thread.
+ ***********************************************************/
+bool TextureUploader::IsRunning() const
+{
+	return(m_thread.joinable());
+}
+
+/***********************************************************
+ *  QueueImage()
+ *
+ *  This method is used for queueing a decoded image to be
+ *  uploaded. It only takes the lock, so it costs the render
+ *  thread nothing however large the image is.
+ ***********************************************************/
+void TextureUploader::QueueImage(const DECODED_IMAGE& image)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_images.push_back(image);
+		m_stats.queuedImages++;
+	}
+	m_wakeCondition.notify_one();
+}
+
+/***********************************************************
+ *  TakeFinishedTextures()
+ *
+ *  This method is used for collecting the textures whose
+ *  fences have been passed. A zero timeout only checks the
+ *  fence, so a texture still being uploaded is left for a
+ *  later frame instead of waited on.
+ ***********************************************************/
+int TextureUploader::TakeFinishedTextures(std::vector<UPLOADED_TEXTURE>& textures)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int takeCount = 0;
+
+	for (size_t i = 0; i < m_fencedTextures.size(); )
+	{
+		GLenum result = glClientWaitSync(m_fencedTextures[i].fence, 0, 0);
+
+		if ((result == GL_ALREADY_SIGNALED) || (result == GL_CONDITION_SATISFIED))
+		{
+			glDeleteSync(m_fencedTextures[i].fence);
+			textures.push_back(m_fencedTextures[i].texture);
+			m_fencedTextures.erase(m_fencedTextures.begin() + i);
+			takeCount++;
+		}
+		else
+		{
+			i++;
+		}
+	}
+	m_stats.queuedImages -= takeCount;
+	m_stats.uploadedImages += takeCount;
+
+	return(takeCount);
+}
+
+/***********************************************************
+ *  GetStats()
+ *
+ *  This method is used for getting the upload counts, for
+ *  reporting the queue depth and the upload bandwidth.
+ ***********************************************************/
+TEXTURE_UPLOAD_STATS TextureUploader::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return(m_stats);
+}
+
+/***********************************************************
+ *  CreateUnpackBuffers()
+ *
+ *  This method is used for creating the ring of pixel
+ *  unpack buffers. With buffer storage they are created
+ *  immutable and mapped once, coherently, so a strip
+ *  written to the memory needs no flush or unmap.
+ ***********************************************************/
+void TextureUploader::CreateUnpackBuffers()
+{
+	const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	m_unpackBuffers.resize(UNPACK_BUFFER_COUNT);
+	m_unpackFences.assign(UNPACK_BUFFER_COUNT, (GLsync)0);
+	m_mappedBuffers.clear();
+	m_nextBuffer = 0;
+
+	glGenBuffers(UNPACK_BUFFER_COUNT, &m_unpackBuffers[0]);
+	for (int i = 0; i < UNPACK_BUFFER_COUNT; i++)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_unpackBuffers[i]);
+		if (m_bPersistentMapping == true)
+		{
+			glBufferStorage(GL_PIXEL_UNPACK_BUFFER, UNPACK_BUFFER_SIZE, NULL, mapFlags);
+			m_mappedBuffers.push_back((unsigned char*)glMapBufferRange(
+				GL_PIXEL_UNPACK_BUFFER, 0, UNPACK_BUFFER_SIZE, mapFlags));
+		}
+		else
+		{
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, UNPACK_BUFFER_SIZE, NULL, GL_STREAM_DRAW);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/***********************************************************
+ *  DestroyUnpackBuffers()
+ *
+ *  This method is used for deleting the unpack buffers and
+ *  their fences. Deleting a buffer also unmaps it.
+ ***********************************************************/
+void TextureUploader::DestroyUnpackBuffers()
+{
+	for (size_t i = 0; i < m_unpackFences.size(); i++)
+	{
+		if (m_unpackFences[i] != 0)
+		{
+			glDeleteSync(m_unpackFences[i]);
+		}
+	}
+	m_unpackFences.clear();
+	m_mappedBuffers.clear();
+	if (m_unpackBuffers.empty() == false)
+	{
+		glDeleteBuffers((GLsizei)m_unpackBuffers.size(), &m_unpackBuffers[0]);
+		m_unpackBuffers.clear();
+	}
+}
+
+/***********************************************************
+ *  UploadLoop()
+ *
+ *  This method is used for running the upload thread. The
+ *  shared context is current on this thread for its whole
+ *  life.
+ ***********************************************************/
+void TextureUploader::UploadLoop()
+{
+	glfwMakeContextCurrent(m_uploadWindow);
+	// image rows are packed without padding, this is state of
+	// the upload context only
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	CreateUnpackBuffers();
+
+	for (;;)
+	{
+		DECODED_IMAGE image;
+		FENCED_TEXTURE fencedTexture;
+		std::chrono::high_resolution_clock::time_point startTime;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this]() { return((m_bShutdown == true) || (m_images.empty() == false)); });
+			if (m_bShutdown == true)
+			{
+				break;
+			}
+			image = m_images.front();
+			m_images.pop_front();
+		}
+
+		startTime = std::chrono::high_resolution_clock::now();
+		fencedTexture.texture.requestID = image.requestID;
+		fencedTexture.texture.textureID = UploadImage(image);
+		fencedTexture.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		// the fence is only passed once it reaches the GPU
+		glFlush();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_fencedTextures.push_back(fencedTexture);
+			m_stats.uploadedMegabytes += (double)(image.levels[image.levelCount - 1].offset +
+				image.levels[image.levelCount - 1].size) / (1024.0 * 1024.0);
+			m_stats.uploadMilliseconds += std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - startTime).count();
+			m_stats.megabytesPerSecond = m_stats.uploadedMegabytes / (m_stats.uploadMilliseconds / 1000.0);
+		}
+		AsyncTextureLoader::FreeDecodedImage(image);
+	}
+
+	DestroyUnpackBuffers();
+	glfwMakeContextCurrent(NULL);
+}
+
+/***********************************************************
+ *  UploadImage()
+ *
+ *  This method is used for building the texture of an image
+ *  from its stored mip levels. Each level is allocated and
+ *  then filled a strip at a time, each strip copied into
+ *  the next unpack buffer of the ring and read from there
+ *  by OpenGL. A strip of a block compressed level is made
+ *  of whole rows of 4x4 blocks, which OpenGL takes as they
+ *  are stored.
+ ***********************************************************/
+GLuint TextureUploader::UploadImage(const DECODED_IMAGE& image)
+{
+	const bool bCompressed = IsCompressedTextureFormat(image.format);
+	const GLenum format = GetTexturePixelFormat(image.format);
+	const GLenum internalFormat = GetTextureInternalFormat(image.format);
+	GLuint textureID = 0;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levelCount - 1);
+
+	for (int level = 0; level < image.levelCount; level++)
+	{
+		const int width = (int)image.levels[level].width;
+		const int height = (int)image.levels[level].height;
+		const unsigned char* pTexels = image.texels + image.levels[level].offset;
+		// a line is a row of texels, or a row of blocks four
+		// texels high
+		const int lineHeight = (bCompressed == true) ? 4 : 1;
+		const int lineCount = (height + lineHeight - 1) / lineHeight;
+		const size_t lineBytes = (size_t)(image.levels[level].size / lineCount);
+		const int stripLines = std::max((int)(UNPACK_BUFFER_SIZE / lineBytes), 1);
+
+		if (bCompressed == true)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0,
+				(GLsizei)image.levels[level].size, NULL);
+		}
+		else
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, NULL);
+		}
+		for (int line = 0; line < lineCount; line += stripLines)
+		{
+			const int buffer = m_nextBuffer;
+			const int stripLineCount = std::min(stripLines, lineCount - line);
+			const int row = line * lineHeight;
+			const int rowCount = std::min(stripLineCount * lineHeight, height - row);
+			const size_t stripBytes = lineBytes * stripLineCount;
+			const unsigned char* pSource = pTexels + lineBytes * line;
+			unsigned char* pStrip = NULL;
+
+			// a line wider than a whole buffer, or a buffer that
+			// could not be mapped, is sent from the image directly
+			if (stripBytes <= (size_t)UNPACK_BUFFER_SIZE)
+			{
+				pStrip = BeginUnpackBuffer(buffer);
+			}
+			if (NULL != pStrip)
+			{
+				memcpy(pStrip, pSource, stripBytes);
+				if (m_bPersistentMapping == false)
+				{
+					glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+				}
+				// with an unpack buffer bound the pointer is an offset
+				pSource = NULL;
+			}
+			else
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			}
+
+			if (bCompressed == true)
+			{
+				glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, row, width, rowCount, internalFormat,
+					(GLsizei)stripBytes, pSource);
+			}
+			else
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, level, 0, row, width, rowCount, format, GL_UNSIGNED_BYTE, pSource);
+			}
+
+			if (NULL != pStrip)
+			{
+				EndUnpackBuffer(buffer);
+				m_nextBuffer = (m_nextBuffer + 1) % UNPACK_BUFFER_COUNT;
+			}
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  BeginUnpackBuffer()
+ *
+ *  This method is used for binding an unpack buffer and
+ *  getting the memory to write the next strip to. It waits
+ *  on the fence of the last strip read from the buffer,
+ *  which only ever holds up the upload thread.
+ ***********************************************************/
+unsigned char* TextureUploader::BeginUnpackBuffer(int buffer)
+{
+	if (m_unpackFences[buffer] != 0)
+	{
+		GLenum result = GL_TIMEOUT_EXPIRED;
+
+		while (result == GL_TIMEOUT_EXPIRED)
+		{
+			result = glClientWaitSync(m_unpackFences[buffer], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_NANOSECONDS);
+		}
+		glDeleteSync(m_unpackFences[buffer]);
+		m_unpackFences[buffer] = 0;
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_unpackBuffers[buffer]);
+	if (m_bPersistentMapping == true)
+	{
+		return(m_mappedBuffers[buffer]);
+	}
+
+	// the fence was passed, so the old contents can be dropped
+	return((unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, UNPACK_BUFFER_SIZE,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+}
+
+/***********************************************************
+ *  EndUnpackBuffer()
+ *
+ *  This method is used for fencing an unpack buffer after
+ *  OpenGL was told to read a strip from it.
+ ***********************************************************/
+void TextureUploader::EndUnpackBuffer(int buffer)
+{
+	m_unpackFences[buffer] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/***********************************************************
+ *  GetTextureInternalFormat()
+ *
+ *  This function is used for getting the OpenGL format a
+ *  texture of a format is stored in. The block compressed
+ *  formats are sampled from their blocks, so they take the
+ *  same memory in the texture as in the cache file.
+ ***********************************************************/
+GLenum GetTextureInternalFormat(TEXTURE_FORMAT format)
+{
+	switch (format)
+	{
+	case TEXTURE_FORMAT_RGB8:
+		return(GL_RGB8);
+	case TEXTURE_FORMAT_BC1:
+		return(GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+	case TEXTURE_FORMAT_BC3:
+		return(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+	case TEXTURE_FORMAT_BC7:
+		return(GL_COMPRESSED_RGBA_BPTC_UNORM);
+	default:
+		return(GL_RGBA8);
+	}
+}
+
+/***********************************************************
+ *  GetTexturePixelFormat()
+ *
+ *  This function is used for getting the OpenGL format of
+ *  the texels of an uncompressed format as they are sent.
+ ***********************************************************/
+GLenum GetTexturePixelFormat(TEXTURE_FORMAT format)
+{
+	return((format == TEXTURE_FORMAT_RGB8) ? GL_RGB : GL_RGBA);
+}
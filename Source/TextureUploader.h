@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureuploader.h
+// ============
+// upload decoded texture images on a thread with its own shared OpenGL
+// context, streaming the pixels through a ring of unpack buffers
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AsyncTextureLoader.h"
+
+#include <GL/glew.h>
+#include "GLFW/glfw3.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// OpenGL format a texture of a format is stored in
+GLenum GetTextureInternalFormat(TEXTURE_FORMAT format);
+// OpenGL format of the texels of an uncompressed format
+GLenum GetTexturePixelFormat(TEXTURE_FORMAT format);
+
+// counts kept across every upload
+struct TEXTURE_UPLOAD_STATS
+{
+	// images queued and not yet handed back as textures
+	int queuedImages;
+	// textures handed back to the render thread
+	int uploadedImages;
+	// pixel data sent to OpenGL
+	double uploadedMegabytes;
+	// time the upload thread spent sending it
+	double uploadMilliseconds;
+	// data sent per second of upload time
+	double megabytesPerSecond;
+};
+
+// a texture built by the upload thread
+struct UPLOADED_TEXTURE
+{
+	// value passed with the image, the texture slot
+	int requestID;
+	GLuint textureID;
+};
+
+/***********************************************************
+ *  TextureUploader
+ *
+ *  This class runs a thread with a hidden window whose
+ *  OpenGL context shares its objects with the render
+ *  context. The thread copies each mip level of a queued
+ *  image into a ring of pixel unpack buffers, a strip of
+ *  rows at a time, and has OpenGL read the texture from
+ *  them, all without the render thread. The buffers are
+ *  mapped once and kept mapped where the driver supports
+ *  persistent mapping, and mapped for each strip otherwise.
+ *  Block compressed levels go through the same buffers in
+ *  strips of whole block rows.
+ *  A fence on each buffer keeps a strip from being written
+ *  over before OpenGL has read it.
+ *
+ *  A finished texture is fenced as well, and is only handed
+ *  back by TakeFinishedTextures() once that fence has been
+ *  passed, checked without waiting, so the render thread
+ *  binds a texture that is complete and never blocks on it.
+ ***********************************************************/
+class TextureUploader
+{
+public:
+	// constructor
+	TextureUploader();
+	// destructor, must run on the thread that called Start()
+	~TextureUploader();
+
+	// create the shared context and start the upload thread,
+	// must be called on the main thread with the render
+	// context current, false when no context could be made
+	bool Start(GLFWwindow* pShareWindow);
+	// true while the upload thread is running
+	bool IsRunning() const;
+
+	// queue a decoded image, the uploader frees its texels
+	void QueueImage(const DECODED_IMAGE& image);
+	// move the textures whose uploads have completed into
+	// textures, returns the number moved
+	int TakeFinishedTextures(std::vector<UPLOADED_TEXTURE>& textures);
+	// get the upload counts so far
+	TEXTURE_UPLOAD_STATS GetStats() const;
+
+private:
+	// a texture waiting on its fence
+	struct FENCED_TEXTURE
+	{
+		UPLOADED_TEXTURE texture;
+		GLsync fence;
+	};
+
+	// create the unpack buffers, on the upload thread
+	void CreateUnpackBuffers();
+	// delete the unpack buffers, on the upload thread
+	void DestroyUnpackBuffers();
+	// upload the images until the uploader is destroyed
+	void UploadLoop();
+	// build the texture of an image through the unpack buffers
+	GLuint UploadImage(const DECODED_IMAGE& image);
+	// wait until OpenGL has read an unpack buffer, on the
+	// upload thread, and get where to write to it
+	unsigned char* BeginUnpackBuffer(int buffer);
+	// fence an unpack buffer after a strip is read from it
+	void EndUnpackBuffer(int buffer);
+
+	GLFWwindow* m_uploadWindow;
+	std::thread m_thread;
+	mutable std::mutex m_mutex;
+	// signals the thread that an image was queued
+	std::condition_variable m_wakeCondition;
+	std::deque<DECODED_IMAGE> m_images;
+	// textures fenced by the upload thread
+	std::vector<FENCED_TEXTURE> m_fencedTextures;
+	TEXTURE_UPLOAD_STATS m_stats;
+	bool m_bShutdown;
+
+	// used only on the upload thread
+	std::vector<GLuint> m_unpackBuffers;
+	std::vector<GLsync> m_unpackFences;
+	// persistently mapped memory of each buffer, empty when
+	// the buffers are mapped for each strip
+	std::vector<unsigned char*> m_mappedBuffers;
+	int m_nextBuffer;
+	bool m_bPersistentMapping;
+};
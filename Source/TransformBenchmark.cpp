@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbenchmark.cpp
+// ============
+// time the model and normal matrix builds of the transform kernels
+// against the glm matrix chain
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformBenchmark.h"
+#include "TransformKernels.h"
+#include "TransformTable.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// seconds since the start of the timed pass
+	double GetSeconds(const std::chrono::steady_clock::time_point& start)
+	{
+		return(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	// a random value between low and high
+	float RandomRange(float low, float high)
+	{
+		return(low + (high - low) * ((float)std::rand() / (float)RAND_MAX));
+	}
+
+	void PrintResult(const char* name, int matrixCount, double seconds, float maxError)
+	{
+		std::cout << "INFO: " << std::setw(8) << name << "  "
+			<< std::fixed << std::setprecision(1) << (matrixCount / seconds) / 1.0e6 << " million matrices per second";
+		if (maxError >= 0.0f)
+		{
+			std::cout << ", largest difference from glm " << std::scientific << std::setprecision(2) << maxError;
+		}
+		std::cout << std::defaultfloat << std::endl;
+	}
+}
+
+/***********************************************************
+ *  RunTransformBenchmark()
+ *
+ *  This function is used for timing how fast the model and
+ *  normal matrices are built. The glm chain is the way the
+ *  scene built its matrices before the transform table,
+ *  one rotate and scale call after another, with the normal
+ *  matrix from a 3x3 inverse. The kernels are given the
+ *  same rotations as quaternions, converted before the
+ *  timing starts as the scene converts them when it is
+ *  defined. Every kernel is checked against the glm results
+ *  as well as timed.
+ ***********************************************************/
+void RunTransformBenchmark(int transformCount, int passCount)
+{
+	std::vector<float> streamValues[TRANSFORM_STREAM_COUNT];
+	std::vector<glm::vec3> rotationDegrees(transformCount);
+	std::vector<glm::mat4> glmModels(transformCount);
+	std::vector<glm::mat3> glmNormalMatrices(transformCount);
+	std::vector<PACKED_MATRIX_3X4> models(transformCount);
+	std::vector<PACKED_MATRIX_3X4> normalMatrices(transformCount);
+	TRANSFORM_STREAMS streams;
+	std::chrono::steady_clock::time_point start;
+	double seconds = 0.0;
+
+	std::srand(330);
+	for (int i = 0; i < TRANSFORM_STREAM_COUNT; i++)
+	{
+		streamValues[i].resize(transformCount);
+		streams.values[i] = streamValues[i].data();
+	}
+	for (int i = 0; i < transformCount; i++)
+	{
+		glm::quat rotation;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			streamValues[TRANSFORM_STREAM_SCALE_X + axis][i] = RandomRange(0.1f, 10.0f);
+			rotationDegrees[i][axis] = RandomRange(-360.0f, 360.0f);
+			streamValues[TRANSFORM_STREAM_POSITION_X + axis][i] = RandomRange(-50.0f, 50.0f);
+		}
+		rotation = TransformTable::EulerToQuaternion(rotationDegrees[i]);
+		streamValues[TRANSFORM_STREAM_ROTATION_X][i] = rotation.x;
+		streamValues[TRANSFORM_STREAM_ROTATION_Y][i] = rotation.y;
+		streamValues[TRANSFORM_STREAM_ROTATION_Z][i] = rotation.z;
+		streamValues[TRANSFORM_STREAM_ROTATION_W][i] = rotation.w;
+	}
+
+	std::cout << "INFO: building " << transformCount << " model and normal matrices "
+		<< passCount << " times" << std::endl;
+
+	start = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < passCount; pass++)
+	{
+		for (int i = 0; i < transformCount; i++)
+		{
+			const glm::vec3 scale(
+				streamValues[TRANSFORM_STREAM_SCALE_X][i],
+				streamValues[TRANSFORM_STREAM_SCALE_Y][i],
+				streamValues[TRANSFORM_STREAM_SCALE_Z][i]);
+			const glm::vec3 position(
+				streamValues[TRANSFORM_STREAM_POSITION_X][i],
+				streamValues[TRANSFORM_STREAM_POSITION_Y][i],
+				streamValues[TRANSFORM_STREAM_POSITION_Z][i]);
+
+			glmModels[i] =
+				glm::translate(position) *
+				glm::rotate(glm::radians(rotationDegrees[i].x), glm::vec3(1.0f, 0.0f, 0.0f)) *
+				glm::rotate(glm::radians(rotationDegrees[i].y), glm::vec3(0.0f, 1.0f, 0.0f)) *
+				glm::rotate(glm::radians(rotationDegrees[i].z), glm::vec3(0.0f, 0.0f, 1.0f)) *
+				glm::scale(scale);
+			glmNormalMatrices[i] = glm::transpose(glm::inverse(glm::mat3(glmModels[i])));
+		}
+	}
+	seconds = GetSeconds(start);
+	PrintResult("glm", transformCount * passCount, seconds, -1.0f);
+
+	for (int kernel = 0; kernel < TRANSFORM_KERNEL_COUNT; kernel++)
+	{
+		float maxError = 0.0f;
+
+		if (IsTransformKernelSupported((TRANSFORM_KERNEL)kernel) == false)
+		{
+			std::cout << "INFO: " << std::setw(8) << GetTransformKernelName((TRANSFORM_KERNEL)kernel)
+				<< "  not supported by this processor" << std::endl;
+			continue;
+		}
+
+		start = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < passCount; pass++)
+		{
+			BuildTransformMatrices((TRANSFORM_KERNEL)kernel, streams, NULL, 0, transformCount, models.data(), normalMatrices.data());
+		}
+		seconds = GetSeconds(start);
+
+		// relative to the scale, as large scales give large
+		// model values and small normal values
+		for (int i = 0; i < transformCount; i++)
+		{
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					const float scale = streamValues[TRANSFORM_STREAM_SCALE_X + column][i];
+
+					maxError = std::fmax(maxError, std::fabs(models[i].rows[row][column] - glmModels[i][column][row]) / scale);
+					maxError = std::fmax(maxError, std::fabs(normalMatrices[i].rows[row][column] - glmNormalMatrices[i][column][row]) * scale);
+				}
+			}
+		}
+		PrintResult(GetTransformKernelName((TRANSFORM_KERNEL)kernel), transformCount * passCount, seconds, maxError);
+	}
+}
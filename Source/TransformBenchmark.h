@@ -0,0 +1,14 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformbenchmark.h
+// ============
+// time the model and normal matrix builds of the transform kernels
+// against the glm matrix chain
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// build the matrices of transformCount random transforms with the glm
+// chain and with each transform kernel the processor runs, and print
+// the matrices built per second
+void RunTransformBenchmark(int transformCount, int passCount);
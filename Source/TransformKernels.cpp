@@ -0,0 +1,497 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformkernels.cpp
+// ============
+// build model matrices and normal matrices for many transforms at once,
+// with SSE or AVX2 when the processor supports them
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernels.h"
+
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORM_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// GCC and Clang only emit the wider instructions in functions
+// marked for them, the processor is checked before they are called
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE __attribute__((target("sse")))
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#endif
+
+// declaration of global variables
+namespace
+{
+	const char* const KERNEL_NAMES[TRANSFORM_KERNEL_COUNT] =
+	{
+		"scalar",
+		"SSE",
+		"AVX2"
+	};
+
+	// build the matrices of one transform
+	void BuildMatricesScalar(const TRANSFORM_STREAMS& streams, int index, PACKED_MATRIX_3X4& model, PACKED_MATRIX_3X4& normalMatrix)
+	{
+		const float scale[3] = {
+			streams.values[TRANSFORM_STREAM_SCALE_X][index],
+			streams.values[TRANSFORM_STREAM_SCALE_Y][index],
+			streams.values[TRANSFORM_STREAM_SCALE_Z][index] };
+		const float position[3] = {
+			streams.values[TRANSFORM_STREAM_POSITION_X][index],
+			streams.values[TRANSFORM_STREAM_POSITION_Y][index],
+			streams.values[TRANSFORM_STREAM_POSITION_Z][index] };
+		const float x = streams.values[TRANSFORM_STREAM_ROTATION_X][index];
+		const float y = streams.values[TRANSFORM_STREAM_ROTATION_Y][index];
+		const float z = streams.values[TRANSFORM_STREAM_ROTATION_Z][index];
+		const float w = streams.values[TRANSFORM_STREAM_ROTATION_W][index];
+		const float xx = 2.0f * x * x;
+		const float yy = 2.0f * y * y;
+		const float zz = 2.0f * z * z;
+		const float xy = 2.0f * x * y;
+		const float xz = 2.0f * x * z;
+		const float yz = 2.0f * y * z;
+		const float wx = 2.0f * w * x;
+		const float wy = 2.0f * w * y;
+		const float wz = 2.0f * w * z;
+		float rotation[3][3];
+
+		// rotation matrix of the unit quaternion, by row and
+		// column
+		rotation[0][0] = 1.0f - yy - zz;
+		rotation[0][1] = xy - wz;
+		rotation[0][2] = xz + wy;
+		rotation[1][0] = xy + wz;
+		rotation[1][1] = 1.0f - xx - zz;
+		rotation[1][2] = yz - wx;
+		rotation[2][0] = xz - wy;
+		rotation[2][1] = yz + wx;
+		rotation[2][2] = 1.0f - xx - yy;
+
+		// the rotation is orthonormal, so the inverse transpose
+		// of rotation * scale is rotation / scale
+		for (int row = 0; row < 3; row++)
+		{
+			for (int column = 0; column < 3; column++)
+			{
+				model.rows[row][column] = rotation[row][column] * scale[column];
+				normalMatrix.rows[row][column] = rotation[row][column] / scale[column];
+			}
+			model.rows[row][3] = position[row];
+			normalMatrix.rows[row][3] = 0.0f;
+		}
+	}
+
+	void BuildTransformMatricesScalar(const TRANSFORM_STREAMS& streams, const int* indices, int first, int count, PACKED_MATRIX_3X4* models, PACKED_MATRIX_3X4* normalMatrices)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			const int index = (NULL != indices) ? indices[i] : first + i;
+
+			BuildMatricesScalar(streams, index, models[index], normalMatrices[index]);
+		}
+	}
+
+#ifdef TRANSFORM_KERNELS_X86
+	// registers of the processor identification, by leaf
+	void ReadCpuid(int leaf, int registers[4])
+	{
+#if defined(_MSC_VER)
+		__cpuidex(registers, leaf, 0);
+#else
+		unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+		__cpuid_count(leaf, 0, eax, ebx, ecx, edx);
+		registers[0] = (int)eax;
+		registers[1] = (int)ebx;
+		registers[2] = (int)ecx;
+		registers[3] = (int)edx;
+#endif
+	}
+
+	// true when the operating system saves the AVX registers
+	bool IsAvxStateEnabled()
+	{
+#if defined(_MSC_VER)
+		return((_xgetbv(0) & 0x6) == 0x6);
+#else
+		unsigned int eax = 0, edx = 0;
+
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return((eax & 0x6) == 0x6);
+#endif
+	}
+
+	bool DetectSse()
+	{
+		int registers[4];
+
+		ReadCpuid(0, registers);
+		if (registers[0] < 1)
+		{
+			return(false);
+		}
+		ReadCpuid(1, registers);
+		return((registers[3] & (1 << 25)) != 0);
+	}
+
+	bool DetectAvx2()
+	{
+		int registers[4];
+		bool bFma = false;
+		bool bAvx = false;
+		bool bOsSave = false;
+
+		ReadCpuid(0, registers);
+		if (registers[0] < 7)
+		{
+			return(false);
+		}
+		ReadCpuid(1, registers);
+		bFma = (registers[2] & (1 << 12)) != 0;
+		bOsSave = (registers[2] & (1 << 27)) != 0;
+		bAvx = (registers[2] & (1 << 28)) != 0;
+		if ((bFma == false) || (bOsSave == false) || (bAvx == false) || (IsAvxStateEnabled() == false))
+		{
+			return(false);
+		}
+		ReadCpuid(7, registers);
+		return((registers[1] & (1 << 5)) != 0);
+	}
+
+	// load the stream values of 4 transforms
+	TARGET_SSE inline __m128 LoadStream4(const float* stream, const int* indices, int first, int i)
+	{
+		if (NULL == indices)
+		{
+			return(_mm_loadu_ps(stream + first + i));
+		}
+		return(_mm_set_ps(stream[indices[i + 3]], stream[indices[i + 2]], stream[indices[i + 1]], stream[indices[i]]));
+	}
+
+	// rotation matrices of 4 unit quaternions, as in
+	// BuildMatricesScalar()
+	TARGET_SSE inline void QuaternionToRotation4(__m128 x, __m128 y, __m128 z, __m128 w, __m128 rotation[3][3])
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 x2 = _mm_add_ps(x, x);
+		const __m128 y2 = _mm_add_ps(y, y);
+		const __m128 z2 = _mm_add_ps(z, z);
+		const __m128 xx = _mm_mul_ps(x, x2);
+		const __m128 yy = _mm_mul_ps(y, y2);
+		const __m128 zz = _mm_mul_ps(z, z2);
+		const __m128 xy = _mm_mul_ps(x, y2);
+		const __m128 xz = _mm_mul_ps(x, z2);
+		const __m128 yz = _mm_mul_ps(y, z2);
+		const __m128 wx = _mm_mul_ps(w, x2);
+		const __m128 wy = _mm_mul_ps(w, y2);
+		const __m128 wz = _mm_mul_ps(w, z2);
+
+		rotation[0][0] = _mm_sub_ps(_mm_sub_ps(one, yy), zz);
+		rotation[0][1] = _mm_sub_ps(xy, wz);
+		rotation[0][2] = _mm_add_ps(xz, wy);
+		rotation[1][0] = _mm_add_ps(xy, wz);
+		rotation[1][1] = _mm_sub_ps(_mm_sub_ps(one, xx), zz);
+		rotation[1][2] = _mm_sub_ps(yz, wx);
+		rotation[2][0] = _mm_sub_ps(xz, wy);
+		rotation[2][1] = _mm_add_ps(yz, wx);
+		rotation[2][2] = _mm_sub_ps(_mm_sub_ps(one, xx), yy);
+	}
+
+	// write one row of 4 matrices, element holds the 4 values of
+	// each column
+	TARGET_SSE inline void StoreRow4(__m128 element[4], const int* indices, int first, int i, int row, PACKED_MATRIX_3X4* matrices)
+	{
+		_MM_TRANSPOSE4_PS(element[0], element[1], element[2], element[3]);
+		for (int lane = 0; lane < 4; lane++)
+		{
+			const int index = (NULL != indices) ? indices[i + lane] : first + i + lane;
+
+			_mm_storeu_ps(matrices[index].rows[row], element[lane]);
+		}
+	}
+
+	TARGET_SSE void BuildTransformMatricesSse(const TRANSFORM_STREAMS& streams, const int* indices, int first, int count, PACKED_MATRIX_3X4* models, PACKED_MATRIX_3X4* normalMatrices)
+	{
+		int i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 scale[3];
+			__m128 inverseScale[3];
+			__m128 position[3];
+			__m128 rotation[3][3];
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				scale[axis] = LoadStream4(streams.values[TRANSFORM_STREAM_SCALE_X + axis], indices, first, i);
+				inverseScale[axis] = _mm_div_ps(_mm_set1_ps(1.0f), scale[axis]);
+				position[axis] = LoadStream4(streams.values[TRANSFORM_STREAM_POSITION_X + axis], indices, first, i);
+			}
+			QuaternionToRotation4(
+				LoadStream4(streams.values[TRANSFORM_STREAM_ROTATION_X], indices, first, i),
+				LoadStream4(streams.values[TRANSFORM_STREAM_ROTATION_Y], indices, first, i),
+				LoadStream4(streams.values[TRANSFORM_STREAM_ROTATION_Z], indices, first, i),
+				LoadStream4(streams.values[TRANSFORM_STREAM_ROTATION_W], indices, first, i),
+				rotation);
+
+			for (int row = 0; row < 3; row++)
+			{
+				__m128 modelRow[4];
+				__m128 normalRow[4];
+
+				for (int column = 0; column < 3; column++)
+				{
+					modelRow[column] = _mm_mul_ps(rotation[row][column], scale[column]);
+					normalRow[column] = _mm_mul_ps(rotation[row][column], inverseScale[column]);
+				}
+				modelRow[3] = position[row];
+				normalRow[3] = _mm_setzero_ps();
+				StoreRow4(modelRow, indices, first, i, row, models);
+				StoreRow4(normalRow, indices, first, i, row, normalMatrices);
+			}
+		}
+
+		// the transforms left over
+		if (i < count)
+		{
+			BuildTransformMatricesScalar(
+				streams,
+				(NULL != indices) ? indices + i : NULL,
+				first + i,
+				count - i,
+				models,
+				normalMatrices);
+		}
+	}
+
+	// load the stream values of 8 transforms
+	TARGET_AVX2 inline __m256 LoadStream8(const float* stream, const int* indices, int first, int i)
+	{
+		if (NULL == indices)
+		{
+			return(_mm256_loadu_ps(stream + first + i));
+		}
+		return(_mm256_i32gather_ps(stream, _mm256_loadu_si256((const __m256i*)(indices + i)), 4));
+	}
+
+	// rotation matrices of 8 unit quaternions, as in
+	// BuildMatricesScalar()
+	TARGET_AVX2 inline void QuaternionToRotation8(__m256 x, __m256 y, __m256 z, __m256 w, __m256 rotation[3][3])
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 x2 = _mm256_add_ps(x, x);
+		const __m256 y2 = _mm256_add_ps(y, y);
+		const __m256 z2 = _mm256_add_ps(z, z);
+		const __m256 xx = _mm256_mul_ps(x, x2);
+		const __m256 yy = _mm256_mul_ps(y, y2);
+		const __m256 zz = _mm256_mul_ps(z, z2);
+		const __m256 xy = _mm256_mul_ps(x, y2);
+		const __m256 xz = _mm256_mul_ps(x, z2);
+		const __m256 yz = _mm256_mul_ps(y, z2);
+		const __m256 wx = _mm256_mul_ps(w, x2);
+		const __m256 wy = _mm256_mul_ps(w, y2);
+		const __m256 wz = _mm256_mul_ps(w, z2);
+
+		rotation[0][0] = _mm256_sub_ps(_mm256_sub_ps(one, yy), zz);
+		rotation[0][1] = _mm256_sub_ps(xy, wz);
+		rotation[0][2] = _mm256_add_ps(xz, wy);
+		rotation[1][0] = _mm256_add_ps(xy, wz);
+		rotation[1][1] = _mm256_sub_ps(_mm256_sub_ps(one, xx), zz);
+		rotation[1][2] = _mm256_sub_ps(yz, wx);
+		rotation[2][0] = _mm256_sub_ps(xz, wy);
+		rotation[2][1] = _mm256_add_ps(yz, wx);
+		rotation[2][2] = _mm256_sub_ps(_mm256_sub_ps(one, xx), yy);
+	}
+
+	// write one row of 8 matrices. The transpose works within
+	// each 128 bit half, so the low halves hold the rows of the
+	// first 4 matrices and the high halves the last 4.
+	TARGET_AVX2 inline void StoreRow8(__m256 element[4], const int* indices, int first, int i, int row, PACKED_MATRIX_3X4* matrices)
+	{
+		const __m256 t0 = _mm256_unpacklo_ps(element[0], element[1]);
+		const __m256 t1 = _mm256_unpacklo_ps(element[2], element[3]);
+		const __m256 t2 = _mm256_unpackhi_ps(element[0], element[1]);
+		const __m256 t3 = _mm256_unpackhi_ps(element[2], element[3]);
+		__m256 rows[4];
+
+		rows[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+		rows[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+		rows[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		rows[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		for (int lane = 0; lane < 4; lane++)
+		{
+			const int low = (NULL != indices) ? indices[i + lane] : first + i + lane;
+			const int high = (NULL != indices) ? indices[i + lane + 4] : first + i + lane + 4;
+
+			_mm_storeu_ps(matrices[low].rows[row], _mm256_castps256_ps128(rows[lane]));
+			_mm_storeu_ps(matrices[high].rows[row], _mm256_extractf128_ps(rows[lane], 1));
+		}
+	}
+
+	TARGET_AVX2 void BuildTransformMatricesAvx2(const TRANSFORM_STREAMS& streams, const int* indices, int first, int count, PACKED_MATRIX_3X4* models, PACKED_MATRIX_3X4* normalMatrices)
+	{
+		int i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 scale[3];
+			__m256 inverseScale[3];
+			__m256 position[3];
+			__m256 rotation[3][3];
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				scale[axis] = LoadStream8(streams.values[TRANSFORM_STREAM_SCALE_X + axis], indices, first, i);
+				inverseScale[axis] = _mm256_div_ps(_mm256_set1_ps(1.0f), scale[axis]);
+				position[axis] = LoadStream8(streams.values[TRANSFORM_STREAM_POSITION_X + axis], indices, first, i);
+			}
+			QuaternionToRotation8(
+				LoadStream8(streams.values[TRANSFORM_STREAM_ROTATION_X], indices, first, i),
+				LoadStream8(streams.values[TRANSFORM_STREAM_ROTATION_Y], indices, first, i),
+				LoadStream8(streams.values[TRANSFORM_STREAM_ROTATION_Z], indices, first, i),
+				LoadStream8(streams.values[TRANSFORM_STREAM_ROTATION_W], indices, first, i),
+				rotation);
+
+			for (int row = 0; row < 3; row++)
+			{
+				__m256 modelRow[4];
+				__m256 normalRow[4];
+
+				for (int column = 0; column < 3; column++)
+				{
+					modelRow[column] = _mm256_mul_ps(rotation[row][column], scale[column]);
+					normalRow[column] = _mm256_mul_ps(rotation[row][column], inverseScale[column]);
+				}
+				modelRow[3] = position[row];
+				normalRow[3] = _mm256_setzero_ps();
+				StoreRow8(modelRow, indices, first, i, row, models);
+				StoreRow8(normalRow, indices, first, i, row, normalMatrices);
+			}
+		}
+
+		// the transforms left over go through the 4 wide kernel,
+		// AVX2 processors all have SSE
+		if (i < count)
+		{
+			BuildTransformMatricesSse(
+				streams,
+				(NULL != indices) ? indices + i : NULL,
+				first + i,
+				count - i,
+				models,
+				normalMatrices);
+		}
+	}
+#endif
+}
+
+/***********************************************************
+ *  IsTransformKernelSupported()
+ *
+ *  This function is used for checking whether a kernel can
+ *  run on this processor. The processor is only asked once.
+ ***********************************************************/
+bool IsTransformKernelSupported(TRANSFORM_KERNEL kernel)
+{
+#ifdef TRANSFORM_KERNELS_X86
+	static const bool bSse = DetectSse();
+	static const bool bAvx2 = bSse && DetectAvx2();
+
+	switch (kernel)
+	{
+	case TRANSFORM_KERNEL_SCALAR:
+		return(true);
+	case TRANSFORM_KERNEL_SSE:
+		return(bSse);
+	case TRANSFORM_KERNEL_AVX2:
+		return(bAvx2);
+	default:
+		return(false);
+	}
+#else
+	return(kernel == TRANSFORM_KERNEL_SCALAR);
+#endif
+}
+
+/***********************************************************
+ *  GetBestTransformKernel()
+ *
+ *  This function is used for getting the widest kernel the
+ *  processor can run.
+ ***********************************************************/
+TRANSFORM_KERNEL GetBestTransformKernel()
+{
+	if (IsTransformKernelSupported(TRANSFORM_KERNEL_AVX2) == true)
+	{
+		return(TRANSFORM_KERNEL_AVX2);
+	}
+	if (IsTransformKernelSupported(TRANSFORM_KERNEL_SSE) == true)
+	{
+		return(TRANSFORM_KERNEL_SSE);
+	}
+	return(TRANSFORM_KERNEL_SCALAR);
+}
+
+/***********************************************************
+ *  GetTransformKernelName()
+ *
+ *  This function is used for getting the name of a kernel.
+ ***********************************************************/
+const char* GetTransformKernelName(TRANSFORM_KERNEL kernel)
+{
+	if ((kernel < 0) || (kernel >= TRANSFORM_KERNEL_COUNT))
+	{
+		return("unknown");
+	}
+	return(KERNEL_NAMES[kernel]);
+}
+
+/***********************************************************
+ *  BuildTransformMatrices()
+ *
+ *  This function is used for building the model and normal
+ *  matrices of a list of transforms with a kernel. A kernel
+ *  the processor cannot run falls back to the scalar one.
+ ***********************************************************/
+void BuildTransformMatrices(
+	TRANSFORM_KERNEL kernel,
+	const TRANSFORM_STREAMS& streams,
+	const int* indices,
+	int first,
+	int count,
+	PACKED_MATRIX_3X4* models,
+	PACKED_MATRIX_3X4* normalMatrices)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+#ifdef TRANSFORM_KERNELS_X86
+	if (IsTransformKernelSupported(kernel) == true)
+	{
+		if (kernel == TRANSFORM_KERNEL_AVX2)
+		{
+			BuildTransformMatricesAvx2(streams, indices, first, count, models, normalMatrices);
+			return;
+		}
+		if (kernel == TRANSFORM_KERNEL_SSE)
+		{
+			BuildTransformMatricesSse(streams, indices, first, count, models, normalMatrices);
+			return;
+		}
+	}
+#endif
+	BuildTransformMatricesScalar(streams, indices, first, count, models, normalMatrices);
+}
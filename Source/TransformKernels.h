@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformkernels.h
+// ============
+// build model matrices and normal matrices for many transforms at once,
+// with SSE or AVX2 when the processor supports them
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// transform values read by the kernels, each stream holds one
+// float per transform
+enum TRANSFORM_STREAM
+{
+	TRANSFORM_STREAM_SCALE_X,
+	TRANSFORM_STREAM_SCALE_Y,
+	TRANSFORM_STREAM_SCALE_Z,
+	// rotation as a unit quaternion
+	TRANSFORM_STREAM_ROTATION_X,
+	TRANSFORM_STREAM_ROTATION_Y,
+	TRANSFORM_STREAM_ROTATION_Z,
+	TRANSFORM_STREAM_ROTATION_W,
+	TRANSFORM_STREAM_POSITION_X,
+	TRANSFORM_STREAM_POSITION_Y,
+	TRANSFORM_STREAM_POSITION_Z,
+	TRANSFORM_STREAM_COUNT
+};
+
+// pointers to the start of each transform stream
+struct TRANSFORM_STREAMS
+{
+	const float* values[TRANSFORM_STREAM_COUNT];
+};
+
+// the top three rows of a matrix whose last row is 0, 0, 0, 1
+struct PACKED_MATRIX_3X4
+{
+	float rows[3][4];
+};
+
+// instruction sets the kernels are written for
+enum TRANSFORM_KERNEL
+{
+	TRANSFORM_KERNEL_SCALAR,
+	TRANSFORM_KERNEL_SSE,
+	TRANSFORM_KERNEL_AVX2,
+	TRANSFORM_KERNEL_COUNT
+};
+
+// true when the processor and the build can run a kernel
+bool IsTransformKernelSupported(TRANSFORM_KERNEL kernel);
+// the fastest kernel the processor can run
+TRANSFORM_KERNEL GetBestTransformKernel();
+// name of a kernel for the output
+const char* GetTransformKernelName(TRANSFORM_KERNEL kernel);
+
+// build the model matrices, translation * rotation * scale, and the
+// inverse transpose normal matrices of count transforms. Transform i
+// is read from index indices[i] of the streams, or first + i when
+// indices is NULL, and its matrices are written to the same index of
+// models and normalMatrices. The rotations must be unit quaternions
+// and the scales must not be zero.
+void BuildTransformMatrices(
+	TRANSFORM_KERNEL kernel,
+	const TRANSFORM_STREAMS& streams,
+	const int* indices,
+	int first,
+	int count,
+	PACKED_MATRIX_3X4* models,
+	PACKED_MATRIX_3X4* normalMatrices);
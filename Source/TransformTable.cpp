@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformtable.cpp
+// ============
+// keep the position, rotation and scale of the scene objects and build
+// their model matrices only when they change
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformTable.h"
+
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// fewest changed transforms given to one worker thread
+	const int TRANSFORM_CHUNK_SIZE = 128;
+
+	// the rotation stored by the table, quaternions that are
+	// not unit length are normalized once here instead of in
+	// every matrix build
+	glm::quat NormalizeRotation(const glm::quat& rotation)
+	{
+		const float lengthSquared =
+			rotation.x * rotation.x + rotation.y * rotation.y +
+			rotation.z * rotation.z + rotation.w * rotation.w;
+		float inverseLength = 0.0f;
+
+		if (lengthSquared <= 0.0f)
+		{
+			return(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		}
+		inverseLength = 1.0f / std::sqrt(lengthSquared);
+
+		return(glm::quat(
+			rotation.w * inverseLength,
+			rotation.x * inverseLength,
+			rotation.y * inverseLength,
+			rotation.z * inverseLength));
+	}
+
+	// expand a packed matrix to a full one
+	glm::mat4 UnpackMatrix(const PACKED_MATRIX_3X4& packed)
+	{
+		glm::mat4 matrix(1.0f);
+
+		for (int column = 0; column < 4; column++)
+		{
+			matrix[column] = glm::vec4(
+				packed.rows[0][column],
+				packed.rows[1][column],
+				packed.rows[2][column],
+				(column == 3) ? 1.0f : 0.0f);
+		}
+
+		return(matrix);
+	}
+}
+
+/***********************************************************
+ *  TransformTable()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformTable::TransformTable(WorkerPool* pWorkerPool)
+{
+	m_pWorkerPool = pWorkerPool;
+	m_kernel = GetBestTransformKernel();
+}
+
+/***********************************************************
+ *  ComputeModel()
+ *
+ *  This method is used for building a model matrix from
+ *  transform values, with the scalar kernel the table uses
+ *  on processors without SIMD support.
+ ***********************************************************/
+glm::mat4 TransformTable::ComputeModel(const TRANSFORM_VALUES& values)
+{
+	const glm::quat rotation = NormalizeRotation(values.rotation);
+	const float components[TRANSFORM_STREAM_COUNT] = {
+		values.scale.x, values.scale.y, values.scale.z,
+		rotation.x, rotation.y, rotation.z, rotation.w,
+		values.position.x, values.position.y, values.position.z };
+	TRANSFORM_STREAMS streams;
+	PACKED_MATRIX_3X4 model;
+	PACKED_MATRIX_3X4 normalMatrix;
+
+	for (int i = 0; i < TRANSFORM_STREAM_COUNT; i++)
+	{
+		streams.values[i] = &components[i];
+	}
+	BuildTransformMatrices(TRANSFORM_KERNEL_SCALAR, streams, NULL, 0, 1, &model, &normalMatrix);
+
+	return(UnpackMatrix(model));
+}
+
+/***********************************************************
+ *  EulerToQuaternion()
+ *
+ *  This method is used for converting rotations about the
+ *  X, Y and Z axes into one quaternion, so the scene can be
+ *  defined with angles while the matrices are built from
+ *  quaternions. The product of the three half angle
+ *  quaternions is multiplied out by hand.
+ ***********************************************************/
+glm::quat TransformTable::EulerToQuaternion(const glm::vec3& rotationDegrees)
+{
+	const float halfRadiansPerDegree = 3.14159265358979f / 360.0f;
+	const float cx = std::cos(rotationDegrees.x * halfRadiansPerDegree);
+	const float sx = std::sin(rotationDegrees.x * halfRadiansPerDegree);
+	const float cy = std::cos(rotationDegrees.y * halfRadiansPerDegree);
+	const float sy = std::sin(rotationDegrees.y * halfRadiansPerDegree);
+	const float cz = std::cos(rotationDegrees.z * halfRadiansPerDegree);
+	const float sz = std::sin(rotationDegrees.z * halfRadiansPerDegree);
+
+	return(glm::quat(
+		cx * cy * cz - sx * sy * sz,
+		sx * cy * cz + cx * sy * sz,
+		cx * sy * cz - sx * cy * sz,
+		cx * cy * sz + sx * sy * cz));
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every transform.
+ ***********************************************************/
+void TransformTable::Clear()
+{
+	for (int i = 0; i < TRANSFORM_STREAM_COUNT; i++)
+	{
+		m_streams[i].clear();
+	}
+	m_models.clear();
+	m_normalMatrices.clear();
+	m_changedFlags.clear();
+	m_changedTransforms.clear();
+	m_updatedTransforms.clear();
+}
+
+/***********************************************************
+ *  AddTransform()
+ *
+ *  This method is used for adding a transform. Its model
+ *  matrix is built by the next UpdateMatrices().
+ ***********************************************************/
+int TransformTable::AddTransform(const TRANSFORM_VALUES& values)
+{
+	const int index = (int)m_models.size();
+	const PACKED_MATRIX_3X4 identity = { { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+	const glm::quat rotation = NormalizeRotation(values.rotation);
+
+	m_streams[TRANSFORM_STREAM_SCALE_X].push_back(values.scale.x);
+	m_streams[TRANSFORM_STREAM_SCALE_Y].push_back(values.scale.y);
+	m_streams[TRANSFORM_STREAM_SCALE_Z].push_back(values.scale.z);
+	m_streams[TRANSFORM_STREAM_ROTATION_X].push_back(rotation.x);
+	m_streams[TRANSFORM_STREAM_ROTATION_Y].push_back(rotation.y);
+	m_streams[TRANSFORM_STREAM_ROTATION_Z].push_back(rotation.z);
+	m_streams[TRANSFORM_STREAM_ROTATION_W].push_back(rotation.w);
+	m_streams[TRANSFORM_STREAM_POSITION_X].push_back(values.position.x);
+	m_streams[TRANSFORM_STREAM_POSITION_Y].push_back(values.position.y);
+	m_streams[TRANSFORM_STREAM_POSITION_Z].push_back(values.position.z);
+	m_models.push_back(identity);
+	m_normalMatrices.push_back(identity);
+	m_changedFlags.push_back(0);
+	MarkChanged(index);
+
+	return(index);
+}
+
+/***********************************************************
+ *  GetCount()
+ *
+ *  This method is used for getting the number of transforms.
+ ***********************************************************/
+int TransformTable::GetCount() const
+{
+	return((int)m_models.size());
+}
+
+/***********************************************************
+ *  SetPosition()
+ *
+ *  This method is used for moving a transform.
+ ***********************************************************/
+void TransformTable::SetPosition(int index, const glm::vec3& position)
+{
+	if ((index < 0) || (index >= (int)m_models.size()))
+	{
+		return;
+	}
+
+	m_streams[TRANSFORM_STREAM_POSITION_X][index] = position.x;
+	m_streams[TRANSFORM_STREAM_POSITION_Y][index] = position.y;
+	m_streams[TRANSFORM_STREAM_POSITION_Z][index] = position.z;
+	MarkChanged(index);
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for turning a transform.
+ ***********************************************************/
+void TransformTable::SetRotation(int index, const glm::quat& rotation)
+{
+	const glm::quat unitRotation = NormalizeRotation(rotation);
+
+	if ((index < 0) || (index >= (int)m_models.size()))
+	{
+		return;
+	}
+
+	m_streams[TRANSFORM_STREAM_ROTATION_X][index] = unitRotation.x;
+	m_streams[TRANSFORM_STREAM_ROTATION_Y][index] = unitRotation.y;
+	m_streams[TRANSFORM_STREAM_ROTATION_Z][index] = unitRotation.z;
+	m_streams[TRANSFORM_STREAM_ROTATION_W][index] = unitRotation.w;
+	MarkChanged(index);
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for turning a transform, with the
+ *  rotation about each axis in degrees.
+ ***********************************************************/
+void TransformTable::SetRotation(int index, const glm::vec3& rotationDegrees)
+{
+	SetRotation(index, EulerToQuaternion(rotationDegrees));
+}
+
+/***********************************************************
+ *  SetScale()
+ *
+ *  This method is used for scaling a transform.
+ ***********************************************************/
+void TransformTable::SetScale(int index, const glm::vec3& scale)
+{
+	if ((index < 0) || (index >= (int)m_models.size()))
+	{
+		return;
+	}
+
+	m_streams[TRANSFORM_STREAM_SCALE_X][index] = scale.x;
+	m_streams[TRANSFORM_STREAM_SCALE_Y][index] = scale.y;
+	m_streams[TRANSFORM_STREAM_SCALE_Z][index] = scale.z;
+	MarkChanged(index);
+}
+
+/***********************************************************
+ *  GetValues()
+ *
+ *  This method is used for getting the position, rotation
+ *  and scale of a transform.
+ ***********************************************************/
+TRANSFORM_VALUES TransformTable::GetValues(int index) const
+{
+	TRANSFORM_VALUES values;
+
+	values.scale = glm::vec3(
+		m_streams[TRANSFORM_STREAM_SCALE_X][index],
+		m_streams[TRANSFORM_STREAM_SCALE_Y][index],
+		m_streams[TRANSFORM_STREAM_SCALE_Z][index]);
+	values.rotation = glm::quat(
+		m_streams[TRANSFORM_STREAM_ROTATION_W][index],
+		m_streams[TRANSFORM_STREAM_ROTATION_X][index],
+		m_streams[TRANSFORM_STREAM_ROTATION_Y][index],
+		m_streams[TRANSFORM_STREAM_ROTATION_Z][index]);
+	values.position = glm::vec3(
+		m_streams[TRANSFORM_STREAM_POSITION_X][index],
+		m_streams[TRANSFORM_STREAM_POSITION_Y][index],
+		m_streams[TRANSFORM_STREAM_POSITION_Z][index]);
+
+	return(values);
+}
+
+/***********************************************************
+ *  UpdateMatrices()
+ *
+ *  This method is used for building the model and normal
+ *  matrices of the transforms changed since the last
+ *  update. Each matrix only reads and writes its own array
+ *  entries, so the changed list is split across the worker
+ *  threads. When every transform changed, as after the
+ *  scene is built, the kernel reads the streams in order
+ *  instead of through the changed list.
+ ***********************************************************/
+int TransformTable::UpdateMatrices()
+{
+	const int changedCount = (int)m_changedTransforms.size();
+	const bool bAllChanged = (changedCount == GetCount());
+	const TRANSFORM_STREAMS streams = GetStreams();
+
+	m_updatedTransforms.clear();
+	if (changedCount == 0)
+	{
+		return(0);
+	}
+
+	m_pWorkerPool->ParallelFor(changedCount, TRANSFORM_CHUNK_SIZE, [this, bAllChanged, &streams](int begin, int end)
+	{
+		BuildTransformMatrices(
+			m_kernel,
+			streams,
+			(bAllChanged == true) ? NULL : &m_changedTransforms[begin],
+			begin,
+			end - begin,
+			m_models.data(),
+			m_normalMatrices.data());
+	});
+
+	for (int i = 0; i < changedCount; i++)
+	{
+		m_changedFlags[m_changedTransforms[i]] = 0;
+	}
+	m_updatedTransforms.swap(m_changedTransforms);
+	m_changedTransforms.clear();
+
+	return(changedCount);
+}
+
+/***********************************************************
+ *  GetUpdatedTransforms()
+ *
+ *  This method is used for getting the transforms whose
+ *  matrices were built by the last UpdateMatrices().
+ ***********************************************************/
+const std::vector<int>& TransformTable::GetUpdatedTransforms() const
+{
+	return(m_updatedTransforms);
+}
+
+/***********************************************************
+ *  GetModel()
+ *
+ *  This method is used for getting the model matrix of a
+ *  transform, as of the last UpdateMatrices().
+ ***********************************************************/
+glm::mat4 TransformTable::GetModel(int index) const
+{
+	return(UnpackMatrix(m_models[index]));
+}
+
+/***********************************************************
+ *  GetNormalMatrix()
+ *
+ *  This method is used for getting the matrix that moves
+ *  the normals of a transform, as of the last
+ *  UpdateMatrices().
+ ***********************************************************/
+glm::mat3 TransformTable::GetNormalMatrix(int index) const
+{
+	return(glm::mat3(UnpackMatrix(m_normalMatrices[index])));
+}
+
+/***********************************************************
+ *  GetKernel()
+ *
+ *  This method is used for getting the kernel that builds
+ *  the matrices on this processor.
+ ***********************************************************/
+TRANSFORM_KERNEL TransformTable::GetKernel() const
+{
+	return(m_kernel);
+}
+
+/***********************************************************
+ *  MarkChanged()
+ *
+ *  This method is used for adding a transform to the list
+ *  built by the next update, once.
+ ***********************************************************/
+void TransformTable::MarkChanged(int index)
+{
+	if (m_changedFlags[index] == 0)
+	{
+		m_changedFlags[index] = 1;
+		m_changedTransforms.push_back(index);
+	}
+}
+
+/***********************************************************
+ *  GetStreams()
+ *
+ *  This method is used for getting the start of each value
+ *  stream for the kernels.
+ ***********************************************************/
+TRANSFORM_STREAMS TransformTable::GetStreams() const
+{
+	TRANSFORM_STREAMS streams;
+
+	for (int i = 0; i < TRANSFORM_STREAM_COUNT; i++)
+	{
+		streams.values[i] = m_streams[i].data();
+	}
+
+	return(streams);
+}
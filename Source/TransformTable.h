@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformtable.h
+// ============
+// keep the position, rotation and scale of the scene objects and build
+// their model matrices only when they change
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TransformKernels.h"
+#include "WorkerPool.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// position, rotation and scale of one transform
+struct TRANSFORM_VALUES
+{
+	glm::vec3 scale;
+	glm::quat rotation;
+	glm::vec3 position;
+};
+
+/***********************************************************
+ *  TransformTable
+ *
+ *  This class stores the transform values of every object
+ *  in one float array per component, next to the model
+ *  and normal matrices built from them. Changing a value
+ *  only marks the transform, and UpdateMatrices() builds
+ *  the matrices of the marked transforms together with the
+ *  widest SIMD kernel the processor runs, split across the
+ *  worker threads when there are enough of them. Reading a
+ *  matrix is then just an array lookup.
+ ***********************************************************/
+class TransformTable
+{
+public:
+	// constructor
+	TransformTable(WorkerPool* pWorkerPool);
+
+	// build a model matrix as translation * rotation * scale
+	static glm::mat4 ComputeModel(const TRANSFORM_VALUES& values);
+	// the quaternion of rotation X * rotation Y * rotation Z,
+	// with the rotation about each axis in degrees
+	static glm::quat EulerToQuaternion(const glm::vec3& rotationDegrees);
+
+	// remove every transform
+	void Clear();
+	// add a transform, returns its index
+	int AddTransform(const TRANSFORM_VALUES& values);
+	// number of transforms
+	int GetCount() const;
+
+	// change the values of a transform
+	void SetPosition(int index, const glm::vec3& position);
+	void SetRotation(int index, const glm::quat& rotation);
+	void SetRotation(int index, const glm::vec3& rotationDegrees);
+	void SetScale(int index, const glm::vec3& scale);
+	// get the values of a transform
+	TRANSFORM_VALUES GetValues(int index) const;
+
+	// build the matrices of the changed transforms, returns
+	// the number built
+	int UpdateMatrices();
+	// transforms built by the last UpdateMatrices()
+	const std::vector<int>& GetUpdatedTransforms() const;
+	// get the model matrix of a transform
+	glm::mat4 GetModel(int index) const;
+	// get the inverse transpose of the model matrix, for
+	// transforming normals
+	glm::mat3 GetNormalMatrix(int index) const;
+	// kernel that builds the matrices
+	TRANSFORM_KERNEL GetKernel() const;
+
+private:
+	// mark a transform to be built by the next update
+	void MarkChanged(int index);
+	// pointers to the start of the value streams
+	TRANSFORM_STREAMS GetStreams() const;
+
+	// pointer to the threads that build the matrices
+	WorkerPool* m_pWorkerPool;
+	// kernel picked for this processor
+	TRANSFORM_KERNEL m_kernel;
+	// transform values, one stream per component, and the
+	// matrices built from them, by index
+	std::vector<float> m_streams[TRANSFORM_STREAM_COUNT];
+	std::vector<PACKED_MATRIX_3X4> m_models;
+	std::vector<PACKED_MATRIX_3X4> m_normalMatrices;
+	// 1 for the transforms waiting in the changed list
+	std::vector<uint8_t> m_changedFlags;
+	std::vector<int> m_changedTransforms;
+	std::vector<int> m_updatedTransforms;
+};
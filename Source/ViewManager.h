@@ -1,48 +1,82 @@
-///////////////////////////////////////////////////////////////////////////////
-// viewmanager.h
-// ============
-// manage the viewing of 3D objects within the viewport
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "camera.h"
-
-// GLFW library
-#include "GLFW/glfw3.h" 
-
-class ViewManager
-{
-public:
-	// constructor
-	ViewManager(
-		ShaderManager* pShaderManager);
-	// destructor
-	~ViewManager();
-
-	// mouse position callback for mouse interaction with the 3D scene
-	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
-
-	// Mouse scroll position callback for scroll wheel interaction
-	static void Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xoffset, double yoffset);
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// active OpenGL display window
-	GLFWwindow* m_pWindow;
-
-	// process keyboard events for interaction with the 3D scene
-	void ProcessKeyboardEvents();
-
-public:
-	// create the initial OpenGL display window
-	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
-	
-	// prepare the conversion from 3D object display to 2D scene display
-	void PrepareSceneView();
+///////////////////////////////////////////////////////////////////////////////
+// viewmanager.h
+// ============
+// manage the viewing of 3D objects within the viewport
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "camera.h"
+
+// GLFW library
+#include "GLFW/glfw3.h" 
+
+// render options that are switched on and off from the keyboard
+enum VIEW_TOGGLE
+{
+	TOGGLE_CLUSTERED_LIGHTING,
+	TOGGLE_INDIRECT_DRAWS,
+	TOGGLE_GPU_CULLING,
+	TOGGLE_OCCLUSION_CULLING,
+	TOGGLE_COUNT
+};
+
+class ViewManager
+{
+public:
+	// constructor
+	ViewManager(
+		ShaderManager* pShaderManager,
+		ShaderUniforms* pShaderUniforms);
+	// destructor
+	~ViewManager();
+
+	// mouse position callback for mouse interaction with the 3D scene
+	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
+
+	// Mouse scroll position callback for scroll wheel interaction
+	static void Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xoffset, double yoffset);
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to resolved shader uniform handles
+	ShaderUniforms* m_pShaderUniforms;
+	// active OpenGL display window
+	GLFWwindow* m_pWindow;
+	// camera matrices of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// current state of the render option toggles
+	bool m_toggles[TOGGLE_COUNT];
+	// toggle keys held down during the last frame
+	bool m_toggleKeysDown[TOGGLE_COUNT];
+	// render options that the renderer is able to switch on
+	bool m_toggleAvailable[TOGGLE_COUNT];
+
+	// process keyboard events for interaction with the 3D scene
+	void ProcessKeyboardEvents();
+
+public:
+	// create the initial OpenGL display window
+	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
+	
+	// prepare the conversion from 3D object display to 2D scene display
+	void PrepareSceneView();
+
+	// get the camera matrices set by PrepareSceneView()
+	const glm::mat4& GetViewMatrix() const;
+	const glm::mat4& GetProjectionMatrix() const;
+	// get the size of the display window viewport in pixels
+	glm::vec2 GetViewportSize() const;
+
+	// get the state of a render option toggle
+	bool GetToggle(VIEW_TOGGLE toggle) const;
+	// set whether a render option toggle can be switched on
+	void SetToggleAvailable(VIEW_TOGGLE toggle, bool bAvailable);
 };
\ No newline at end of file
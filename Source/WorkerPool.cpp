@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+// workerpool.cpp
+// ============
+// run the per-frame scene work across a fixed set of worker threads
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  WorkerPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+WorkerPool::WorkerPool(int threadCount)
+{
+	m_jobGeneration = 0;
+	m_busyWorkers = 0;
+	m_bShutdown = false;
+	m_pJobFunction = NULL;
+	m_jobCount = 0;
+	m_chunkSize = 1;
+	m_nextIndex = 0;
+
+	// the calling thread also runs chunks, so one core is
+	// left for it when the count is picked automatically
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+	threadCount = std::max(threadCount, 0);
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_threads.push_back(std::thread(&WorkerPool::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~WorkerPool()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_bShutdown = true;
+	}
+	m_wakeCondition.notify_all();
+
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		m_threads[i].join();
+	}
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of threads
+ *  that run the chunks of a job, including the caller.
+ ***********************************************************/
+int WorkerPool::GetThreadCount() const
+{
+	return((int)m_threads.size() + 1);
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running a job over the index
+ *  range [0, count). The range is split into chunks of
+ *  chunkSize indexes that are processed by the workers and
+ *  the calling thread. It returns once all chunks are done.
+ *  Small ranges are run directly on the calling thread.
+ ***********************************************************/
+void WorkerPool::ParallelFor(
+	int count,
+	int chunkSize,
+	const std::function<void(int, int)>& jobFunction)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+	chunkSize = std::max(chunkSize, 1);
+	if ((m_threads.empty() == true) || (count <= chunkSize))
+	{
+		jobFunction(0, count);
+		return;
+	}
+
+	std::lock_guard<std::mutex> jobLock(m_jobMutex);
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_pJobFunction = &jobFunction;
+		m_jobCount = count;
+		m_chunkSize = chunkSize;
+		m_nextIndex = 0;
+		m_busyWorkers = (int)m_threads.size();
+		m_jobGeneration++;
+	}
+	m_wakeCondition.notify_all();
+
+	RunChunks();
+
+	// the job function must stay alive until every worker
+	// has stopped taking chunks
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	m_doneCondition.wait(lock, [this]() { return(m_busyWorkers == 0); });
+	m_pJobFunction = NULL;
+}
+
+/***********************************************************
+ *  RunChunks()
+ *
+ *  This method is used for taking chunks of the current job
+ *  until the whole index range has been handed out.
+ ***********************************************************/
+void WorkerPool::RunChunks()
+{
+	int begin = m_nextIndex.fetch_add(m_chunkSize);
+
+	while (begin < m_jobCount)
+	{
+		(*m_pJobFunction)(begin, std::min(begin + m_chunkSize, m_jobCount));
+		begin = m_nextIndex.fetch_add(m_chunkSize);
+	}
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is run by each worker thread. It sleeps until
+ *  a new job is started, helps to run it, and then reports
+ *  that it is done.
+ ***********************************************************/
+void WorkerPool::WorkerLoop()
+{
+	uint64_t lastGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_wakeCondition.wait(lock, [this, lastGeneration]()
+				{ return((m_bShutdown == true) || (m_jobGeneration != lastGeneration)); });
+			if (m_bShutdown == true)
+			{
+				return;
+			}
+			lastGeneration = m_jobGeneration;
+		}
+
+		RunChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_busyWorkers--;
+		}
+		m_doneCondition.notify_one();
+	}
+}
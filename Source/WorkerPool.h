@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// workerpool.h
+// ============
+// run the per-frame scene work across a fixed set of worker threads
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  WorkerPool
+ *
+ *  This class keeps a set of worker threads alive for the
+ *  whole run, so the per-frame jobs do not pay for thread
+ *  creation. ParallelFor() splits an index range into
+ *  chunks that the workers and the calling thread take in
+ *  turn, and returns once every chunk has been processed.
+ ***********************************************************/
+class WorkerPool
+{
+public:
+	// constructor, zero threads uses one per spare core
+	WorkerPool(int threadCount = 0);
+	// destructor
+	~WorkerPool();
+
+	// number of threads that run a job, including the caller
+	int GetThreadCount() const;
+
+	// call jobFunction(begin, end) for chunks of at least
+	// chunkSize indexes until [0, count) has been covered
+	void ParallelFor(
+		int count,
+		int chunkSize,
+		const std::function<void(int, int)>& jobFunction);
+
+private:
+	// take chunks of the current job until none are left
+	void RunChunks();
+	// wait for jobs and run them until the pool is destroyed
+	void WorkerLoop();
+
+	std::vector<std::thread> m_threads;
+	// only one job runs at a time
+	std::mutex m_jobMutex;
+
+	// signals the workers that a new job is ready
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::condition_variable m_doneCondition;
+	uint64_t m_jobGeneration;
+	int m_busyWorkers;
+	bool m_bShutdown;
+
+	// the job being run
+	const std::function<void(int, int)>* m_pJobFunction;
+	int m_jobCount;
+	int m_chunkSize;
+	std::atomic<int> m_nextIndex;
+};